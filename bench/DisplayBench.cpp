@@ -0,0 +1,407 @@
+/*--------------------------- DISPLAY BENCHMARK (NATIVE BUILD) -----------------------------*/
+/*
+ * The display states, with the Parola calls loop() makes for each, drawn on an emulated chain
+ * of 8 FC16 modules rather than the real one (refer to shim/MAX7219Emulator.h). MD_Parola and
+ * MD_MAX72XX are the real libraries. Only the SPI under them is emulated. Crypto, Countdown
+ * and the messages are drawn by the firmware's own steps (DisplaySteps.hpp), the lists by
+ * FeedRender.hpp and the marquee, and the greetings by CustomParola.hpp.
+ *
+ *    pio run -e native_display -t exec
+ *    .pio/build/native_display/program [--ascii] [--frames] [--pgm <dir>] [--update-hashes]
+ *
+ * For each state it reports the frames drawn, frames per second of display time, how many of
+ * the 64 columns changed per frame, the SPI bytes that would have gone to the display, and
+ * the host time per frame. It runs on the shim's manual clock, a millisecond per pass of the
+ * animation loop, so the frame hash is the same every run unless what's drawn changes.
+ *
+ * --ascii prints the last frame of each state, --frames every frame, and --pgm writes each
+ * state's frames to <dir>/<state>.pgm. It exits non-zero if a state never finishes, or its
+ * frames don't hash to what DisplayBenchHashes.h expects. A state that file doesn't list yet
+ * is only warned about. --update-hashes rewrites that file with this run's instead.
+ */
+#include <Arduino.h>
+#include <TimeLib2.hpp>
+#include <MD_MAX72xx.h>
+#include <MD_Parola.h>
+#include <MAX7219Emulator.h>
+#include "DisplayBenchHashes.h"
+
+SerialShim  Serial;
+TimeLib2    clockMain;      // JsonProcessor.hpp expects the main .cpp file to have one
+
+// As main.ino.cpp
+#define   MAX_DEVICES         8
+#define   HARDWARE_TYPE       MD_MAX72XX::FC16_HW
+#define   CS_PIN              15
+#define   NUM_ZONES           2
+#define   ZONE_RIGHT          0
+#define   ZONE_LEFT           1
+#define   MAX_TICKER_LENGTH   256
+
+#define SCROLL_SPEED_MS_DELAY_SLOW      50
+#define SCROLL_SPEED_MS_DELAY_NORMAL    30
+
+#define BENCH_EPOCH             1671321600L     // 2022-12-18 00:00 UTC, fixed so runs compare
+#define BENCH_LOOP_MS           1               // Display time per pass of the animation loop
+#define BENCH_STATE_LIMIT_MS    (10 * 60 * 1000L)
+#define BENCH_HASHES_PATH       "bench/DisplayBenchHashes.h"    // From the project directory, as pio runs it
+
+MD_Parola           Parola = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+MAX7219Emulator     display(CS_PIN, MAX_DEVICES, MAX7219_FC16_HW);
+
+// waitForZoneAnimationComplete() handles these between frames, so that's where display time passes
+struct BenchWebServer
+{
+    void handleClient()     { shimClock.advance(BENCH_LOOP_MS); }
+} webServer;
+
+struct BenchPortal
+{
+    void handleRequest()    { }
+} Portal;
+
+#include "TickerConfigStructs.hpp"
+
+TickerConfig    tickerConfig;
+CustomMessage   customMessage;
+int             parola_display_speed = SCROLL_SPEED_MS_DELAY_NORMAL;
+int             parola_display_pause = 15 * 1000;
+char            parolaBuffer[MAX_TICKER_LENGTH] = {0};
+
+#include "JsonProcessor.hpp"
+#include "FeedRender.hpp"
+#include "CustomParola.hpp"
+#include "Marquee.hpp"
+#include "DisplayEngine.hpp"
+#include "DisplaySteps.hpp"
+
+/*---- ANIMATION ----*/
+bool timed_out = false;
+
+// As loop() does, until the zones (or the marquee) are done. Off the ESP8266, the display
+// engine ticks when service() finds one due.
+void animateUntilDone()
+{
+    unsigned long start = millis();
+
+    while ( displayEngine.service() )
+    {
+        if (millis() - start > BENCH_STATE_LIMIT_MS) {
+            timed_out = true;
+            marquee.stop();
+            return;
+        }
+
+        webServer.handleClient();
+    }
+}
+
+/*---- FEED DATA ----*/
+HeadlineData    news;
+ForecastData    forecast;
+TickerData      crypto;
+TickerData      stocks;
+
+void benchFeeds()
+{
+    const char *headlines[] = {
+        "Central banks hold rates as inflation cools",
+        "Storms ground flights across the north",
+        "Chip makers report record quarter",
+        "Local team wins the cup after extra time",
+        "New bridge opens two years late",
+    };
+    for (const char *headline : headlines) news.push_front(headline, "\x7 ");
+
+    const char *descriptions[] = { "light rain", "scattered clouds", "clear sky" };
+    for (int i = 0; i < 3; i++) {
+        WeatherInstance weather = {};
+        weather.datetime            = BENCH_EPOCH + (i + 1) * 86400L;
+        weather.datetime_tzadjusted = weather.datetime;
+        weather.temp_now            = 11 + i * 3;
+        strcpy(weather.description, descriptions[i]);
+        forecast.items.push_back(weather);
+    }
+
+    crypto.add("Bitcoin",   "BTC",  "USD",  16724.74,   1.52,   250.1);
+    crypto.add("Ethereum",  "ETH",  "EUR",  1185.21,    -0.84,  -10.0);
+    crypto.add("Dogecoin",  "DOGE", "JPY",  12.61,      3.10,   0.38);
+
+    stocks.add("Lake Resources",    "ASX:LKE",  "AUD",  0.795,  -2.45,  -0.02);
+    stocks.add("Apple",             "AAPL",     "USD",  134.51, 0.41,   0.55);
+}
+
+/*---- DISPLAY STATES ----*/
+// displayStringList(), a Parola scroll per line
+template <typename T>
+void showListPerLine(const T &list)
+{
+    for (size_t row = 0; row < feedLineCount(list); row++) {
+        const char *line = feedLine(list, row, parolaBuffer, sizeof(parolaBuffer));
+        Parola.displayZoneText(ZONE_LEFT, line, PA_RIGHT, parola_display_speed, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+        animateUntilDone();
+    }
+}
+
+// displayStringList() with marquee_mode
+template <typename T>
+void showListMarquee(const T &list)
+{
+    static const T  *current;
+    static size_t   row;
+
+    current = &list;
+    row     = 0;
+
+    marquee.start([](char *buffer, size_t size) -> const char* {
+        return (row < feedLineCount(*current)) ? feedLine(*current, row++, buffer, size) : nullptr;
+    }, parola_display_speed);
+}
+
+void showBranding()         { showStartBranding(); }
+
+void showGreeting()
+{
+    strcpy(tickerConfig.owner_name, "William");
+    show_starting_greeting();
+}
+
+void showLongGreeting()
+{
+    strcpy(tickerConfig.owner_name, "Maximilian Alexander");
+    show_starting_greeting();
+}
+
+void showTime()
+{
+    strcpy(parolaBuffer, "10:42 AM");
+    Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_CENTER, parola_display_speed, 1000, PA_PRINT, PA_SPRITE);
+    Parola.setSpriteData(pacman1, W_PMAN1, F_PMAN1, pacman1, W_PMAN1, F_PMAN1);
+}
+
+void showDate()
+{
+    strcpy(parolaBuffer, "Sun 18 Dec");
+    Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_CENTER, parola_display_speed, parola_display_pause, PA_PRINT);
+}
+
+void showWeather()
+{
+    strcpy(parolaBuffer, "London \x10 light rain, 9\xB0 (feels 6\xB0), humidity 87%");
+    Parola.displayClear(ZONE_LEFT);
+    Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_RIGHT, parola_display_speed, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+}
+
+void showForecast()         { showListPerLine(forecast); }
+void showForecastMarquee()  { showListMarquee(forecast); }
+void showNews()             { showListPerLine(news); }
+void showNewsMarquee()      { showListMarquee(news); }
+void showStocks()           { showListPerLine(stocks); }
+void showStocksMarquee()    { showListMarquee(stocks); }
+
+// S_CRYPTO, a pass of loop() per step
+void showCrypto()
+{
+    beginTickerRows();
+
+    for (size_t row = 0; row < crypto.size(); row++) {
+        for (int step = 0; showTickerRowStep(crypto, row, step); step++) animateUntilDone();
+    }
+
+    endTickerRows();
+}
+
+// S_COUNTDOWN. clockMain only moves when it's set, so the time comes from the manual clock.
+void showCountdown()
+{
+    unsigned long start_ms = millis();
+
+    strcpy(tickerConfig.countdown_name, "Launch");
+    tickerConfig.countdown_datetime = BENCH_EPOCH + 3725;   // 1h 2m 5s away
+
+    int     step    = 0;
+    time_t  start   = 0;
+
+    while ( showCountdownStep(BENCH_EPOCH + (millis() - start_ms) / 1000, step, start) ) {
+        animateUntilDone();
+    }
+}
+
+// S_MESSAGE
+void showMessage(const char *message)
+{
+    strcpy(customMessage.message, message);
+    showCustomMessage();
+}
+
+void showShortMessage()     { showMessage("Dinner!"); }
+void showLongMessage()      { showMessage("Happy birthday, have a great day"); }
+void showNoWifi()           { printTextOrScrollLeft("No WiFi !", true); }
+
+/*---- MAIN ----*/
+struct BenchState
+{
+    const char      *name;
+    void            (*show)();
+    uint32_t        hash;           // Of this run's frames
+};
+
+/*---- EXPECTED HASHES ----*/
+// What DisplayBenchHashes.h has for state, or nullptr if it isn't there
+const BenchExpectedHash* expectedHash(const char *state)
+{
+    for (const BenchExpectedHash &expected : benchExpectedHashes) {
+        if (expected.state && !strcmp(expected.state, state)) return &expected;
+    }
+    return nullptr;
+}
+
+// Rewrite the table in DisplayBenchHashes.h with this run's hashes, keeping the rest of the file
+bool writeExpectedHashes(const BenchState *states, size_t count)
+{
+    std::string kept;
+    char        line[256];
+
+    FILE *in = fopen(BENCH_HASHES_PATH, "r");
+    if (!in) return false;
+
+    while ( fgets(line, sizeof(line), in) ) {
+        kept += line;
+        if ( strstr(line, "benchExpectedHashes[] = {") ) break;
+    }
+    fclose(in);
+
+    if ( kept.find("benchExpectedHashes[] = {") == std::string::npos ) return false;
+
+    FILE *out = fopen(BENCH_HASHES_PATH, "w");
+    if (!out) return false;
+
+    fputs(kept.c_str(), out);
+    for (size_t i = 0; i < count; i++) {
+        std::string name = std::string("\"") + states[i].name + "\",";
+        fprintf(out, "    { %-20s 0x%08x },\n", name.c_str(), states[i].hash);
+    }
+    fputs("    { nullptr,              0x00000000 }\n};\n\n#endif\n", out);
+
+    return fclose(out) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    bool        ascii       = false;
+    bool        frames      = false;
+    bool        update      = false;
+    const char  *pgm_dir    = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "--ascii"))               ascii   = true;
+        else if (!strcmp(argv[i], "--frames"))              frames  = true;
+        else if (!strcmp(argv[i], "--update-hashes"))       update  = true;
+        else if (!strcmp(argv[i], "--pgm") && i + 1 < argc) pgm_dir = argv[++i];
+    }
+
+    shimClock.manual = true;
+    clockMain.setTime(BENCH_EPOCH);
+    srand(1);
+    benchFeeds();
+
+    display.attach();
+    Parola.begin(NUM_ZONES);
+    addCurrencyGlyphs();
+    buildGlyphWidths();
+    displayEngine.begin(parola_display_speed);
+    Parola.displayClear();
+    Parola.displaySuspend(false);
+    Parola.setIntensity(8);
+    setDefaultZoneSizes();
+
+    BenchState states[] = {
+        { "Branding",           showBranding        },
+        { "Greeting",           showGreeting        },
+        { "GreetingLong",       showLongGreeting    },
+        { "Time",               showTime            },
+        { "Date",               showDate            },
+        { "Weather",            showWeather         },
+        { "Forecast",           showForecast        },
+        { "ForecastMarquee",    showForecastMarquee },
+        { "News",               showNews            },
+        { "NewsMarquee",        showNewsMarquee     },
+        { "Crypto",             showCrypto          },
+        { "Stock",              showStocks          },
+        { "StockMarquee",       showStocksMarquee   },
+        { "Countdown",          showCountdown       },
+        { "Message",            showShortMessage    },
+        { "MessageLong",        showLongMessage     },
+        { "NoWifi",             showNoWifi          },
+    };
+
+    int failures        = 0;
+    int unlisted_states = 0;
+
+    Serial.println(F("State             Display ms   Frames     fps  Cols/frame   SPI bytes  Bytes/frame  Host us/frame      Hash"));
+
+    for (BenchState &state : states)
+    {
+        display.reset();
+        timed_out = false;
+
+        unsigned long start_ms  = millis();
+        auto          start     = std::chrono::steady_clock::now();
+
+        state.show();
+        animateUntilDone();
+        display.flush();
+
+        double host_us  = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        unsigned long n = display.stats.frames;
+
+        state.hash = display.hash();
+
+        // Unless it's being updated, a state's frames have to be what they were. One that isn't
+        // listed yet is only warned about, until --update-hashes has been run for it.
+        const BenchExpectedHash *expected = expectedHash(state.name);
+        bool                    mismatch  = !update && expected && expected->hash != state.hash;
+        bool                    unlisted  = !update && !expected;
+
+        Serial.printf_P(PSTR("%-16s %11lu %8lu %7.1f %11.1f %11lu %12.1f %14.2f  %08x%s"),
+            state.name, millis() - start_ms, n, display.fps(),
+            n ? (double) display.stats.columns_changed / n : 0.0, display.stats.spi_bytes,
+            n ? (double) display.stats.spi_bytes / n : 0.0, n ? host_us / n : 0.0,
+            state.hash, timed_out ? "  TIMED OUT" : "");
+
+        if (mismatch)       Serial.printf_P(PSTR("  MISMATCH, expected %08x"), expected->hash);
+        else if (unlisted)  Serial.printf_P(PSTR("  warning: not in %s"), BENCH_HASHES_PATH);
+        Serial.println();
+
+        if (ascii && display.frameCount()) display.printAscii(stdout, display.frame(display.frameCount() - 1));
+        if (frames) {
+            for (size_t f = 0; f < display.frameCount(); f++) {
+                Serial.printf_P(PSTR("-- %s frame %zu\n"), state.name, f);
+                display.printAscii(stdout, display.frame(f));
+            }
+        }
+
+        if (pgm_dir && display.frameCount()) {
+            std::string path = std::string(pgm_dir) + "/" + state.name + ".pgm";
+            if (!display.writePGM(path.c_str())) Serial.printf_P(PSTR("Couldn't write %s\n"), path.c_str());
+        }
+
+        failures        += (timed_out || mismatch);
+        unlisted_states += unlisted;
+    }
+
+    display.detach();
+
+    if (update) {
+        if ( writeExpectedHashes(states, sizeof(states) / sizeof(states[0])) ) {
+            Serial.printf_P(PSTR("Wrote %s\n"), BENCH_HASHES_PATH);
+        } else {
+            Serial.printf_P(PSTR("Couldn't write %s\n"), BENCH_HASHES_PATH);
+            failures++;
+        }
+    }
+
+    if (unlisted_states) Serial.printf_P(PSTR("%d states have no expected hash yet, run with --update-hashes\n"), unlisted_states);
+    if (failures) Serial.printf_P(PSTR("%d states FAILED\n"), failures);
+    return failures ? 1 : 0;
+}
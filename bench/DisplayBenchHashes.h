@@ -0,0 +1,25 @@
+#ifndef DISPLAY_BENCH_HASHES_H
+#define DISPLAY_BENCH_HASHES_H
+
+/*--------------------------- DISPLAY BENCH EXPECTED FRAMES -----------------------------*/
+/*
+ * The hash of every frame DisplayBench draws for each state, as of the last change that was
+ * meant to change what's on the display. The bench fails on any other hash, and warns about a
+ * state that isn't listed. Check the frames are right (--frames, --pgm) then, from the project
+ * directory, rewrite this file with:
+ *
+ *    .pio/build/native_display/program --update-hashes
+ */
+#include <stdint.h>
+
+struct BenchExpectedHash
+{
+    const char  *state;
+    uint32_t    hash;
+};
+
+const BenchExpectedHash benchExpectedHashes[] = {
+    { nullptr,              0x00000000 }
+};
+
+#endif
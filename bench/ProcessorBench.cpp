@@ -0,0 +1,363 @@
+/*--------------------------- FEED PROCESSOR BENCHMARK (NATIVE BUILD) -----------------------------*/
+/*
+ * Runs made up IoT proxy responses of 10 to 10,000 data[] items through each JsonProcessor,
+ * three ways: a whole document (deserializeJson() then process_json_document()), and the
+ * JSON and MessagePack item streamers (refer to JsonStreamParser.hpp). For each it reports
+ * items per second, the peak heap above where it started, and allocations per response.
+ * Then the same fixtures as one action=bundle response, through the bundle demultiplexer.
+ *
+ *    pio run -e native -t exec
+ *
+ * It exits non-zero if any response fails to parse, a streamer doesn't see every item, or a
+ * bundle section isn't handed to its processor (or a member nobody asked for is), so it can
+ * gate a build before it goes anywhere near a device. Heap figures are for a 64 bit
+ * host, so are bigger than on the ESP8266. Compare them run to run, not with the device.
+ *
+ * malloc() and friends are wrapped at link time (-Wl,--wrap in platformio.ini, refer to
+ * shim/BenchHeap.h), which catches ArduinoJson's documents as well as everything that goes
+ * through operator new.
+ */
+#include <Arduino.h>
+#include <BenchHeap.h>
+#include <TimeLib2.hpp>
+#include <vector>
+
+SerialShim  Serial;
+TimeLib2    clockMain;      // JsonProcessor.hpp expects the main .cpp file to have one
+
+#include "JsonProcessor.hpp"
+#include "JsonStreamParser.hpp"
+#include "MsgPackStreamParser.hpp"
+
+#define BENCH_EPOCH             1671321600L     // 2022-12-18 00:00 UTC, fixed so runs compare
+#define BENCH_ITEMS_PER_RUN     20000           // Smaller responses are repeated up to about this many items
+#define BENCH_CHUNK_BYTES       64              // As FeedFetch::pump() reads them
+
+/*---- FIXTURES ----*/
+// One data[] element, in the shape the proxy sends (refer to the samples in JsonProcessor.hpp)
+std::string weatherItem(int i)
+{
+    char item[384];
+    snprintf(item, sizeof(item),
+        "{\"dt\":%ld,\"name\":\"London\",\"id\":2643743,\"country\":\"GB\",\"temp\":%d.4,\"humidity\":%d,"
+        "\"summary\":\"Clouds\",\"description\":\"Broken Clouds\",\"cloud_percentage\":74,"
+        "\"icon_day\":\"clouds\",\"icon_night\":\"clouds\",\"dt_txt\":\"\"}",
+        BENCH_EPOCH + 86400L + i * 10800L, i % 30, 40 + i % 60);
+    return item;
+}
+
+std::string newsItem(int i)
+{
+    char item[384];
+    snprintf(item, sizeof(item),
+        "{\"feed_timestamp\":\"2022-12-17 21:36:47\",\"feed_title\":null,\"feed_language\":\"en-gb\",\"feed_code\":\"BT\","
+        "\"datetime\":%ld,\"title\":\"Headline %d: Homes flooded after north London water mains burst\",\"title_length\":62}",
+        BENCH_EPOCH - i * 60L, i);
+    return item;
+}
+
+std::string tickerItem(int i)
+{
+    char item[384];
+    snprintf(item, sizeof(item),
+        "{\"feed_timestamp\":\"2022-12-17 21:47:31\",\"feed_reporting_ccy\":\"%s\",\"name\":\"Coin %d\",\"code\":\"C%d\","
+        "\"price_reporting_ccy\":%d.74,\"percent_change_24h\":%s%d.77,\"price_change_24h\":-129}",
+        (i % 3 == 0) ? "EUR" : ((i % 3 == 1) ? "GBP" : "USD"), i, i, 16000 + i, (i % 2) ? "-" : "", i % 10);
+    return item;
+}
+
+std::string timeItem(int i)
+{
+    char item[128];
+    snprintf(item, sizeof(item), "{\"time\":\"2022-12-17 22:20:44\",\"timestamp\":%ld,\"timestamp_offset\":0}", BENCH_EPOCH + i);
+    return item;
+}
+
+// A whole response. 'data' is one object rather than an array for single item actions (time).
+std::string benchDocument(std::string (*item)(int), size_t items, bool single)
+{
+    std::string json = single ? "{\"data\":" : "{\"data\":[";
+
+    for (size_t i = 0; i < items; i++) {
+        if (i > 0) json += ",";
+        json += item(i);
+    }
+
+    json += single ? ",\"api_version\":3,\"cod\":200}" : "],\"api_version\":3,\"cod\":200}";
+    return json;
+}
+
+// An action=bundle response (refer to JsonBundleStreamer), of the fixtures above. "radar" wasn't
+// asked for, so has to be skipped, and "time_2" is a 304 that carries an etag.
+#define BENCH_BUNDLE_ETAG       "5f2b1de-1671321600"
+
+std::string benchBundle(size_t items)
+{
+    std::string json = "{";
+
+    json += "\"weather\":"    + benchDocument(weatherItem, items, false) + ",";
+    json += "\"radar\":"      + benchDocument(weatherItem, items, false) + ",";
+    json += "\"news\":"       + benchDocument(newsItem, items, false) + ",";
+    json += "\"ticker\":"     + benchDocument(tickerItem, items, false) + ",";
+    json += "\"time\":"       + benchDocument(timeItem, 1, true) + ",";
+    json += "\"time_2\":{\"cod\":304,\"etag\":\"" BENCH_BUNDLE_ETAG "\"},";
+    json += "\"api_version\":3,\"cod\":200}";
+
+    return json;
+}
+
+std::string benchMsgPack(const std::string &json)
+{
+    DynamicJsonDocument doc(json.size() * 4 + 1024);
+    deserializeJson(doc, json);
+
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+    return msgpack;
+}
+
+
+/*---- RUNS ----*/
+struct BenchResult
+{
+    size_t          bytes;
+    int             runs;
+    double          seconds;
+    long            peak_heap;      // Above where it started
+    unsigned long   allocations;    // Per run
+    bool            ok;
+};
+
+// As JsonProcessor::document_capacity(), but for however many items there are
+size_t benchDocumentCapacity(JsonProcessor &processor, JsonDocument &filter, size_t items)
+{
+    JsonVariant data = filter["data"];
+    size_t capacity  = JSON_OBJECT_SIZE(filter.size()) + JSON_FILTER_KEY_BYTES;
+
+    if (data.is<JsonArray>()) {
+        capacity += JSON_ARRAY_SIZE(items) + items * ( JSON_OBJECT_SIZE(data[0].size()) + processor.max_item_string_bytes() );
+    } else {
+        capacity += JSON_OBJECT_SIZE(data.size()) + processor.max_item_string_bytes();
+    }
+
+    return capacity;
+}
+
+void benchStart(BenchResult &result)
+{
+    benchHeap.peak          = benchHeap.current;
+    benchHeap.allocations   = 0;
+    result.ok               = true;
+}
+
+void benchEnd(BenchResult &result, long heap_start, std::chrono::steady_clock::time_point start)
+{
+    result.seconds      = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.peak_heap    = benchHeap.peak - heap_start;
+    result.allocations  = benchHeap.allocations / result.runs;
+}
+
+BenchResult runDocument(JsonProcessor &processor, const std::string &json, size_t items, int runs)
+{
+    BenchResult result  = { json.size(), runs };
+    long        heap    = benchHeap.current;
+
+    benchStart(result);
+    auto start = std::chrono::steady_clock::now();
+
+    for (int run = 0; run < runs; run++)
+    {
+        StaticJsonDocument<256> filter;
+        processor.build_filter(filter);
+
+        DynamicJsonDocument doc(benchDocumentCapacity(processor, filter, items));
+
+        DeserializationError error = deserializeJson(doc, json.data(), json.size(), DeserializationOption::Filter(filter));
+        if (error || !processor.process_json_document(doc)) result.ok = false;
+    }
+
+    benchEnd(result, heap, start);
+    return result;
+}
+
+BenchResult runStream(JsonProcessor &processor, const std::string &payload, bool msgpack, size_t items, int runs)
+{
+    BenchResult result  = { payload.size(), runs };
+    long        heap    = benchHeap.current;
+
+    benchStart(result);
+    auto start = std::chrono::steady_clock::now();
+
+    for (int run = 0; run < runs; run++)
+    {
+        StaticJsonDocument<256> filter;
+        processor.build_filter(filter);
+
+        ItemStreamer *streamer = newItemStreamer(msgpack, processor, getItemFilter(filter));
+
+        for (size_t offset = 0; offset < payload.size() && !streamer->done(); offset += BENCH_CHUNK_BYTES) {
+            feedStreamer(*streamer, payload.data() + offset, min((size_t) BENCH_CHUNK_BYTES, payload.size() - offset));
+        }
+
+        if ( !streamer->ok() || streamer->items_parsed != items || !streamer->finish() ) result.ok = false;
+        delete streamer;
+    }
+
+    benchEnd(result, heap, start);
+    return result;
+}
+
+// Every section of benchBundle() must come out where it should, whatever size the chunks are
+BenchResult runBundle(const std::string &payload, bool msgpack, size_t chunk, int runs)
+{
+    CurrentWeatherProcessor     weather;
+    NewsProcessor               news;
+    TickerProcessor             ticker;
+    TimeProcessor               time_1;
+    TimeProcessor               time_2;
+
+    weather.set_gmt_offset(0);
+    ticker.set_crypto_mode(true);
+    news.set_limit(0);
+
+    BenchResult result  = { payload.size(), runs };
+    long        heap    = benchHeap.current;
+
+    benchStart(result);
+    auto start = std::chrono::steady_clock::now();
+
+    for (int run = 0; run < runs; run++)
+    {
+        JsonBundleSection sections[] = {
+            { "weather",    &weather },
+            { "news",       &news    },
+            { "ticker",     &ticker  },
+            { "time",       &time_1  },
+            { "time_2",     &time_2  },
+        };
+        const size_t count = sizeof(sections) / sizeof(sections[0]);
+
+        FeedStreamer *streamer = newBundleStreamer(msgpack, sections, count);
+
+        for (size_t offset = 0; offset < payload.size() && !streamer->done(); offset += chunk) {
+            feedStreamer(*streamer, payload.data() + offset, min(chunk, payload.size() - offset));
+        }
+
+        if (!streamer->ok()) result.ok = false;
+        delete streamer;
+
+        for (size_t i = 0; i < count; i++) {
+            if ( !sections[i].received || !sections[i].result ) result.ok = false;
+        }
+
+        JsonBundleSection &cached = sections[count - 1];
+        if ( !cached.not_modified || strcmp(cached.etag, BENCH_BUNDLE_ETAG) != 0 ) result.ok = false;
+        for (size_t i = 0; i < count - 1; i++) {
+            if (sections[i].not_modified) result.ok = false;
+        }
+    }
+
+    benchEnd(result, heap, start);
+    return result;
+}
+
+void printResult(const char *name, const char *path, size_t items, const BenchResult &result)
+{
+    double items_per_s = (items * result.runs) / result.seconds;
+    double kb_per_s    = (result.bytes * result.runs) / result.seconds / 1024;
+
+    Serial.printf_P(PSTR("%-18s%-10s%7zu  %9zu  %12.0f  %9.0f  %10ld  %8lu  %s\n"), name, path, items, result.bytes,
+        items_per_s, kb_per_s, result.peak_heap, result.allocations, result.ok ? "ok" : "FAIL");
+}
+
+
+/*---- MAIN ----*/
+struct BenchCase
+{
+    const char      *name;
+    JsonProcessor   *processor;
+    std::string     (*item)(int);
+    bool            single;     // 'data' is one object, so the response is always one item
+};
+
+int main()
+{
+    CurrentWeatherProcessor     weather;
+    ForecastWeatherProcessor    forecast;
+    NewsProcessor               news;
+    TickerProcessor             ticker;
+    TimeProcessor               time_processor;
+
+    clockMain.setTime(BENCH_EPOCH);
+    weather.set_gmt_offset(0);
+    forecast.set_gmt_offset(0);
+    ticker.set_crypto_mode(true);
+    news.set_limit(0);
+
+    BenchCase cases[] = {
+        { "CurrentWeather",     &weather,           weatherItem,    false },
+        { "ForecastWeather",    &forecast,          weatherItem,    false },
+        { "News",               &news,              newsItem,       false },
+        { "Ticker",             &ticker,            tickerItem,     false },
+        { "Time",               &time_processor,    timeItem,       true  },
+    };
+
+    const size_t sizes[] = { 10, 100, 1000, 10000 };
+    int          failures = 0;
+
+    Serial.println(F("Processor         Path        Items      Bytes       Items/s       KB/s   Peak heap    Allocs"));
+
+    for (BenchCase &bench : cases)
+    {
+        for (size_t items : sizes)
+        {
+            if (bench.single && items > sizes[0]) break;
+            if (bench.single) items = 1;
+
+            std::string json    = benchDocument(bench.item, items, bench.single);
+            std::string msgpack = benchMsgPack(json);
+            int         runs    = max((size_t) 1, BENCH_ITEMS_PER_RUN / items);
+
+            BenchResult document    = runDocument(*bench.processor, json, items, runs);
+            BenchResult stream      = runStream(*bench.processor, json, false, items, runs);
+            BenchResult packed      = runStream(*bench.processor, msgpack, true, items, runs);
+
+            printResult(bench.name, "document", items, document);
+            printResult(bench.name, "json",     items, stream);
+            printResult(bench.name, "msgpack",  items, packed);
+
+            failures += !document.ok + !stream.ok + !packed.ok;
+        }
+    }
+
+    // The three feeds with data[] arrays, as one bundle. The smallest is also fed a byte at a
+    // time, as it can arrive off the wire.
+    for (size_t items : sizes)
+    {
+        std::string json    = benchBundle(items);
+        std::string msgpack = benchMsgPack(json);
+        size_t      total   = items * 3 + 1;
+        int         runs    = max((size_t) 1, BENCH_ITEMS_PER_RUN / total);
+
+        BenchResult stream  = runBundle(json, false, BENCH_CHUNK_BYTES, runs);
+        BenchResult packed  = runBundle(msgpack, true, BENCH_CHUNK_BYTES, runs);
+
+        printResult("Bundle", "json",    total, stream);
+        printResult("Bundle", "msgpack", total, packed);
+
+        failures += !stream.ok + !packed.ok;
+
+        if (items == sizes[0]) {
+            BenchResult json_bytes      = runBundle(json, false, 1, 1);
+            BenchResult msgpack_bytes   = runBundle(msgpack, true, 1, 1);
+
+            printResult("Bundle", "json/1B",    total, json_bytes);
+            printResult("Bundle", "msgpack/1B", total, msgpack_bytes);
+
+            failures += !json_bytes.ok + !msgpack_bytes.ok;
+        }
+    }
+
+    if (failures) Serial.printf_P(PSTR("%d runs FAILED\n"), failures);
+    return failures ? 1 : 0;
+}
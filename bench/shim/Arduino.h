@@ -0,0 +1,215 @@
+#ifndef ARDUINO_SHIM_H
+#define ARDUINO_SHIM_H
+
+/*--------------------------- ARDUINO SHIM (NATIVE BUILD) -----------------------------*/
+/*
+ * Just enough of the ESP8266 Arduino core for the feed processors and stream parsers to build
+ * on Linux, refer to bench/ProcessorBench.cpp and [env:native] in platformio.ini. Flash
+ * strings are plain strings, and Serial is stdout.
+ *
+ * For the display bench (bench/DisplayBench.cpp, [env:native_display]) it also has the pins
+ * and Print that MD_MAX72XX and MD_Parola use. Pin writes and shiftOut() go to shimPins, which
+ * is how the MAX7219 emulator sees the chip select (refer to shim/MAX7219Emulator.h).
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define PSTR(s)                 (s)
+#define F(s)                    (s)
+#define snprintf_P              snprintf
+#define sprintf_P               sprintf
+#define strcmp_P                strcmp
+#define strncmp_P               strncmp
+#define strncpy_P               strncpy
+#define pgm_read_byte(addr)     (*(const uint8_t *) (addr))
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define bitRead(value, bit)             (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)              ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)            ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue)  ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+
+inline long random(long low, long high)     { return (high > low) ? low + std::rand() % (high - low) : low; }
+inline long random(long high)               { return random(0, high); }
+inline void randomSeed(unsigned long seed)  { std::srand(seed); }
+
+// glibc only has it from 2.38
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+inline size_t strlcpy(char *dst, const char *src, size_t size)
+{
+    size_t length = strlen(src);
+    if (size > 0) {
+        size_t n = min(length, size - 1);
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return length;
+}
+#endif
+
+/*---- TIME ----*/
+// A bench can run on its own clock, so what's drawn is the same every run. delay() then moves it.
+struct ShimClock
+{
+    bool            manual      = false;
+    unsigned long   manual_us   = 0;
+
+    void advance(unsigned long ms)  { manual_us += ms * 1000; }
+};
+
+inline ShimClock shimClock;
+
+inline unsigned long micros()
+{
+    if (shimClock.manual) return shimClock.manual_us;
+
+    static auto start = std::chrono::steady_clock::now();
+    return (unsigned long) std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline unsigned long millis()   { return micros() / 1000; }
+inline void yield()             { }
+inline void delay(unsigned long ms) { if (shimClock.manual) shimClock.advance(ms); }
+
+/*---- PINS ----*/
+#define LOW         0
+#define HIGH        1
+#define INPUT       0
+#define OUTPUT      1
+#define LSBFIRST    0
+#define MSBFIRST    1
+
+// Something listening to the pins, i.e. an emulated display
+struct ShimPins
+{
+    void (*write)(uint8_t pin, uint8_t value)   = nullptr;
+    void (*shift)(uint8_t value)                = nullptr;  // A byte clocked out, MSB first
+};
+
+inline ShimPins shimPins;
+
+inline void pinMode(uint8_t, uint8_t)           { }
+inline int  digitalRead(uint8_t)                { return LOW; }
+inline int  analogRead(uint8_t)                 { return 0; }
+
+inline void digitalWrite(uint8_t pin, uint8_t value)
+{
+    if (shimPins.write) shimPins.write(pin, value);
+}
+
+inline void shiftOut(uint8_t, uint8_t, uint8_t order, uint8_t value)
+{
+    if (order == LSBFIRST) {
+        uint8_t reversed = 0;
+        for (int i = 0; i < 8; i++) if (value & (1 << i)) reversed |= 0x80 >> i;
+        value = reversed;
+    }
+    if (shimPins.shift) shimPins.shift(value);
+}
+
+/*---- SERIAL ----*/
+class SerialShim {
+
+    public:
+        void begin(unsigned long) { }
+
+        template <typename T> void print(const T &value)            { std::cout << value; }
+        template <typename T> void println(const T &value)          { std::cout << value << '\n'; }
+        void println()                                              { std::cout << '\n'; }
+
+        void printf_P(const char *format, ...)
+        {
+            va_list args;
+            va_start(args, format);
+            std::vfprintf(stdout, format, args);
+            va_end(args);
+        }
+
+        void printf(const char *format, ...)
+        {
+            va_list args;
+            va_start(args, format);
+            std::vfprintf(stdout, format, args);
+            va_end(args);
+        }
+
+}; // end SerialShim
+
+extern SerialShim Serial;
+
+/*---- PRINT ----*/
+class Print {
+
+    public:
+        virtual ~Print() { }
+
+        virtual size_t write(uint8_t c) = 0;
+
+        virtual size_t write(const uint8_t *buffer, size_t size)
+        {
+            size_t n = 0;
+            while (size--) n += write(*buffer++);
+            return n;
+        }
+
+        size_t write(const char *str)                   { return str ? write((const uint8_t *) str, strlen(str)) : 0; }
+        size_t print(const char *str)                   { return write(str); }
+        size_t print(char c)                            { return write((uint8_t) c); }
+        size_t print(long value)                        { return print(std::to_string(value).c_str()); }
+        size_t println(const char *str)                 { return print(str) + print('\n'); }
+
+}; // end Print
+
+/*---- STREAM ----*/
+class Stream {
+
+    protected:
+        unsigned long timeout_ms = 1000;
+
+    public:
+        virtual ~Stream() { }
+
+        virtual int available()     = 0;
+        virtual int read()          = 0;
+        virtual int peek()          = 0;
+
+        virtual size_t readBytes(char *buffer, size_t length)
+        {
+            size_t n = 0;
+            while (n < length) {
+                int c = read();
+                if (c < 0) break;
+                buffer[n++] = (char) c;
+            }
+            return n;
+        }
+
+        size_t readBytes(uint8_t *buffer, size_t length)
+        {
+            return readBytes((char *) buffer, length);
+        }
+
+        void setTimeout(unsigned long _timeout_ms) { timeout_ms = _timeout_ms; }
+
+}; // end Stream
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef BENCH_HEAP_H
+#define BENCH_HEAP_H
+
+/*--------------------------- BENCH HEAP ACCOUNTING (NATIVE BUILD) -----------------------------*/
+/*
+ * [env:native] wraps malloc() and friends at link time (-Wl,--wrap in platformio.ini), so every
+ * program built in it, the processor bench and the unit tests under test/, includes this once
+ * for the __wrap_ functions. benchHeap is only read by bench/ProcessorBench.cpp.
+ */
+#include <Arduino.h>
+#include <malloc.h>
+#include <new>
+
+/*---- HEAP ----*/
+struct BenchHeap
+{
+    long            current;
+    long            peak;
+    unsigned long   allocations;
+};
+
+BenchHeap benchHeap;
+
+static void heapAdd(void *p)
+{
+    if (!p) return;
+
+    benchHeap.current += malloc_usable_size(p);
+    benchHeap.peak     = max(benchHeap.peak, benchHeap.current);
+    benchHeap.allocations++;
+}
+
+static void heapRemove(void *p)
+{
+    if (p) benchHeap.current -= malloc_usable_size(p);
+}
+
+extern "C" {
+    void* __real_malloc(size_t size);
+    void* __real_calloc(size_t count, size_t size);
+    void* __real_realloc(void *p, size_t size);
+    void  __real_free(void *p);
+
+    void* __wrap_malloc(size_t size)                { void *p = __real_malloc(size);        heapAdd(p); return p; }
+    void* __wrap_calloc(size_t count, size_t size)  { void *p = __real_calloc(count, size); heapAdd(p); return p; }
+    void  __wrap_free(void *p)                      { heapRemove(p); __real_free(p); }
+
+    void* __wrap_realloc(void *p, size_t size)
+    {
+        size_t  old_size    = p ? malloc_usable_size(p) : 0;
+        void    *q          = __real_realloc(p, size);
+
+        if (q) {
+            benchHeap.current -= old_size;
+            heapAdd(q);
+        }
+        return q;
+    }
+}
+
+// So the standard containers (and the streamers' buffers) are counted too
+void* operator new(size_t size)
+{
+    void *p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size)               { return operator new(size); }
+void  operator delete(void *p) noexcept         { free(p); }
+void  operator delete[](void *p) noexcept       { free(p); }
+void  operator delete(void *p, size_t) noexcept    { free(p); }
+void  operator delete[](void *p, size_t) noexcept  { free(p); }
+
+#endif // BENCH_HEAP_H
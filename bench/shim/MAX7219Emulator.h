@@ -0,0 +1,277 @@
+#ifndef MAX7219_EMULATOR_H
+#define MAX7219_EMULATOR_H
+
+/*--------------------------- MAX7219 EMULATOR (NATIVE BUILD) -----------------------------*/
+/*
+ * A chain of MAX7219 LED matrix modules, on the far side of the SPI and pin shims. MD_MAX72XX
+ * and MD_Parola run as they are, and what they send is decoded the way the chips would: the
+ * bytes clocked out while CS is low are 16 bit words, the first of them for the module
+ * furthest along the chain, and they're latched when CS goes high.
+ *
+ * The digit registers are mapped back to display columns as MD_MAX72XX maps them for the
+ * module type (FC16_HW by default), so column 0 is the rightmost column of module 0, and bit 0
+ * of a column is the top row, as in the fonts.
+ *
+ * Everything latched within the same millis() is one frame. Frames that change the display
+ * are kept, so they can be printed as ASCII art, written as PGM images, or hashed to compare
+ * runs. Run on the shim's manual clock (shimClock.manual) for frames that are the same every
+ * time.
+ */
+#include <Arduino.h>
+#include <vector>
+
+#define MAX7219_REG_NOOP        0x00
+#define MAX7219_REG_DIGIT0      0x01    // To 0x08
+#define MAX7219_REG_DECODE      0x09
+#define MAX7219_REG_INTENSITY   0x0A
+#define MAX7219_REG_SCANLIMIT   0x0B
+#define MAX7219_REG_SHUTDOWN    0x0C
+#define MAX7219_REG_TEST        0x0F
+
+#define MAX7219_ROWS            8
+#define MAX7219_FRAMES_MAX      100000  // Kept frames, beyond which they're only counted
+
+// How the digit registers are wired to the LEDs, as MD_MAX72XX's hardware types
+struct MAX7219Wiring
+{
+    bool    dig_rows;       // Each digit register is a row, not a column
+    bool    rev_cols;
+    bool    rev_rows;
+};
+
+const MAX7219Wiring MAX7219_PAROLA_HW       = { true,  true,  false };
+const MAX7219Wiring MAX7219_GENERIC_HW      = { false, true,  false };
+const MAX7219Wiring MAX7219_ICSTATION_HW    = { true,  true,  true  };
+const MAX7219Wiring MAX7219_FC16_HW         = { true,  false, false };
+
+struct MAX7219Stats
+{
+    unsigned long   frames;             // That changed the display
+    unsigned long   latches;            // CS rising edges
+    unsigned long   spi_bytes;
+    unsigned long   columns_changed;    // Across all frames
+    unsigned long   first_ms;
+    unsigned long   last_ms;
+};
+
+class MAX7219Emulator {
+
+    private:
+        struct Module
+        {
+            uint8_t     digits[MAX7219_ROWS];
+            uint8_t     intensity;
+            uint8_t     scan_limit;
+            bool        shutdown;
+            bool        test;
+        };
+
+        static inline MAX7219Emulator   *attached   = nullptr;
+
+        uint8_t                 cs_pin;
+        MAX7219Wiring           wiring;
+        std::vector<Module>     modules;
+        std::vector<uint8_t>    shifted;        // Since CS went low
+        std::vector<uint8_t>    shown;          // Columns of the last frame
+        std::vector<uint8_t>    kept;           // Columns of each kept frame, one after another
+
+        bool                    frame_open  = false;
+        unsigned long           frame_ms    = 0;
+
+        static void onWrite(uint8_t pin, uint8_t value)
+        {
+            if (attached && pin == attached->cs_pin) attached->chipSelect(value);
+        }
+
+        static void onShift(uint8_t value)
+        {
+            if (attached) {
+                attached->shifted.push_back(value);
+                attached->stats.spi_bytes++;
+            }
+        }
+
+        void chipSelect(uint8_t value)
+        {
+            if (value == LOW) {
+                shifted.clear();
+                return;
+            }
+
+            unsigned long now = millis();
+            if (frame_open && now != frame_ms) flush();
+
+            frame_open  = true;
+            frame_ms    = now;
+            stats.latches++;
+
+            // Anything more than the chain holds has passed out of the end of it
+            size_t words = shifted.size() / 2;
+            for (size_t i = 0; i < words; i++) {
+                size_t device = words - 1 - i;
+                if (device < modules.size()) latch(modules[device], shifted[i * 2] & 0x0F, shifted[i * 2 + 1]);
+            }
+            shifted.clear();
+        }
+
+        static void latch(Module &module, uint8_t reg, uint8_t data)
+        {
+            switch (reg) {
+                case MAX7219_REG_INTENSITY:     module.intensity    = data & 0x0F;  break;
+                case MAX7219_REG_SCANLIMIT:     module.scan_limit   = data & 0x07;  break;
+                case MAX7219_REG_SHUTDOWN:      module.shutdown     = !(data & 1);  break;
+                case MAX7219_REG_TEST:          module.test         = (data & 1);   break;
+                case MAX7219_REG_NOOP:
+                case MAX7219_REG_DECODE:                                            break;
+                default:                        module.digits[reg - MAX7219_REG_DIGIT0] = data;
+            }
+        }
+
+        // What the LEDs of a module column show, bit 0 at the top
+        uint8_t lit(const Module &module, uint8_t column) const
+        {
+            if (module.test)        return 0xFF;
+            if (module.shutdown)    return 0x00;
+
+            uint8_t value = 0;
+            for (uint8_t row = 0; row < MAX7219_ROWS; row++) {
+                uint8_t digit   = wiring.dig_rows ? row : column;
+                uint8_t bit     = wiring.dig_rows ? column : row;
+
+                if (wiring.dig_rows) {
+                    if (wiring.rev_rows) digit = MAX7219_ROWS - 1 - digit;
+                    if (wiring.rev_cols) bit   = MAX7219_ROWS - 1 - bit;
+                } else {
+                    if (wiring.rev_cols) digit = MAX7219_ROWS - 1 - digit;
+                    if (wiring.rev_rows) bit   = MAX7219_ROWS - 1 - bit;
+                }
+
+                if ( digit <= module.scan_limit && (module.digits[digit] & (1 << bit)) ) value |= (1 << row);
+            }
+            return value;
+        }
+
+    public:
+        MAX7219Stats    stats       = {};
+
+        MAX7219Emulator(uint8_t _cs_pin, uint8_t devices, MAX7219Wiring _wiring = MAX7219_FC16_HW) :
+            cs_pin(_cs_pin), wiring(_wiring), modules(devices), shown(devices * MAX7219_ROWS, 0)
+        {
+            // As the chips power up: blank, and shut down until told otherwise
+            for (Module &module : modules) module = { {0}, 0, 7, true, false };
+        }
+
+        ~MAX7219Emulator()  { detach(); }
+
+        // Listen to the pin and SPI shims. One emulator at a time.
+        void attach()
+        {
+            attached        = this;
+            shimPins.write  = onWrite;
+            shimPins.shift  = onShift;
+        }
+
+        void detach()
+        {
+            if (attached != this) return;
+
+            attached        = nullptr;
+            shimPins.write  = nullptr;
+            shimPins.shift  = nullptr;
+        }
+
+        uint16_t columnCount() const        { return modules.size() * MAX7219_ROWS; }
+        uint8_t  intensity(uint8_t device)  { return modules[device].intensity; }
+
+        // As the display shows it now, column 0 being the rightmost
+        uint8_t column(uint16_t c) const    { return lit(modules[c / MAX7219_ROWS], c % MAX7219_ROWS); }
+
+        // Close the frame that's being latched, keeping it if it changed anything
+        void flush()
+        {
+            if (!frame_open) return;
+            frame_open = false;
+
+            unsigned long changed = 0;
+            for (uint16_t c = 0; c < columnCount(); c++) {
+                uint8_t now = column(c);
+                if (now != shown[c]) changed++;
+                shown[c] = now;
+            }
+            if (!changed) return;
+
+            if (!stats.frames) stats.first_ms = frame_ms;
+            stats.last_ms = frame_ms;
+            stats.frames++;
+            stats.columns_changed += changed;
+
+            if (frameCount() < MAX7219_FRAMES_MAX) kept.insert(kept.end(), shown.begin(), shown.end());
+        }
+
+        // Forget the frames and counts, but not what's on the display
+        void reset()
+        {
+            flush();
+            kept.clear();
+            stats = {};
+        }
+
+        size_t          frameCount() const          { return kept.size() / columnCount(); }
+        const uint8_t*  frame(size_t i) const       { return &kept[i * columnCount()]; }
+
+        // Frames per second of display time, from the first kept frame to the last
+        double fps() const
+        {
+            unsigned long ms = stats.last_ms - stats.first_ms;
+            return (stats.frames > 1 && ms) ? (stats.frames - 1) * 1000.0 / ms : 0;
+        }
+
+        // FNV-1a of the kept frames, to tell whether two runs drew the same thing
+        uint32_t hash() const
+        {
+            uint32_t h = 2166136261u;
+            for (uint8_t b : kept) h = (h ^ b) * 16777619u;
+            return h;
+        }
+
+        // A frame (or the display now, with nullptr), a line per row, leftmost column first
+        void printAscii(FILE *out, const uint8_t *columns = nullptr) const
+        {
+            for (uint8_t row = 0; row < MAX7219_ROWS; row++) {
+                for (int c = columnCount() - 1; c >= 0; c--) {
+                    uint8_t value = columns ? columns[c] : column(c);
+                    fputc((value & (1 << row)) ? '#' : '.', out);
+                }
+                fputc('\n', out);
+            }
+        }
+
+        // Kept frames from first, as a strip of them one under another, each pixel scale square
+        bool writePGM(const char *path, size_t first = 0, size_t count = SIZE_MAX, uint8_t scale = 4) const
+        {
+            if (first >= frameCount()) return false;
+            count = std::min(count, frameCount() - first);
+
+            FILE *out = fopen(path, "wb");
+            if (!out) return false;
+
+            size_t width    = columnCount() * scale;
+            size_t height   = count * (MAX7219_ROWS + 1) * scale;
+            fprintf(out, "P5\n%zu %zu\n255\n", width, height);
+
+            std::vector<uint8_t> line(width);
+            for (size_t f = first; f < first + count; f++) {
+                for (uint8_t row = 0; row <= MAX7219_ROWS; row++) {
+                    for (size_t x = 0; x < width; x++) {
+                        uint8_t value = frame(f)[columnCount() - 1 - x / scale];
+                        line[x] = (row == MAX7219_ROWS) ? 0 : (value & (1 << row)) ? 255 : 40;
+                    }
+                    for (uint8_t y = 0; y < scale; y++) fwrite(line.data(), 1, width, out);
+                }
+            }
+            return fclose(out) == 0;
+        }
+
+}; // end MAX7219Emulator
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef SPI_SHIM_H
+#define SPI_SHIM_H
+
+/*--------------------------- SPI SHIM (NATIVE BUILD) -----------------------------*/
+/*
+ * The hardware SPI that MD_MAX72XX writes to. Every byte goes to shimPins.shift, as it would
+ * with software SPI, so the MAX7219 emulator sees both the same way (refer to Arduino.h).
+ */
+#include <Arduino.h>
+
+#define SPI_MODE0   0x00
+#define SPI_MODE1   0x04
+#define SPI_MODE2   0x08
+#define SPI_MODE3   0x0C
+
+class SPISettings {
+
+    public:
+        SPISettings() { }
+        SPISettings(uint32_t, uint8_t, uint8_t) { }
+
+}; // end SPISettings
+
+class SPIClass {
+
+    public:
+        void begin()                            { }
+        void end()                              { }
+        void beginTransaction(SPISettings)      { }
+        void endTransaction()                   { }
+        void setBitOrder(uint8_t)               { }
+        void setDataMode(uint8_t)               { }
+        void setFrequency(uint32_t)             { }
+
+        uint8_t transfer(uint8_t data)
+        {
+            if (shimPins.shift) shimPins.shift(data);
+            return 0;
+        }
+
+        void transfer(void *buffer, size_t size)
+        {
+            for (uint8_t *p = (uint8_t *) buffer; size--; p++) transfer(*p);
+        }
+
+}; // end SPIClass
+
+inline SPIClass SPI;
+
+#endif
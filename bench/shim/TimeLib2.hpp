@@ -0,0 +1,61 @@
+#ifndef TIMELIB2_SHIM_H
+#define TIMELIB2_SHIM_H
+
+/*--------------------------- TIMELIB2 SHIM (NATIVE BUILD) -----------------------------*/
+/*
+ * The parts of https://github.com/mrfaptastic/TimeLib2 the processors use. The clock only
+ * moves when it's set, so a benchmark run is the same every time.
+ */
+#include <ctime>
+
+// As TimeLib's, for the countdown
+#define SECS_PER_MIN            60L
+#define SECS_PER_HOUR           3600L
+#define SECS_PER_DAY            (SECS_PER_HOUR * 24L)
+#define numberOfSeconds(_time_) ((_time_) % SECS_PER_MIN)
+#define numberOfMinutes(_time_) (((_time_) / SECS_PER_MIN) % SECS_PER_MIN)
+#define numberOfHours(_time_)   (((_time_) % SECS_PER_DAY) / SECS_PER_HOUR)
+#define elapsedDays(_time_)     ((_time_) / SECS_PER_DAY)
+
+inline const char* dayStr(int day)     // Sunday is 1
+{
+    static const char *names[] = { "Err", "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
+    return (day >= 1 && day <= 7) ? names[day] : names[0];
+}
+
+class TimeLib2 {
+
+    private:
+        time_t  epoch   = 0;
+        time_t  offset  = 0;
+
+        static struct tm breakdown(time_t t)
+        {
+            struct tm parts;
+            gmtime_r(&t, &parts);
+            return parts;
+        }
+
+    public:
+        void    setTime(time_t t)           { epoch  = t; }
+        void    setOffset(time_t _offset)   { offset = _offset; }
+        time_t  getEpochSecond()            { return epoch; }
+        time_t  now()                       { return epoch + offset; }
+
+        int     hour(time_t t)      { return breakdown(t).tm_hour; }
+        int     minute(time_t t)    { return breakdown(t).tm_min; }
+        int     day(time_t t)       { return breakdown(t).tm_mday; }
+        int     weekday(time_t t)   { return breakdown(t).tm_wday + 1; }
+        int     month(time_t t)     { return breakdown(t).tm_mon + 1; }
+        bool    isAM(time_t t)      { return hour(t) < 12; }
+
+        int     hour()              { return hour(now()); }
+        int     minute()            { return minute(now()); }
+        int     day()               { return day(now()); }
+        int     weekday()           { return weekday(now()); }
+        int     month()             { return month(now()); }
+        bool    isAM()              { return isAM(now()); }
+
+}; // end TimeLib2
+
+#endif
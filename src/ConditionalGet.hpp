@@ -0,0 +1,106 @@
+#ifndef CONDITIONAL_GET_H
+#define CONDITIONAL_GET_H
+
+#include <TimeLib2.hpp>
+#include "TickerDebug.hpp"
+
+extern TimeLib2 clockMain;
+
+/*--------------------------- CONDITIONAL GET -----------------------------*/
+/*
+ * Most hourly refreshes of news, forecast and stocks get back exactly what we already have.
+ * The ETag / Last-Modified of the last good response for each action is kept here and sent
+ * with the next request (If-None-Match / If-Modified-Since). A 304 Not Modified means the
+ * lists we already have are kept as they are, with nothing downloaded or parsed.
+ *
+ * Validators are dropped at midnight, as the forecast text is relative to today ("Tomorrow").
+ */
+#define CONDITIONAL_GET_SLOTS 8
+
+struct ConditionalGetEntry
+{
+    char            action[20];
+    uint32_t        params_hash;        // A validator only applies to the same query
+    char            etag[48];
+    char            last_modified[32];
+    int             day;                // Day of the month it was stored
+    unsigned long   hits;               // 304 Not Modified
+    unsigned long   misses;             // Full response
+
+    bool has_validator()
+    {
+        return (etag[0] || last_modified[0]) && (day == clockMain.day());
+    }
+};
+
+class ConditionalGetCache {
+
+    private:
+        ConditionalGetEntry entries[CONDITIONAL_GET_SLOTS];
+        int                 count = 0;
+
+        // FNV-1a, https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+        static uint32_t hash(const String &s)
+        {
+            uint32_t h = 2166136261UL;
+            for (unsigned int i = 0; i < s.length(); i++) {
+                h = (h ^ (uint8_t) s[i]) * 16777619UL;
+            }
+            return h;
+        }
+
+    public:
+        // Entry for this action, created if need be. If the query changed (i.e. new config), the
+        // old validators don't apply any more.
+        ConditionalGetEntry* find(const String &action, const String &params)
+        {
+            uint32_t params_hash = hash(params);
+
+            ConditionalGetEntry *entry = nullptr;
+            for (int i = 0; i < count && !entry; i++) {
+                if (action.equals(entries[i].action)) entry = &entries[i];
+            }
+
+            if (!entry)
+            {
+                int slot = (count < CONDITIONAL_GET_SLOTS) ? count++ : (CONDITIONAL_GET_SLOTS-1);
+                entry = &entries[slot];
+
+                memset(entry, 0, sizeof(ConditionalGetEntry));
+                action.toCharArray(entry->action, sizeof(entry->action));
+                entry->params_hash = params_hash;
+            }
+
+            if (entry->params_hash != params_hash) {
+                entry->params_hash      = params_hash;
+                entry->etag[0]          = '\0';
+                entry->last_modified[0] = '\0';
+            }
+
+            return entry;
+        }
+
+        // After a response has been parsed successfully. Pass empty strings to forget.
+        void store(ConditionalGetEntry *entry, const char *etag, const char *last_modified)
+        {
+            strlcpy(entry->etag,          etag,          sizeof(entry->etag));
+            strlcpy(entry->last_modified, last_modified, sizeof(entry->last_modified));
+            entry->day = clockMain.day();
+        }
+
+        // 'xv' in handleSerialRead
+        void print()
+        {
+            Serial.println(F("Action              Hits  Misses  Validator"));
+
+            for (int i = 0; i < count; i++) {
+                ConditionalGetEntry &entry = entries[i];
+                Serial.printf_P(PSTR("%-18s%6lu  %6lu  %s\r\n"), entry.action, entry.hits, entry.misses, entry.etag[0] ? entry.etag : entry.last_modified);
+            }
+        }
+
+}; // end ConditionalGetCache
+
+ConditionalGetCache conditionalGets;
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef CURRENCY_GLYPHS_H
+#define CURRENCY_GLYPHS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+/*--------------------------- CURRENCY GLYPHS -----------------------------*/
+/*
+ * What to show in front of a price for each ISO 4217 currency. Some symbols are already in the
+ * MD_MAX72xx font (refer to https://github.com/MajicDesigns/MD_MAX72XX/blob/main/src/MD_MAX72xx_font.cpp):
+ * $, 128 Euro, 162 Cent, 163 Pound and 165 Yen. The rest of the single character symbols are
+ * drawn below, and added to Parola at 0x81 onwards by addCurrencyGlyphs() (CustomParola.hpp).
+ * Currencies without a symbol of their own get their usual letters, or the code itself.
+ *
+ * Lookup is a perfect hash, built by the compiler from the table: the code picks a bucket, and
+ * the bucket's displacement then places it in one of CURRENCY_HASH_SLOTS slots, which no other
+ * code uses. A static_assert stops the build if a change to the table can't be placed.
+ */
+#define CURRENCY_HASH_SLOTS      256
+#define CURRENCY_HASH_BUCKETS    64
+#define CURRENCY_HASH_BUCKET_MAX 8      // Codes that can share a bucket
+#define CURRENCY_NONE            0xFF
+
+struct CurrencyGlyph
+{
+    char    code[4];
+    char    symbol[5];
+};
+
+constexpr CurrencyGlyph CURRENCY_GLYPHS[] PROGMEM = {
+    { "AED", "Dh"   }, { "AFN", "Af"   }, { "ALL", "L"    }, { "AMD", "AMD"  }, { "ANG", "\x93" }, { "AOA", "Kz"   },
+    { "ARS", "$"    }, { "AUD", "A$"   }, { "AWG", "\x93" }, { "AZN", "\x8D" }, { "BAM", "KM"   }, { "BBD", "Bds$" },
+    { "BDT", "Tk"   }, { "BGN", "lv"   }, { "BHD", "BD"   }, { "BIF", "FBu"  }, { "BMD", "$"    }, { "BND", "B$"   },
+    { "BOB", "Bs"   }, { "BOV", "BOV"  }, { "BRL", "R$"   }, { "BSD", "B$"   }, { "BTN", "Nu"   }, { "BWP", "P"    },
+    { "BYN", "Br"   }, { "BZD", "BZ$"  }, { "CAD", "C$"   }, { "CDF", "FC"   }, { "CHE", "CHE"  }, { "CHF", "Fr"   },
+    { "CHW", "CHW"  }, { "CLF", "UF"   }, { "CLP", "$"    }, { "CNY", "\xA5" }, { "COP", "$"    }, { "COU", "COU"  },
+    { "CRC", "\x90" }, { "CUC", "CUC"  }, { "CUP", "$"    }, { "CVE", "Esc"  }, { "CZK", "Kc"   }, { "DJF", "Fdj"  },
+    { "DKK", "kr"   }, { "DOP", "RD$"  }, { "DZD", "DA"   }, { "EGP", "E\xA3"}, { "ERN", "Nfk"  }, { "ETB", "Br"   },
+    { "EUR", "\x80" }, { "FJD", "FJ$"  }, { "FKP", "\xA3" }, { "GBP", "\xA3" }, { "GEL", "\x92" }, { "GHS", "\x8C" },
+    { "GIP", "\xA3" }, { "GMD", "D"    }, { "GNF", "FG"   }, { "GTQ", "Q"    }, { "GYD", "G$"   }, { "HKD", "HK$"  },
+    { "HNL", "L"    }, { "HTG", "G"    }, { "HUF", "Ft"   }, { "IDR", "Rp"   }, { "ILS", "\x86" }, { "INR", "\x81" },
+    { "IQD", "ID"   }, { "IRR", "Rl"   }, { "ISK", "kr"   }, { "JMD", "J$"   }, { "JOD", "JD"   }, { "JPY", "\xA5" },
+    { "KES", "KSh"  }, { "KGS", "som"  }, { "KHR", "KHR"  }, { "KMF", "CF"   }, { "KPW", "\x82" }, { "KRW", "\x82" },
+    { "KWD", "KD"   }, { "KYD", "CI$"  }, { "KZT", "\x8B" }, { "LAK", "\x8F" }, { "LBP", "L\xA3"}, { "LKR", "Rs"   },
+    { "LRD", "L$"   }, { "LSL", "L"    }, { "LYD", "LD"   }, { "MAD", "DH"   }, { "MDL", "L"    }, { "MGA", "Ar"   },
+    { "MKD", "den"  }, { "MMK", "K"    }, { "MNT", "\x8E" }, { "MOP", "MOP$" }, { "MRU", "UM"   }, { "MUR", "Rs"   },
+    { "MVR", "Rf"   }, { "MWK", "MK"   }, { "MXN", "MX$"  }, { "MXV", "MXV"  }, { "MYR", "RM"   }, { "MZN", "MT"   },
+    { "NAD", "N$"   }, { "NGN", "\x89" }, { "NIO", "C$"   }, { "NOK", "kr"   }, { "NPR", "Rs"   }, { "NZD", "NZ$"  },
+    { "OMR", "RO"   }, { "PAB", "B/."  }, { "PEN", "S/"   }, { "PGK", "K"    }, { "PHP", "\x85" }, { "PKR", "Rs"   },
+    { "PLN", "zl"   }, { "PYG", "\x91" }, { "QAR", "QR"   }, { "RON", "lei"  }, { "RSD", "din"  }, { "RUB", "\x83" },
+    { "RWF", "FRw"  }, { "SAR", "SR"   }, { "SBD", "SI$"  }, { "SCR", "SR"   }, { "SDG", "SDG"  }, { "SEK", "kr"   },
+    { "SGD", "S$"   }, { "SHP", "\xA3" }, { "SLE", "Le"   }, { "SLL", "Le"   }, { "SOS", "Sh"   }, { "SRD", "$"    },
+    { "SSP", "SS\xA3"}, { "STN", "Db"  }, { "SVC", "\x90" }, { "SYP", "LS"   }, { "SZL", "E"    }, { "THB", "\x8A" },
+    { "TJS", "SM"   }, { "TMT", "m"    }, { "TND", "DT"   }, { "TOP", "T$"   }, { "TRY", "\x84" }, { "TTD", "TT$"  },
+    { "TWD", "NT$"  }, { "TZS", "TSh"  }, { "UAH", "\x88" }, { "UGX", "USh"  }, { "USD", "$"    }, { "USN", "$"    },
+    { "UYI", "UYI"  }, { "UYU", "$U"   }, { "UYW", "UYW"  }, { "UZS", "som"  }, { "VED", "Bs"   }, { "VES", "Bs"   },
+    { "VND", "\x87" }, { "VUV", "VT"   }, { "WST", "WS$"  }, { "XAF", "FCFA" }, { "XAG", "XAG"  }, { "XAU", "XAU"  },
+    { "XBA", "XBA"  }, { "XBB", "XBB"  }, { "XBC", "XBC"  }, { "XBD", "XBD"  }, { "XCD", "EC$"  }, { "XCG", "\x93" },
+    { "XDR", "SDR"  }, { "XOF", "CFA"  }, { "XPD", "XPD"  }, { "XPF", "F"    }, { "XPT", "XPT"  }, { "XSU", "XSU"  },
+    { "XTS", "XTS"  }, { "XUA", "XUA"  }, { "XXX", "XXX"  }, { "YER", "Rl"   }, { "ZAR", "R"    }, { "ZMW", "K"    },
+    { "ZWG", "ZiG"  }, { "ZWL", "Z$"   },
+};
+
+#define CURRENCY_GLYPH_COUNT     (sizeof(CURRENCY_GLYPHS) / sizeof(CURRENCY_GLYPHS[0]))
+
+// Symbols the font doesn't have, as Parola user characters: width, then a byte per column (bit 0 at the top)
+#define CURRENCY_FONT_FIRST      0x81
+
+uint8_t currencyFontGlyphs[][6] = {
+    { 5,  21,  21,  53,  79,  69 },     // 0x81 Rupee (INR)
+    { 5, 127,  52,  28,  52, 127 },     // 0x82 Won (KRW, KPW)
+    { 5,  40, 127,  41,   9,   6 },     // 0x83 Ruble (RUB)
+    { 5,   8, 127,  68,  66,  48 },     // 0x84 Lira (TRY)
+    { 5,  10, 127,  27,  27,  14 },     // 0x85 Peso (PHP)
+    { 5, 127,   1,  95,  64, 127 },     // 0x86 Shekel (ILS)
+    { 5,  72,  84,  85,  95,  65 },     // 0x87 Dong (VND)
+    { 5,  54,  85,  93,  85,  54 },     // 0x88 Hryvnia (UAH)
+    { 5, 127,  22,  28,  52, 127 },     // 0x89 Naira (NGN)
+    { 5,  65, 127,  73,  73,  54 },     // 0x8A Baht (THB)
+    { 5,   5,   5, 125,   5,   5 },     // 0x8B Tenge (KZT)
+    { 5,  28,  34, 127,  34,  34 },     // 0x8C Cedi (GHS)
+    { 5, 124,   2,  15,   2, 124 },     // 0x8D Manat (AZN)
+    { 5,   1,  41, 127,  21,   1 },     // 0x8E Tugrik (MNT)
+    { 5, 127,  28,  42,  73,   8 },     // 0x8F Kip (LAK)
+    { 5,  92,  54, 107,  54,  35 },     // 0x90 Colon (CRC, SVC)
+    { 5,  28,  34, 127,  42,  26 },     // 0x91 Guarani (PYG)
+    { 5, 120,  71,  76,  71, 120 },     // 0x92 Lari (GEL)
+    { 5,  64,  68,  62,   5,   1 },     // 0x93 Florin (AWG, ANG, XCG)
+};
+
+#define CURRENCY_FONT_COUNT      (sizeof(currencyFontGlyphs) / sizeof(currencyFontGlyphs[0]))
+
+
+/*---- PERFECT HASH ----*/
+constexpr bool isCurrencyCode(const char *code)
+{
+    return code[0] >= 'A' && code[0] <= 'Z' && code[1] >= 'A' && code[1] <= 'Z' && code[2] >= 'A' && code[2] <= 'Z';
+}
+
+constexpr uint16_t currencyKey(const char *code)
+{
+    return (code[0] - 'A') * 676 + (code[1] - 'A') * 26 + (code[2] - 'A');
+}
+
+constexpr uint8_t currencySlotHash(uint16_t key)    { return (uint8_t) ((uint32_t) (key * 2654435761u) >> 16); }
+constexpr uint8_t currencyBucket(uint16_t key)      { return ((uint32_t) (key * 40503u) >> 8) % CURRENCY_HASH_BUCKETS; }
+
+struct CurrencyHash
+{
+    uint8_t     displacement[CURRENCY_HASH_BUCKETS];
+    uint8_t     slots[CURRENCY_HASH_SLOTS];         // Index into CURRENCY_GLYPHS, or CURRENCY_NONE
+    bool        ok;
+};
+
+// Buckets with the most codes are placed first, each at the smallest displacement that fits
+template <size_t N>
+constexpr CurrencyHash buildCurrencyHash(const CurrencyGlyph (&glyphs)[N])
+{
+    CurrencyHash hash = {};
+    uint8_t      size[CURRENCY_HASH_BUCKETS] = {};
+    uint8_t      members[CURRENCY_HASH_BUCKETS][CURRENCY_HASH_BUCKET_MAX] = {};
+
+    hash.ok = (N < CURRENCY_NONE);
+
+    for (size_t s = 0; s < CURRENCY_HASH_SLOTS; s++) hash.slots[s] = CURRENCY_NONE;
+
+    for (size_t i = 0; i < N && hash.ok; i++) {
+        hash.ok = isCurrencyCode(glyphs[i].code);
+
+        uint8_t b = currencyBucket(currencyKey(glyphs[i].code));
+        if (size[b] == CURRENCY_HASH_BUCKET_MAX) hash.ok = false;
+        else members[b][size[b]++] = i;
+    }
+
+    for (size_t want = CURRENCY_HASH_BUCKET_MAX; want > 0 && hash.ok; want--) {
+        for (size_t b = 0; b < CURRENCY_HASH_BUCKETS && hash.ok; b++) {
+            if (size[b] != want) continue;
+
+            hash.ok = false;
+            for (size_t d = 0; d < CURRENCY_HASH_SLOTS && !hash.ok; d++) {
+                uint8_t slot[CURRENCY_HASH_BUCKET_MAX] = {};
+                bool    fits = true;
+
+                // Clear of the buckets already placed, and of each other
+                for (size_t m = 0; m < want && fits; m++) {
+                    slot[m] = (currencySlotHash(currencyKey(glyphs[members[b][m]].code)) + d) % CURRENCY_HASH_SLOTS;
+                    fits    = (hash.slots[slot[m]] == CURRENCY_NONE);
+                    for (size_t n = 0; n < m && fits; n++) fits = (slot[n] != slot[m]);
+                }
+                if (!fits) continue;
+
+                for (size_t m = 0; m < want; m++) hash.slots[slot[m]] = members[b][m];
+                hash.displacement[b]    = d;
+                hash.ok                 = true;
+            }
+        }
+    }
+
+    return hash;
+}
+
+constexpr CurrencyHash CURRENCY_HASH PROGMEM = buildCurrencyHash(CURRENCY_GLYPHS);
+
+static_assert(CURRENCY_HASH.ok, "CURRENCY_GLYPHS no longer hashes perfectly, change the multipliers or CURRENCY_HASH_BUCKETS");
+
+// Index into CURRENCY_GLYPHS, or -1 if it isn't a currency we know. Case doesn't matter.
+int findCurrencyGlyph(const char *currency)
+{
+    if ( !currency || strnlen(currency, 4) != 3 ) return -1;
+
+    char code[4] = { (char) toupper(currency[0]), (char) toupper(currency[1]), (char) toupper(currency[2]), '\0' };
+    if ( !isCurrencyCode(code) ) return -1;
+
+    uint16_t key    = currencyKey(code);
+    uint8_t  slot   = (currencySlotHash(key) + pgm_read_byte(&CURRENCY_HASH.displacement[currencyBucket(key)])) % CURRENCY_HASH_SLOTS;
+    uint8_t  index  = pgm_read_byte(&CURRENCY_HASH.slots[slot]);
+
+    if ( index == CURRENCY_NONE || strncmp_P(code, CURRENCY_GLYPHS[index].code, 3) != 0 ) return -1;
+    return index;
+}
+
+// The symbol for code, into symbol. An unknown currency is shown as its code, and none at all as '$'.
+void getCurrencySymbol(const char *code, char *symbol, size_t size)
+{
+    int index = findCurrencyGlyph(code);
+
+    if (index >= 0) {
+        strncpy_P(symbol, CURRENCY_GLYPHS[index].symbol, size);
+    } else {
+        strncpy(symbol, (code && *code) ? code : "$", size);
+    }
+    symbol[size - 1] = '\0';
+}
+
+#endif
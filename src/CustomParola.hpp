@@ -41,8 +41,66 @@ void waitForZoneAnimationComplete();
 void showStartBranding();
 void printTextOrScrollLeft();
 void printPleaseWait();
+void addCurrencyGlyphs();
+void buildGlyphWidths();
+bool serviceDisplay();
 
 
+// Currency symbols the font doesn't have (refer to CurrencyGlyphs.hpp). addChar() only reaches
+// the zones begin() has set up, so call it after. Parola keeps a pointer, so the data stays in RAM.
+void addCurrencyGlyphs()
+{
+  for (uint8_t i = 0; i < CURRENCY_FONT_COUNT; i++)
+    Parola.addChar(CURRENCY_FONT_FIRST + i, currencyFontGlyphs[i]);
+}
+
+/**********************************************************************************************
+ * Text width, in display columns. The width of every character in the font is read once, after
+ * the currency glyphs are added, so measuring a string is a table lookup per character rather
+ * than a walk of the font in PROGMEM. Cheap enough to do every frame.
+ */
+uint8_t glyphWidths[256] = {0};
+
+// The columns Parola draws for c. Its user characters take the place of the font's.
+uint8_t glyphColumns(uint8_t c, uint8_t *columns, uint8_t size)
+{
+  if ( c >= CURRENCY_FONT_FIRST && c < CURRENCY_FONT_FIRST + CURRENCY_FONT_COUNT ) {
+    const uint8_t *glyph = currencyFontGlyphs[c - CURRENCY_FONT_FIRST];
+    uint8_t width = (glyph[0] < size) ? glyph[0] : size;
+    memcpy(columns, glyph + 1, width);
+    return width;
+  }
+
+  return Parola.getGraphicObject()->getChar(c, size, columns);
+}
+
+// Call after addCurrencyGlyphs() (and again after any setFont() or addChar())
+void buildGlyphWidths()
+{
+  uint8_t columns[16];
+
+  for (uint16_t c = 0; c < 256; c++)
+    glyphWidths[c] = glyphColumns(c, columns, sizeof(columns));
+}
+
+// As Parola lays it out: each character, with the zone's spacing between them
+uint16_t textColumns(const char *text)
+{
+  uint16_t columns  = 0;
+  uint8_t  spacing  = Parola.getCharSpacing(ZONE_LEFT);
+
+  for (const uint8_t *c = (const uint8_t *) text; *c; c++)
+    columns += glyphWidths[*c] + ((c == (const uint8_t *) text) ? 0 : spacing);
+
+  return columns;
+}
+
+// Whether text can be printed as it is, or has to scroll. The default is the whole display.
+bool textFits(const char *text, uint16_t columns = MAX_DEVICES * COL_SIZE)
+{
+  return textColumns(text) <= columns;
+}
+
 void setDefaultZoneSizes()
 {
   Parola.setZone(ZONE_RIGHT, 0, 0);               // Zone 0 we don't use just yet...
@@ -68,8 +126,8 @@ void waitForZoneAnimationComplete()
           webServer.handleClient();       // Handle any requests as they come.
           Portal.handleRequest();   // Need to handle AutoConnect menu.      
 
-          // Do the actual animation
-          Parola.displayAnimate();
+          // Do the actual animation, unless the display engine's timer is
+          serviceDisplay();
 
 #if defined(ESP8266)          
           yield(); // keep the watchdog fed. Removed: NOT relevant to ESP32
@@ -87,11 +145,11 @@ void printTextOrScrollLeft(const char *text, bool force_print = false, int speed
 {
     Parola.displayClear();
 
-    //Sprint("String length is: ");
-    //SprintlnDEC( strlen(text), DEC);
+    //Sprint("Text columns: ");
+    //SprintlnDEC( textColumns(text), DEC);
 
-    // message is grater than about 10 characters... will need to scroll
-    if ( strlen(text) < 14 || force_print) {
+    // Wider than the display... will need to scroll
+    if ( textFits(text) || force_print) {
       Parola.displayZoneText(ZONE_LEFT, text, PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);        
     } else {
       Parola.displayZoneText(ZONE_LEFT, text, PA_LEFT, speed, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);                    
@@ -135,7 +193,7 @@ void show_starting_greeting()
       sprintf(greeting, "Hi %s", tickerConfig.owner_name);
     }
 
-    if (strlen(greeting) > 10) {
+    if (!textFits(greeting)) {
       // To big to fit on one view
       Parola.displayZoneText(ZONE_LEFT, greeting, PA_LEFT, TICKER_SCROLL_SPEED_NORMAL, 2000, PA_SCROLL_LEFT);           
     } else {
@@ -151,4 +209,69 @@ void printPleaseWait()
   printTextOrScrollLeft("Please Wait!");
 }
 
+
+/**********************************************************************************************
+ * Display frame timing, per tick of the display engine (refer to DisplayEngine.hpp). Jitter is
+ * how far each tick is from the tick period. A deadline miss is a tick that came more than a
+ * whole frame late, so Parola couldn't move the text when it should have. Those that happen
+ * while a feed refresh is running are counted separately, to show whether the fetch gets in
+ * the way of the display ('xg' in handleSerialRead).
+ */
+struct DisplayFrameStats
+{
+    unsigned long   frames;
+    unsigned long   stalls;             // Deadline misses
+    unsigned long   fetch_frames;       // While a feed refresh was in progress
+    unsigned long   fetch_stalls;
+    unsigned long   max_gap_ms;
+    unsigned long   fetch_max_gap_ms;
+    unsigned long   jitter_sum_us;
+    unsigned long   max_jitter_us;
+
+    unsigned long   last_frame_us;
+    bool            animating;
+
+    // At each tick that animates the display
+    void frame(unsigned long now_us, unsigned long tick_us, int frame_ms, bool fetching)
+    {
+        unsigned long gap = now_us - last_frame_us;
+
+        if (animating)
+        {
+            unsigned long jitter    = (gap > tick_us) ? (gap - tick_us) : (tick_us - gap);
+            bool          stalled   = (gap > tick_us + frame_ms * 1000UL);
+
+            frames++;
+            jitter_sum_us += jitter;
+            max_jitter_us  = max(max_jitter_us, jitter);
+            max_gap_ms     = max(max_gap_ms, gap / 1000);
+            if (stalled) stalls++;
+
+            if (fetching) {
+                fetch_frames++;
+                fetch_max_gap_ms = max(fetch_max_gap_ms, gap / 1000);
+                if (stalled) fetch_stalls++;
+            }
+        }
+
+        last_frame_us   = now_us;
+        animating       = true;
+    }
+
+    // Between animations the gaps don't count
+    void idle()
+    {
+        animating = false;
+    }
+
+    void print()
+    {
+        Serial.printf_P(PSTR("Frames: %lu, deadline misses: %lu, max gap %lu ms\r\n"), frames, stalls, max_gap_ms);
+        Serial.printf_P(PSTR("Jitter: %lu us average, %lu us max\r\n"), frames ? jitter_sum_us / frames : 0, max_jitter_us);
+        Serial.printf_P(PSTR("During feed refresh: %lu frames, deadline misses: %lu, max gap %lu ms\r\n"), fetch_frames, fetch_stalls, fetch_max_gap_ms);
+    }
+};
+
+DisplayFrameStats displayFrameStats;
+
 #endif
\ No newline at end of file
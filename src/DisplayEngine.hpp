@@ -0,0 +1,138 @@
+#ifndef DISPLAY_ENGINE_H
+#define DISPLAY_ENGINE_H
+
+#if defined(ESP8266)
+  #include <Ticker.h>
+#endif
+
+/*--------------------------- DISPLAY ENGINE -----------------------------*/
+/*
+ * Runs the display's frames (Parola.displayAnimate(), or the marquee) on a tick of their own,
+ * rather than whenever loop() gets back round to them. A frame moves the text one step every
+ * parola_display_speed ms, and ticks come a few times a frame so that one is never far behind
+ * a frame that's due.
+ *
+ * On the ESP8266 the ticks come from a Ticker (an SDK timer). Its callbacks run whenever the
+ * code that's running yields, which the slow parts of loop() all do: delay(), the web server
+ * sending config.html, the feed fetch and AutoConnect. They can't land in the middle of a
+ * Parola call, as nothing in Parola yields. Elsewhere (or with DISPLAY_ENGINE_TIMER 0) service()
+ * runs the tick itself when it's due, so it needs calling often: loop(), and anywhere waiting.
+ *
+ * Each tick's timing goes to displayFrameStats ('xg' in handleSerialRead): jitter against the
+ * tick period, and deadline misses, where a whole frame went by without one.
+ */
+#ifndef DISPLAY_ENGINE_TIMER
+  #if defined(ESP8266)
+    #define DISPLAY_ENGINE_TIMER    1
+  #else
+    #define DISPLAY_ENGINE_TIMER    0
+  #endif
+#endif
+
+#define DISPLAY_TICKS_PER_FRAME     8
+#define DISPLAY_FRAME_MS_MIN        8       // SCROLL_SPEED_MS_DELAY_INSANE, and for speed 0 (print only)
+
+class DisplayEngine {
+
+    private:
+    #if DISPLAY_ENGINE_TIMER
+        Ticker          ticker;
+    #endif
+        uint16_t        frame_ms        = 0;
+        unsigned long   tick_us         = 0;
+        unsigned long   last_tick_us    = 0;
+        bool            in_tick         = false;
+
+        static void onTick(DisplayEngine *engine)
+        {
+            engine->tick();
+        }
+
+        // One pass of the display, if anything is animating
+        void tick()
+        {
+            if (in_tick) return;    // A yield in the middle of one
+            in_tick = true;
+
+            last_tick_us = micros();
+
+            if ( marquee.running() ) {
+                displayFrameStats.frame(last_tick_us, tick_us, frame_ms, fetching);
+                marquee.animate(millis());
+            } else if ( !allZoneAnimationsCompleted() ) {
+                displayFrameStats.frame(last_tick_us, tick_us, frame_ms, fetching);
+                Parola.displayAnimate();
+            } else {
+                displayFrameStats.idle();   // Between animations the gaps don't count
+            }
+
+            in_tick = false;
+        }
+
+    public:
+        bool            fetching        = false;    // A feed refresh is in progress, for the stats
+
+        void begin(int speed_ms)
+        {
+            setFramePeriod(speed_ms);
+        }
+
+        // From parola_display_speed. Only re-arms the timer if it's changed.
+        void setFramePeriod(int speed_ms)
+        {
+            uint16_t ms = (speed_ms < DISPLAY_FRAME_MS_MIN) ? DISPLAY_FRAME_MS_MIN : speed_ms;
+            if (ms == frame_ms) return;
+
+            frame_ms    = ms;
+            tick_us     = (frame_ms * 1000UL) / DISPLAY_TICKS_PER_FRAME;
+
+        #if DISPLAY_ENGINE_TIMER
+            // The Ticker only does whole ms, so that's the period the jitter is measured against
+            uint32_t tick_ms = (tick_us + 999) / 1000;
+            tick_us = tick_ms * 1000UL;
+
+            ticker.detach();
+            ticker.attach_ms(tick_ms, onTick, this);
+        #endif
+        }
+
+        uint16_t framePeriod() const    { return frame_ms; }
+
+        bool animating()
+        {
+            return marquee.running() || !allZoneAnimationsCompleted();
+        }
+
+        // Call from loop(), and while waiting on anything. Returns whether the display is still animating.
+        bool service()
+        {
+        #if !DISPLAY_ENGINE_TIMER
+            if ( (micros() - last_tick_us) >= tick_us ) tick();
+        #endif
+            return animating();
+        }
+
+        // delay(), but the display keeps going. A ms at a time otherwise, as a tick is at least that.
+        void wait(unsigned long ms)
+        {
+        #if DISPLAY_ENGINE_TIMER
+            delay(ms);
+        #else
+            unsigned long start = millis();
+            while ( (millis() - start) < ms ) {
+                service();
+                delay(1);
+            }
+        #endif
+        }
+
+}; // end DisplayEngine
+
+DisplayEngine displayEngine;
+
+bool serviceDisplay()
+{
+    return displayEngine.service();
+}
+
+#endif
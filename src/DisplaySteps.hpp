@@ -0,0 +1,115 @@
+#ifndef DISPLAY_STEPS_H
+#define DISPLAY_STEPS_H
+
+/*--------------------------- DISPLAY STATE STEPS -----------------------------*/
+/*
+ * What loop() draws for S_CRYPTO, S_COUNTDOWN and S_MESSAGE. Each call starts one Parola
+ * animation, and the display engine runs its frames. loop() decides when a state starts and
+ * ends. These are kept out of loop() so the display bench (bench/DisplayBench.cpp) draws with
+ * the same code, and its frame hashes catch any change to it.
+ *
+ * They use the globals main.ino.cpp declares before including this: Parola, parolaBuffer,
+ * parola_display_speed and parola_display_pause, tickerConfig and customMessage.
+ */
+
+/*---- TICKER ROWS (S_CRYPTO) ----*/
+// The arrow gets the right-most module to itself
+void beginTickerRows()
+{
+    Parola.setZone(ZONE_RIGHT, 0, 0);
+    Parola.setZone(ZONE_LEFT, 1, MAX_DEVICES-1);
+}
+
+void endTickerRows()
+{
+    setDefaultZoneSizes(); // back to normal
+    Parola.displayClear();
+}
+
+// Step of row: the name, the arrow, the price, then the change. False once the row has no more steps.
+bool showTickerRowStep(const TickerTable &table, size_t row, int step)
+{
+    // Price go up or down?
+    textEffect_t text_effect = table.rising(row) ? PA_SCROLL_UP : PA_SCROLL_DOWN;
+
+    switch (step)
+    {
+      case 0:
+        Parola.displayZoneText(ZONE_LEFT, table.name(row), PA_CENTER, 0, 2000, PA_RANDOM, PA_NO_EFFECT);  // Name
+        Parola.displayClear(ZONE_RIGHT); // clear the new zone
+        return true;
+
+      case 1:
+        Parola.displayZoneText(ZONE_RIGHT, table.arrow(row), PA_CENTER, parola_display_speed, 2000, text_effect, PA_NO_EFFECT);  // Arrow
+        return true;
+
+      case 2:
+        strlcpy(parolaBuffer, table.glyph(row), sizeof(parolaBuffer));
+        table.format_price(row, parolaBuffer + strlen(parolaBuffer), sizeof(parolaBuffer) - strlen(parolaBuffer));
+        Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_CENTER, parola_display_speed, 2000, text_effect, text_effect);  // Price
+        return true;
+
+      case 3:
+        table.format_percent_change(row, parolaBuffer, sizeof(parolaBuffer) - 1);
+        strcat(parolaBuffer, "%");
+        Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_CENTER, parola_display_speed, 2000, text_effect, text_effect);  // Change
+        return true;
+
+      default:
+        return false;
+    }
+}
+
+/*---- COUNTDOWN (S_COUNTDOWN) ----*/
+bool countdownValid(time_t now)
+{
+    return strlen(tickerConfig.countdown_name) >= 3 && tickerConfig.countdown_datetime >= (unsigned long) now;
+}
+
+// The title, then the time left, printed in place, until parola_display_pause has gone by
+// since the title. False once it has. step and start are the state's, and start at 0.
+bool showCountdownStep(time_t now, int &step, time_t &start)
+{
+    if (step == 0)
+    {
+        start = now;
+        snprintf_P(parolaBuffer, sizeof(parolaBuffer), "Countdown to %s \x10 \x10", tickerConfig.countdown_name);
+        printTextOrScrollLeft(parolaBuffer, false, parola_display_speed);
+        step++; // only do this once
+    }
+    else
+    {
+        // Difference from now. From DateTime.h
+        int difference  = tickerConfig.countdown_datetime - now;
+        int days        = elapsedDays(difference);
+        int hours       = numberOfHours(difference);
+        int minutes     = numberOfMinutes(difference);
+        int seconds     = numberOfSeconds(difference);
+
+        if (days > 0) {
+            snprintf_P(parolaBuffer, sizeof(parolaBuffer), "%dd %02dh %02dm", days, hours, minutes);
+        } else {
+            // TODO: https://forum.arduino.cc/index.php?topic=645252.0
+            // Fix shift of pixels due to '1' being a smaller character
+            snprintf_P(parolaBuffer, sizeof(parolaBuffer), "%02dh %02dm %02ds", hours, minutes, seconds);
+        }
+
+        Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
+        displayEngine.wait(100);
+    }
+
+    return (now - start) <= (parola_display_pause / 1000);
+}
+
+/*---- CUSTOM MESSAGE (S_MESSAGE) ----*/
+void showCustomMessage()
+{
+    // Wider than the display... will need to scroll
+    if (!textFits(customMessage.message)) {
+        Parola.displayZoneText(ZONE_LEFT, customMessage.message, PA_LEFT, SCROLL_SPEED_MS_DELAY_SLOW, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+    } else {
+        Parola.displayZoneText(ZONE_LEFT, customMessage.message, PA_CENTER, SCROLL_SPEED_MS_DELAY_SLOW, parola_display_pause, PA_PRINT);
+    }
+}
+
+#endif
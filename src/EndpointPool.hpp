@@ -0,0 +1,180 @@
+#ifndef ENDPOINT_POOL_H
+#define ENDPOINT_POOL_H
+
+#include "TickerDebug.hpp"
+
+/*--------------------------- IOT ENDPOINT POOL -----------------------------*/
+/*
+ * The IoT proxy runs on more than one host. Each request goes to whichever looks healthiest,
+ * rather than whichever one happened to answer at boot.
+ *
+ * Every response (see IoTConnection) updates a moving average of the host's response time,
+ * and of its error rate. A connection failure, timeout or 5xx is an error. The score is the
+ * response time, inflated by the error rate, and the lowest score wins.
+ *
+ * A host that fails is left alone for ENDPOINT_BACKOFF_BASE_MS, doubling with each consecutive
+ * failure (plus jitter) up to ENDPOINT_BACKOFF_MAX_MS. Once that's up, the next request probes
+ * it, and a good response brings it straight back in. A healthy host that isn't getting any
+ * traffic is also probed every ENDPOINT_PROBE_INTERVAL_MS, so its score doesn't go stale and
+ * traffic can move back to it once the other one slows down.
+ *
+ * The response time is from the request being sent until the headers are in. It leaves out
+ * the connect, so a host we've kept a socket open to isn't favoured over one we haven't.
+ */
+#define ENDPOINT_POOL_SIZE          4
+#define ENDPOINT_EWMA_WEIGHT        0.3     // Of the newest sample, so a slow host shows within a few requests
+#define ENDPOINT_ERROR_PENALTY      4.0     // A host failing every request scores 5x its response time
+#define ENDPOINT_BACKOFF_BASE_MS    (5UL * 1000)
+#define ENDPOINT_BACKOFF_MAX_MS     (5UL * 60 * 1000)
+#define ENDPOINT_PROBE_INTERVAL_MS  (2UL * 60 * 1000)
+
+struct EndpointHealth
+{
+    char            host[65];
+    float           rtt_ms;             // Moving average
+    float           error_rate;         // Moving average, 0..1
+    bool            sampled;            // rtt_ms means something
+
+    uint8_t         failures;           // Consecutive
+    unsigned long   retry_at_ms;        // Backed off until, when failures > 0
+    unsigned long   last_used_ms;
+
+    unsigned long   requests;
+    unsigned long   errors;
+
+    float score()
+    {
+        return rtt_ms * (1.0 + ENDPOINT_ERROR_PENALTY * error_rate);
+    }
+};
+
+class EndpointPool {
+
+    private:
+        EndpointHealth  hosts[ENDPOINT_POOL_SIZE];
+        int             count       = 0;
+        int             selected    = -1;   // Of the last select()
+
+        // millis() wraps after 49 days, so compare the difference rather than the values
+        static bool reached(unsigned long now, unsigned long when)
+        {
+            return (long)(now - when) >= 0;
+        }
+
+        int find(const char *host)
+        {
+            for (int i = 0; i < count; i++) {
+                if (strcmp(hosts[i].host, host) == 0) return i;
+            }
+            return -1;
+        }
+
+    public:
+        // In order of preference, for when there's nothing else to go on. Duplicates are ignored.
+        void add(const char *host)
+        {
+            if (count >= ENDPOINT_POOL_SIZE || !host[0] || find(host) >= 0) return;
+
+            EndpointHealth &endpoint = hosts[count++];
+            memset(&endpoint, 0, sizeof(EndpointHealth));
+            strlcpy(endpoint.host, host, sizeof(endpoint.host));
+        }
+
+        int size() { return count; }
+
+        // The host for the next request
+        const char* select(unsigned long now)
+        {
+            if (count == 0) return "";
+
+            int best        = -1;   // Lowest score of the healthy ones
+            int probe       = -1;   // Due a look
+            int soonest     = -1;   // Backed off, but back first
+
+            for (int i = 0; i < count; i++)
+            {
+                EndpointHealth &endpoint = hosts[i];
+
+                if (endpoint.failures > 0)
+                {
+                    if ( reached(now, endpoint.retry_at_ms) ) {
+                        if (probe == -1) probe = i;
+                    } else if ( soonest == -1 || (long)(endpoint.retry_at_ms - hosts[soonest].retry_at_ms) < 0 ) {
+                        soonest = i;
+                    }
+                    continue;
+                }
+
+                if (!endpoint.sampled) {
+                    if (probe == -1) probe = i;
+                    continue;
+                }
+
+                if (best == -1 || endpoint.score() < hosts[best].score()) best = i;
+            }
+
+            // A healthy host that hasn't had any traffic in a while
+            for (int i = 0; i < count && probe == -1 && best != -1; i++) {
+                if ( i != best && hosts[i].failures == 0 && reached(now, hosts[i].last_used_ms + ENDPOINT_PROBE_INTERVAL_MS) ) probe = i;
+            }
+
+            // Every host is backed off, so go with the one that comes back first
+            selected = (probe != -1) ? probe : ((best != -1) ? best : soonest);
+            hosts[selected].last_used_ms = now;
+
+            return hosts[selected].host;
+        }
+
+        // How a request to host went. status is an HTTP code or a negative HTTPC_ERROR_*.
+        void report(const char *host, int status, unsigned long rtt_ms, unsigned long now)
+        {
+            int i = find(host);
+            if (i < 0) return;
+
+            EndpointHealth &endpoint = hosts[i];
+            bool            ok       = (status > 0 && status < 500);
+
+            endpoint.requests++;
+            endpoint.error_rate = (1.0 - ENDPOINT_EWMA_WEIGHT) * endpoint.error_rate + (ok ? 0.0 : ENDPOINT_EWMA_WEIGHT);
+
+            if (ok)
+            {
+                endpoint.rtt_ms     = endpoint.sampled ? ((1.0 - ENDPOINT_EWMA_WEIGHT) * endpoint.rtt_ms + ENDPOINT_EWMA_WEIGHT * rtt_ms) : rtt_ms;
+                endpoint.sampled    = true;
+
+                if (endpoint.failures > 0) {
+                    Serial.printf_P(PSTR("[Endpoint] %s is back.\r\n"), endpoint.host);
+                }
+                endpoint.failures   = 0;
+                return;
+            }
+
+            endpoint.errors++;
+            if (endpoint.failures < 16) endpoint.failures++;
+
+            unsigned long backoff_ms = min(ENDPOINT_BACKOFF_BASE_MS << (endpoint.failures - 1), ENDPOINT_BACKOFF_MAX_MS);
+            endpoint.retry_at_ms = now + backoff_ms + random(backoff_ms/4 + 1);
+
+            Serial.printf_P(PSTR("[Endpoint] %s failed (%u in a row), backing off %lu s.\r\n"), endpoint.host, endpoint.failures, backoff_ms/1000);
+        }
+
+        // 'xe' in handleSerialRead
+        void print(unsigned long now)
+        {
+            Serial.println(F("Host                          RTT  Errors  Requests  Failures  Retry in"));
+
+            for (int i = 0; i < count; i++) {
+                EndpointHealth &endpoint = hosts[i];
+
+                long retry_in_s = (endpoint.failures > 0) ? (long)(endpoint.retry_at_ms - now) / 1000 : 0;
+
+                Serial.printf_P(PSTR("%-26s%c%5lums  %5u%%  %8lu  %8u  %7lds\r\n"), endpoint.host, (i == selected) ? '*' : ' ',
+                    (unsigned long) endpoint.rtt_ms, (unsigned int) (endpoint.error_rate * 100), endpoint.requests, endpoint.failures, retry_in_s);
+            }
+        }
+
+}; // end EndpointPool
+
+EndpointPool endpointPool;
+
+#endif
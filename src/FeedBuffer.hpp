@@ -0,0 +1,99 @@
+#ifndef FEED_BUFFER_H
+#define FEED_BUFFER_H
+
+#include <memory>
+#include <new>
+
+/*--------------------------- DOUBLE BUFFERED FEED DATA -----------------------------*/
+/*
+ * A feed's data is never changed in place. A processor builds the next generation into a
+ * back buffer, and it is only published (a pointer swap) once the whole response has parsed.
+ * A bad or truncated response is thrown away, and the display carries on with what it had.
+ *
+ * The display holds a reference to the generation it started showing, so its iterators (and
+ * the char pointers Parola is scrolling) stay valid until it lets go, even if a newer
+ * generation has been published in the meantime.
+ *
+ * A big generation (news) can be given slots: room for that many, allocated once at boot and
+ * recycled, as a block that size may not be found later on a fragmented heap. Three covers the
+ * front, the one the display is still holding, and the back. Otherwise each generation is
+ * allocated as it's begun. Either way, begin() returns nullptr if there's no room for one
+ * (rather than the core aborting), and the caller fails the parse.
+ */
+template <typename T>
+class FeedBuffer {
+
+    private:
+        struct Slot
+        {
+            alignas(T) uint8_t  storage[sizeof(T)];
+            bool                used    = false;
+        };
+
+        std::shared_ptr<T>  front;      // What the display sees
+        std::shared_ptr<T>  back;       // Being built
+        unsigned int        _generation = 0;
+
+        Slot                *slots      = nullptr;
+        size_t              slot_count  = 0;
+
+        // A new, empty, generation. Its slot is free again once the last holder lets it go.
+        std::shared_ptr<T> allocate()
+        {
+            if (!slots) {
+                T *data = new (std::nothrow) T();
+                return data ? std::shared_ptr<T>(data) : nullptr;
+            }
+
+            for (size_t i = 0; i < slot_count; i++)
+            {
+                Slot &slot = slots[i];
+                if (slot.used) continue;
+
+                slot.used = true;
+                return std::shared_ptr<T>(new (slot.storage) T(), [&slot](T *data) { data->~T(); slot.used = false; });
+            }
+
+            return nullptr;
+        }
+
+    public:
+        FeedBuffer(size_t _slot_count = 0)
+        {
+            if (_slot_count) {
+                slots       = new (std::nothrow) Slot[_slot_count];
+                slot_count  = slots ? _slot_count : 0;
+            }
+
+            front = allocate();
+        }
+
+        std::shared_ptr<const T> current() const    { return front; }
+        unsigned int generation() const             { return _generation; }
+
+        // Start a new, empty, back buffer. nullptr if there's no room for one.
+        T* begin()
+        {
+            back.reset();   // Its slot, if it had one, is free again
+            back = allocate();
+            return back.get();
+        }
+
+        // Swap it in. Whoever is still holding the old one keeps it until they're done.
+        void publish()
+        {
+            if (!back) return;
+
+            front = back;
+            back.reset();
+            _generation++;
+        }
+
+        void discard()
+        {
+            back.reset();
+        }
+
+}; // end FeedBuffer
+
+#endif
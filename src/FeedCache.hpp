@@ -0,0 +1,337 @@
+#ifndef FEED_CACHE_H
+#define FEED_CACHE_H
+
+#include "TickerDebug.hpp"
+#include "JsonProcessor.hpp"
+#include "FeedScheduler.hpp"
+
+extern FS*  fileSystem;
+extern bool lfs_OK;
+
+/*--------------------------- FEED CACHE -----------------------------*/
+/*
+ * The last good generation of each feed is kept on LittleFS, and loaded at boot, so there is
+ * something to show straight away rather than after the first round of requests. A restored
+ * feed is marked stale (see /feeds.json) until it has been fetched again.
+ *
+ * Files are a small header followed by any display strings (length prefixed), then the items
+ * as they are in memory. Forecasts and tickers have no strings, as they're rendered when
+ * shown. The header holds the item size, so a file written by firmware with a different
+ * struct layout is ignored rather than misread.
+ *
+ * Flash wears, so a feed is only written when a new generation has been published, and no
+ * more than once every FEED_CACHE_WRITE_INTERVAL_MS. Each poll() writes at most one file.
+ */
+#define FEED_CACHE_MAGIC                0x31434654UL    // "TFC1"
+#define FEED_CACHE_WRITE_INTERVAL_MS    (30UL * 60 * 1000)
+#define FEED_CACHE_MAX_STRING           512
+
+struct FeedCacheHeader
+{
+    uint32_t    magic;
+    uint16_t    item_size;
+    uint16_t    text_count;
+    uint16_t    item_count;
+};
+
+/*---- FILE FORMAT ----*/
+// The writes return false if they were cut short (i.e. the filesystem is full)
+bool writeFeedCacheBytes(File &file, const void *data, size_t size)
+{
+    return ( file.write((const uint8_t *) data, size) == size );
+}
+
+bool writeFeedCacheHeader(File &file, size_t item_size, size_t text_count, size_t item_count)
+{
+    FeedCacheHeader header = { FEED_CACHE_MAGIC, (uint16_t) item_size, (uint16_t) text_count, (uint16_t) item_count };
+    return writeFeedCacheBytes(file, &header, sizeof(header));
+}
+
+bool readFeedCacheHeader(File &file, size_t item_size, FeedCacheHeader &header)
+{
+    if ( file.read((uint8_t *) &header, sizeof(header)) != sizeof(header) ) return false;
+    return (header.magic == FEED_CACHE_MAGIC && header.item_size == item_size);
+}
+
+bool writeFeedCacheString(File &file, const std::string &s)
+{
+    uint16_t length = min(s.length(), (size_t) FEED_CACHE_MAX_STRING);
+    return writeFeedCacheBytes(file, &length, sizeof(length)) && writeFeedCacheBytes(file, s.data(), length);
+}
+
+bool readFeedCacheString(File &file, std::string &s)
+{
+    uint16_t length;
+    if ( file.read((uint8_t *) &length, sizeof(length)) != sizeof(length) || length > FEED_CACHE_MAX_STRING ) return false;
+
+    s.resize(length);
+    return ( file.read((uint8_t *) &s[0], length) == length );
+}
+
+bool writeFeedCacheStrings(File &file, const FeedTextStore &strings)
+{
+    for (size_t i = 0; i < strings.size(); i++) {
+        uint16_t length = min(strings.length(i), (size_t) FEED_CACHE_MAX_STRING);
+        if ( !writeFeedCacheBytes(file, &length, sizeof(length)) || !writeFeedCacheBytes(file, strings[i], length) ) return false;
+    }
+    return true;
+}
+
+// A string there's no longer room for (the file is from a build with bigger stores) is skipped
+bool readFeedCacheStrings(File &file, FeedTextStore &strings, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        uint16_t length;
+        if ( file.read((uint8_t *) &length, sizeof(length)) != sizeof(length) || length > FEED_CACHE_MAX_STRING ) return false;
+
+        char *line = strings.append(length);
+        if (!line) {
+            if ( !file.seek(length, SeekCur) ) return false;
+        } else if ( file.read((uint8_t *) line, length) != length ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Items are plain structs (char arrays, numbers), so they go as they are.
+template <typename T>
+bool readFeedCacheItem(File &file, T &item)
+{
+    return ( file.read((uint8_t *) &item, sizeof(T)) == sizeof(T) );
+}
+
+/*---- PER FEED DATA TYPE ----*/
+bool encodeFeedCache(File &file, const CurrentWeatherData &data)
+{
+    return writeFeedCacheHeader(file, sizeof(WeatherInstance), 1, 1)
+        && writeFeedCacheString(file, data.text)
+        && writeFeedCacheBytes(file, &data.weather, sizeof(WeatherInstance));
+}
+
+bool decodeFeedCache(File &file, CurrentWeatherData &data)
+{
+    FeedCacheHeader header;
+    if ( !readFeedCacheHeader(file, sizeof(WeatherInstance), header) || header.text_count != 1 || header.item_count != 1 ) return false;
+
+    return readFeedCacheString(file, data.text) && readFeedCacheItem(file, data.weather);
+}
+
+bool encodeFeedCache(File &file, const ForecastData &data)
+{
+    if ( !writeFeedCacheHeader(file, sizeof(WeatherInstance), 0, data.items.size()) ) return false;
+
+    for (const WeatherInstance &item : data.items) {
+        if ( !writeFeedCacheBytes(file, &item, sizeof(WeatherInstance)) ) return false;
+    }
+    return true;
+}
+
+bool decodeFeedCache(File &file, ForecastData &data)
+{
+    FeedCacheHeader header;
+    if ( !readFeedCacheHeader(file, sizeof(WeatherInstance), header) || header.text_count != 0 ) return false;
+
+    for (size_t i = 0; i < header.item_count; i++) {
+        data.items.emplace_back();
+        if ( !readFeedCacheItem(file, data.items.back()) ) return false;
+    }
+
+    return true;
+}
+
+// The table is plain data, refer to TickerTable.hpp
+bool encodeFeedCache(File &file, const TickerData &data)
+{
+    return writeFeedCacheHeader(file, sizeof(TickerTable), 0, data.size())
+        && writeFeedCacheBytes(file, &data, sizeof(TickerTable));
+}
+
+bool decodeFeedCache(File &file, TickerData &data)
+{
+    FeedCacheHeader header;
+    if ( !readFeedCacheHeader(file, sizeof(TickerTable), header) || header.text_count != 0 ) return false;
+
+    // Offsets from flash are only used once they're known to be inside the pool
+    return readFeedCacheItem(file, data) && data.valid() && data.size() == header.item_count;
+}
+
+bool encodeFeedCache(File &file, const HeadlineData &data)
+{
+    return writeFeedCacheHeader(file, 0, data.size(), 0) && writeFeedCacheStrings(file, data);
+}
+
+bool decodeFeedCache(File &file, HeadlineData &data)
+{
+    FeedCacheHeader header;
+    if ( !readFeedCacheHeader(file, 0, header) ) return false;
+
+    return readFeedCacheStrings(file, data, header.text_count);
+}
+
+bool feedIsEmpty(const CurrentWeatherData &data)    { return data.text.empty(); }
+bool feedIsEmpty(const ForecastData &data)          { return data.items.empty(); }
+bool feedIsEmpty(const TickerData &data)            { return data.empty(); }
+bool feedIsEmpty(const HeadlineData &data)          { return data.empty(); }
+
+/*---- CACHED FEEDS ----*/
+class FeedCacheSlot {
+
+    protected:
+        const char      *path;
+        int             feed;                       // FeedId, to mark it stale
+        unsigned int    saved_generation    = 0;
+        unsigned long   saved_ms            = 0;
+        bool            saved               = false;
+        unsigned long   failed_ms           = 0;    // Last save that didn't make it
+        bool            failed              = false;
+
+        bool save_failed(unsigned long now)
+        {
+            failed      = true;
+            failed_ms   = now;
+            return false;
+        }
+
+    public:
+        FeedCacheSlot(const char *_path, int _feed) : path(_path), feed(_feed) { }
+
+        virtual unsigned int generation() = 0;
+        virtual bool empty() = 0;
+        virtual bool encode(File &file) = 0;    // False if it didn't all get written
+        virtual bool decode(File &file) = 0;    // Publishes it, if it's good
+
+        bool save_due(unsigned long now)
+        {
+            if ( generation() == saved_generation || empty() ) return false;
+            if ( failed && (now - failed_ms) < FEED_CACHE_WRITE_INTERVAL_MS ) return false;     // Not every poll, with the filesystem full
+            return !saved || (now - saved_ms) >= FEED_CACHE_WRITE_INTERVAL_MS;
+        }
+
+        // Written to a temporary file first, so a reset half way through doesn't leave a broken one.
+        // Nor does a full filesystem: a short write leaves the last good file where it was.
+        bool save(unsigned long now)
+        {
+            String tmp_path = String(path) + ".tmp";
+
+            File file = fileSystem->open(tmp_path, "w");
+            if (!file) return save_failed(now);
+
+            bool written = encode(file);
+            file.close();
+
+            if (!written) {
+                Sprint(F("[Cache] Short write, keeping the old ")); Sprintln(path);
+                fileSystem->remove(tmp_path);
+                return save_failed(now);
+            }
+
+            fileSystem->remove(path);
+            if ( !fileSystem->rename(tmp_path, path) ) {
+                Sprint(F("[Cache] Couldn't rename to ")); Sprintln(path);
+                return save_failed(now);
+            }
+
+            saved_generation    = generation();
+            saved_ms            = now;
+            saved               = true;
+            failed              = false;
+
+            Sprint(F("[Cache] Saved ")); Sprintln(path);
+            return true;
+        }
+
+        bool restore(unsigned long now)
+        {
+            if ( !fileSystem->exists(path) ) return false;
+
+            File file   = fileSystem->open(path, "r");
+            bool ok     = file && decode(file);
+            file.close();
+
+            if (!ok) {
+                Sprint(F("[Cache] Ignoring unreadable ")); Sprintln(path);
+                return false;
+            }
+
+            // Nothing new to write until it's been fetched again
+            saved_generation    = generation();
+            saved_ms            = now;
+            saved               = true;
+
+            feedScheduler.get(feed).stale = true;
+            return true;
+        }
+};
+
+template <typename T>
+class FeedCacheEntry : public FeedCacheSlot {
+
+    private:
+        FeedBuffer<T>   &buffer;
+
+    public:
+        FeedCacheEntry(const char *_path, int _feed, FeedBuffer<T> &_buffer) : FeedCacheSlot(_path, _feed), buffer(_buffer) { }
+
+        unsigned int generation()   { return buffer.generation(); }
+        bool empty()                { return feedIsEmpty(*buffer.current()); }
+        bool encode(File &file)     { return encodeFeedCache(file, *buffer.current()); }
+
+        bool decode(File &file)
+        {
+            T *data = buffer.begin();
+
+            if ( data && decodeFeedCache(file, *data) ) {
+                buffer.publish();
+                return true;
+            }
+
+            buffer.discard();
+            return false;
+        }
+};
+
+class FeedCache {
+
+    private:
+        FeedCacheEntry<CurrentWeatherData>  weather     { "/cache/weather.bin",     FEED_WEATHER,           CurrentWeatherFeed };
+        FeedCacheEntry<ForecastData>        forecast    { "/cache/forecast.bin",    FEED_WEATHER_FORECAST,  WeatherForecastFeed };
+        FeedCacheEntry<TickerData>          crypto      { "/cache/crypto.bin",      FEED_TICKER,            CryptoFeed };
+        FeedCacheEntry<TickerData>          stocks      { "/cache/stocks.bin",      FEED_STOCK,             EquitiesFeed };
+        FeedCacheEntry<HeadlineData>        news        { "/cache/news.bin",        FEED_NEWS,              NewsFeed };
+
+        FeedCacheSlot   *slots[5] = { &weather, &forecast, &crypto, &stocks, &news };
+
+    public:
+        // At boot, before anything has been fetched. Returns how many feeds were restored.
+        int restore()
+        {
+            if (!lfs_OK) return 0;
+
+            int restored = 0;
+            for (FeedCacheSlot *slot : slots) {
+                if ( slot->restore(millis()) ) restored++;
+            }
+
+            Sprint(F("[Cache] Feeds restored: ")); Sprintln(restored);
+            return restored;
+        }
+
+        // Write (at most) one feed that has changed, if it's been long enough since it was last written
+        void poll(unsigned long now)
+        {
+            if (!lfs_OK) return;
+
+            for (FeedCacheSlot *slot : slots) {
+                if ( slot->save_due(now) ) {
+                    slot->save(now);
+                    return;
+                }
+            }
+        }
+
+}; // end FeedCache
+
+FeedCache feedCache;
+
+#endif
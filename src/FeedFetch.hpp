@@ -0,0 +1,402 @@
+#ifndef FEED_FETCH_H
+#define FEED_FETCH_H
+
+#include "TickerDebug.hpp"
+#include "JsonStreamParser.hpp"
+#include "MsgPackStreamParser.hpp"
+#include "ConditionalGet.hpp"
+#include "IoTConnection.hpp"
+#include "FeedReplay.hpp"
+#include "FeedScheduler.hpp"
+
+extern String getIoTRequestPath(const String& action_str, const String& params_str); // defined in the main .cpp file
+
+/*--------------------------- NON-BLOCKING FEED FETCH -----------------------------*/
+/*
+ * A feed refresh that runs alongside the display rather than instead of it. poll() is called
+ * once per loop() and does a few milliseconds of work: a step of the request (see
+ * IoTConnection), or whatever part of the response body has arrived, which is fed straight
+ * into the streaming parser. It returns as soon as it would have to wait on the network.
+ *
+ * A fetch is a list of sections, one per processor. In bundle mode they all go in one
+ * action=bundle request. Otherwise each section is a request of its own, one after the other.
+ * The processors have to outlive the fetch, so they belong to the caller.
+ */
+#define FEED_FETCH_MAX_SECTIONS 8
+#define FEED_FETCH_BUDGET_MS    4       // Per loop(), well inside a scroll frame
+
+struct FeedFetchPart
+{
+    const char          *action;        // For a request of its own, i.e. "time" for section "time_2"
+    String              params;         // ... and its query parameters
+    String              bundle_params;  // Query parameters in a bundle, where some would clash
+    int                 feed;           // FeedId, for the scheduler
+    ConditionalGetEntry *validator;
+
+    unsigned long       latency_ms;     // Request start until parsed
+    int                 error;          // FEED_ERROR_*, for the feed's health
+};
+
+class FeedFetch {
+
+    private:
+        enum FetchState { FETCH_IDLE, FETCH_START, FETCH_HEADERS, FETCH_BODY, FETCH_NEXT, FETCH_DONE };
+
+        FetchState          state           = FETCH_IDLE;
+        bool                bundle          = false;
+        size_t              current         = 0;        // Section being requested, when not bundled
+
+        String              bundle_query;               // Without the etags
+        FeedStreamer        *bundle_streamer = nullptr;    // JSON or MessagePack, whichever the proxy sent
+        ItemStreamer        *item_streamer   = nullptr;
+        StaticJsonDocument<256> filter;
+
+        FeedTransport       *transport      = nullptr;  // Of the request in progress, see FeedReplay.hpp
+        bool                inflate_retried = false;    // This request has already been made again uncompressed
+        unsigned long       last_byte_ms    = 0;
+        unsigned long       request_start_ms = 0;
+
+        // Feed whatever of the body has arrived to the streamer, for up to budget_ms. True once
+        // the document has ended, or we've given up waiting for the rest of it.
+        bool pump(FeedStreamer &streamer, unsigned long budget_ms)
+        {
+            Stream          &stream     = transport->stream();
+            char            chunk[64];
+            unsigned long   pump_start  = millis();
+
+            while (!streamer.done())
+            {
+                int available = stream.available();
+
+                if (available <= 0)
+                {
+                    if ( transport->body_failed() ) {
+                        Sprintln(F("[JSON] Response body couldn't be decoded."));
+                        return true;
+                    }
+
+                    if ( (millis() - last_byte_ms) > IOT_RESPONSE_TIMEOUT_MS ) {
+                        Sprintln(F("[JSON] Stream timed out before the document ended."));
+                        return true;
+                    }
+                    return false; // Come back next loop()
+                }
+
+                size_t length = stream.readBytes(chunk, min(available, (int) sizeof(chunk)));
+                feedStreamer(streamer, chunk, length);
+                last_byte_ms = millis();
+
+                if ( (millis() - pump_start) >= budget_ms ) break;
+            }
+
+            return streamer.done();
+        }
+
+        // The outcome of a section, for the scheduler
+        void record(size_t i, int error)
+        {
+            parts[i].latency_ms = millis() - request_start_ms;
+            parts[i].error      = error;
+        }
+
+        void start_request()
+        {
+            request_start_ms = millis();
+            transport        = feedTransport;
+
+            if (bundle)
+            {
+                String etags;
+                for (size_t i = 0; i < section_count; i++) {
+                    ConditionalGetEntry *validator = parts[i].validator;
+                    if ( validator && validator->has_validator() && validator->etag[0] ) {
+                        etags += "&etag_" + String(sections[i].name) + "=" + urlEncode(validator->etag);
+                    }
+                }
+
+                transport->begin(endpointPool.select(millis()), getIoTRequestPath("bundle", bundle_query + etags));
+            }
+            else
+            {
+                FeedFetchPart &part = parts[current];
+                transport->begin(endpointPool.select(millis()), getIoTRequestPath(part.action, part.params), part.validator);
+            }
+
+            state = FETCH_HEADERS;
+        }
+
+        void headers_received()
+        {
+            http_code = transport->status();
+
+            if (bundle)
+            {
+                if (http_code != HTTP_CODE_OK) {
+                    Serial.printf("[HTTP] GET... failed, error: %s \r\n", HTTPClient::errorToString(http_code).c_str());
+                    for (size_t i = 0; i < section_count; i++) record(i, http_code);
+                    transport->end();
+                    transport->record_telemetry("bundle", 0);
+                    state = FETCH_DONE;
+                    return;
+                }
+
+                bundle_streamer = newBundleStreamer(transport->msgpack_response, sections, section_count);
+                last_byte_ms    = millis();
+                state           = FETCH_BODY;
+                return;
+            }
+
+            JsonBundleSection   &section    = sections[current];
+            FeedFetchPart       &part       = parts[current];
+
+            if (http_code == HTTP_CODE_NOT_MODIFIED && part.validator)
+            {
+                Sprint(F("Not modified. Keeping what we have: ")); Sprintln(section.name);
+                part.validator->hits++;
+
+                section.received        = true;
+                section.result          = true;
+                section.not_modified    = true;
+                record(current, FEED_ERROR_NONE);
+
+                transport->end();
+                transport->record_telemetry(section.name, 0);
+                state = FETCH_NEXT;
+                return;
+            }
+
+            if (http_code != HTTP_CODE_OK)
+            {
+                Serial.printf("[HTTP] GET... failed, error: %s \r\n", HTTPClient::errorToString(http_code).c_str());
+                record(current, http_code);
+                transport->end();
+                transport->record_telemetry(section.name, 0);
+                state = FETCH_NEXT;
+                return;
+            }
+
+            if (part.validator) part.validator->misses++;
+
+            filter.clear();
+            section.processor->build_filter(filter);
+
+            item_streamer   = newItemStreamer(transport->msgpack_response, *section.processor, getItemFilter(filter));
+            last_byte_ms    = millis();
+            state           = FETCH_BODY;
+        }
+
+        // It didn't inflate (refer to InflateStream.hpp), and compression is off now. The same
+        // request again, once, without it.
+        bool retry_uncompressed()
+        {
+            if ( !transport->body_failed() || inflate_retried ) return false;
+
+            Sprintln(F("[HTTP] Requesting it again, uncompressed."));
+
+            if (item_streamer) item_streamer->finish();     // Discards what the processor had so far
+            delete item_streamer;
+            delete bundle_streamer;
+            item_streamer   = nullptr;
+            bundle_streamer = nullptr;
+
+            transport->end();
+            transport->record_telemetry(bundle ? "bundle" : sections[current].name, 0);
+
+            inflate_retried = true;
+            state           = FETCH_START;
+            return true;
+        }
+
+        void body_received()
+        {
+            if ( retry_uncompressed() ) return;
+
+            if (bundle)
+            {
+                recordFeedFormatUsage("bundle", transport->msgpack_response, bundle_streamer->bytes, bundle_streamer->parse_us);
+
+                bundle_completed = bundle_streamer->ok();
+
+                bool parsed = bundle_completed;
+                for (size_t i = 0; i < section_count; i++) {
+                    if (sections[i].received && !sections[i].result) parsed = false;
+                }
+                if (parsed) transport->body_parsed();
+
+                unsigned long parse_us = bundle_streamer->parse_us;
+                delete bundle_streamer;
+                bundle_streamer = nullptr;
+
+                transport->end();
+                transport->record_telemetry("bundle", parse_us);
+
+                for (size_t i = 0; i < section_count; i++)
+                {
+                    JsonBundleSection   &section    = sections[i];
+                    ConditionalGetEntry *validator  = parts[i].validator;
+
+                    if (section.received) received++;
+                    record(i, !section.received ? FEED_ERROR_MISSING : (section.result ? FEED_ERROR_NONE : FEED_ERROR_PARSE));
+
+                    if (!validator || !section.received) continue;
+
+                    if (section.not_modified) {
+                        Sprint(F("Not modified. Keeping what we have: ")); Sprintln(section.name);
+                        validator->hits++;
+                    } else {
+                        validator->misses++;
+                        conditionalGets.store(validator, section.result ? section.etag : "", "");
+                    }
+                }
+
+                Sprint(F("Bundle sections received: ")); Sprintln(received);
+                state = FETCH_DONE;
+                return;
+            }
+
+            JsonBundleSection   &section    = sections[current];
+            FeedFetchPart       &part       = parts[current];
+
+            section.received        = true;
+            section.result          = item_streamer->finish();
+            section.not_modified    = item_streamer->not_modified;
+            record(current, section.result ? FEED_ERROR_NONE : FEED_ERROR_PARSE);
+
+            recordFeedDocumentUsage(section.name, item_streamer->capacity(), item_streamer->peak_usage());
+            recordFeedFormatUsage(section.name, transport->msgpack_response, item_streamer->bytes, item_streamer->parse_us);
+
+            // Only remember validators for what we actually managed to parse
+            if (part.validator) {
+                conditionalGets.store(part.validator, section.result ? transport->etag : "", section.result ? transport->last_modified : "");
+            }
+
+            if (section.result) transport->body_parsed();
+
+            unsigned long parse_us = item_streamer->parse_us;
+            delete item_streamer;
+            item_streamer = nullptr;
+
+            transport->end();
+            transport->record_telemetry(section.name, parse_us);
+
+            if (section.received) received++;
+            state = FETCH_NEXT;
+        }
+
+    public:
+        JsonBundleSection   sections[FEED_FETCH_MAX_SECTIONS];
+        FeedFetchPart       parts[FEED_FETCH_MAX_SECTIONS];
+        size_t              section_count   = 0;
+
+        int                 http_code       = 0;    // Of the last request
+        int                 received        = 0;    // Sections that came back, 304 or not
+        bool                bundle_completed = false;   // The bundle document parsed to its end
+
+        ~FeedFetch()
+        {
+            delete bundle_streamer;
+            delete item_streamer;
+        }
+
+        // Forget the last fetch
+        void clear()
+        {
+            section_count   = 0;
+            state           = FETCH_IDLE;
+        }
+
+        void add(const char *name, const char *action, JsonProcessor *processor, int feed, const String &params, const String &bundle_params)
+        {
+            if (section_count >= FEED_FETCH_MAX_SECTIONS) return;
+
+            sections[section_count] = { name, processor, false, false };
+            parts[section_count]    = { action, params, bundle_params, feed, nullptr, 0, FEED_ERROR_NONE };
+            section_count++;
+        }
+
+        void start(bool bundle_mode)
+        {
+            bundle          = bundle_mode;
+            current         = 0;
+            received        = 0;
+            http_code       = 0;
+            bundle_completed = false;
+            inflate_retried = false;
+
+            for (size_t i = 0; i < section_count; i++) {
+                sections[i].received        = false;
+                sections[i].result          = false;
+                sections[i].not_modified    = false;
+                sections[i].etag[0]         = '\0';
+                parts[i].latency_ms         = 0;
+                parts[i].error              = FEED_ERROR_MISSING;   // Until we hear otherwise
+            }
+
+            if (bundle)
+            {
+                String names, params;
+                for (size_t i = 0; i < section_count; i++) {
+                    if (i > 0) names += ",";
+                    names += sections[i].name;
+
+                    // Weather and forecast share theirs
+                    if ( params.indexOf("&" + parts[i].bundle_params) == -1 ) params += "&" + parts[i].bundle_params;
+                }
+                bundle_query = "sections=" + names + params;
+            }
+
+            // Sections we have a validator for can come back as a 304. Any change of config (i.e. the
+            // query) invalidates them.
+            for (size_t i = 0; i < section_count; i++) {
+                parts[i].validator = sections[i].processor->conditional_get() ? conditionalGets.find(sections[i].name, bundle ? bundle_query : parts[i].params) : nullptr;
+            }
+
+            state = (section_count > 0) ? FETCH_START : FETCH_DONE;
+        }
+
+        bool busy()         { return (state != FETCH_IDLE && state != FETCH_DONE); }
+        bool done()         { return (state == FETCH_DONE); }
+        bool is_bundle()    { return bundle; }
+
+        // A little more of the fetch, for up to about budget_ms.
+        void poll(unsigned long budget_ms)
+        {
+            switch (state)
+            {
+                case FETCH_START:
+                    start_request();
+                    break;
+
+                case FETCH_HEADERS:
+                    if ( !transport->poll(budget_ms) ) headers_received();
+                    break;
+
+                case FETCH_BODY:
+                    if ( bundle ? pump(*bundle_streamer, budget_ms) : pump(*item_streamer, budget_ms) ) body_received();
+                    break;
+
+                case FETCH_NEXT:
+                    inflate_retried = false;
+                    current++;
+                    state = (current < section_count) ? FETCH_START : FETCH_DONE;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        // All of it now, for when there's nothing else to do.
+        void run()
+        {
+            while ( busy() ) {
+                poll(IOT_RESPONSE_TIMEOUT_MS);
+                yield();
+            }
+        }
+
+}; // end FeedFetch
+
+FeedFetch feedFetch;
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef FEED_RENDER_H
+#define FEED_RENDER_H
+
+#include <iterator>
+#include "JsonProcessor.hpp"
+
+extern TimeLib2 clockMain;
+
+/*--------------------------- FEED RENDERING -----------------------------*/
+/*
+ * The processors keep each feed as typed data (refer to JsonProcessor.hpp), and it's only made
+ * into text a line at a time, as displayStringList() is about to show it. Headlines are already
+ * text, so they're shown from where they're stored. Anything else is formatted into buffer,
+ * which has to stay as it is until Parola has finished with the line.
+ *
+ * As it's done at display time, "Tomorrow" is tomorrow when it's shown, not when it was fetched.
+ */
+size_t feedLineCount(const HeadlineData &data)  { return data.size(); }
+size_t feedLineCount(const ForecastData &data)  { return data.items.size(); }
+size_t feedLineCount(const TickerData &data)    { return data.size(); }
+
+const char* feedLine(const HeadlineData &data, size_t row, char *buffer, size_t size)
+{
+    return data[row];
+}
+
+const char* feedLine(const ForecastData &data, size_t row, char *buffer, size_t size)
+{
+    const WeatherInstance &weather = *std::next(data.items.begin(), row);
+
+    if ( (clockMain.day() + 1) == clockMain.day(weather.datetime_tzadjusted) ) { // is the forecast for tomorrow?
+        snprintf_P(buffer, size, PSTR("Tomorrow \x10 %s and %d\xB0."), weather.description, weather.temp_now);
+    } else {
+        snprintf_P(buffer, size, PSTR("%s \x10 %s and %d\xB0."), dayStr(clockMain.weekday(weather.datetime_tzadjusted)), weather.description, weather.temp_now);
+    }
+    return buffer;
+}
+
+const char* feedLine(const TickerData &data, size_t row, char *buffer, size_t size)
+{
+    char price[24], percent_change[16];
+    data.format_price(row, price, sizeof(price));
+    data.format_percent_change(row, percent_change, sizeof(percent_change));
+
+    // Refer to https://github.com/MajicDesigns/MD_MAX72XX/blob/main/src/MD_MAX72xx_font.cpp for the hex values
+    // Currently use bullet point then right arrow.
+    snprintf_P(buffer, size, PSTR("\x7 %s \x16 %s%s  %s  %s%%"), data.name(row), data.glyph(row), price, data.arrow(row), percent_change);
+    return buffer;
+}
+
+#endif
@@ -0,0 +1,387 @@
+#ifndef FEED_REPLAY_H
+#define FEED_REPLAY_H
+
+#include "TickerDebug.hpp"
+#include "FeedTransport.hpp"
+#include "IoTConnection.hpp"
+
+extern FS*  fileSystem;
+extern bool lfs_OK;
+
+/*--------------------------- RECORD / REPLAY TRANSPORTS -----------------------------*/
+/*
+ * In record mode, each 200 response from the IoT proxy is saved to LittleFS as it's parsed,
+ * keyed by its request path. It's only kept once all of it has parsed (body_parsed()), so a
+ * response cut short, or one that didn't inflate, never replaces a good recording. In replay
+ * mode, those are served back instead, and the network isn't touched. A replay waits
+ * FEED_REPLAY_LATENCY_MS before the "headers" are in, and then lets the body through at no
+ * more than FEED_REPLAY_BYTES_PER_S, so a slow link can be reproduced the same way every time.
+ * With the WiFi down too, if need be: a build with FEED_TRANSPORT_MODE replay doesn't wait in
+ * Portal.begin() for it, refer to setup().
+ *
+ * What's saved is the body as the parser saw it, so already de-chunked and inflated. Anything
+ * after the end of the document isn't. The etags a bundle request carries are left out of the
+ * key (see feedRecordingKey()), and replayed requests are never conditional, so every replay
+ * gets the whole document.
+ *
+ * Switch with 'xn', which goes live -> record -> replay -> live.
+ */
+#define FEED_TRANSPORT_LIVE         0
+#define FEED_TRANSPORT_RECORD       1
+#define FEED_TRANSPORT_REPLAY       2
+
+#define FEED_RECORDING_MAGIC        0x31524654UL    // "TFR1"
+#define FEED_RECORDING_DIR          "/replay/"
+
+#ifndef FEED_REPLAY_LATENCY_MS
+  #define FEED_REPLAY_LATENCY_MS    200
+#endif
+#ifndef FEED_REPLAY_BYTES_PER_S
+  #define FEED_REPLAY_BYTES_PER_S   4096            // 0 for as fast as the file can be read
+#endif
+
+struct FeedRecordingHeader
+{
+    uint32_t    magic;
+    int16_t     status;
+    uint8_t     msgpack;
+    uint8_t     reserved;
+    char        etag[48];
+    char        last_modified[32];
+    uint32_t    key_hash;                           // Of the whole key, to tell a collision
+};
+
+// FNV-1a, of the request path up to any bundle etags
+uint32_t feedRecordingKey(const String &path)
+{
+    int end = path.indexOf("&etag_");
+    if (end < 0) end = path.length();
+
+    uint32_t hash = 2166136261UL;
+    for (int i = 0; i < end; i++) {
+        hash = (hash ^ (uint8_t) path[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+String feedRecordingPath(uint32_t key)
+{
+    char path[32];
+    snprintf_P(path, sizeof(path), PSTR(FEED_RECORDING_DIR "%08lx.bin"), (unsigned long) key);
+    return String(path);
+}
+
+
+/*---- RECORD ----*/
+// Everything read from source is also written to file
+class TeeStream : public Stream {
+
+    private:
+        Stream  *source = nullptr;
+        File    *file   = nullptr;
+
+    public:
+        void begin(Stream &_source, File &_file)
+        {
+            source  = &_source;
+            file    = &_file;
+        }
+
+        int available() { return source->available(); }
+        int peek()      { return source->peek(); }
+
+        int read()
+        {
+            int c = source->read();
+            if (c >= 0) file->write((uint8_t) c);
+            return c;
+        }
+
+        size_t readBytes(char *buffer, size_t length)
+        {
+            size_t n = source->readBytes(buffer, length);
+            file->write((const uint8_t *) buffer, n);
+            return n;
+        }
+
+        size_t write(uint8_t) { return 0; }
+
+}; // end TeeStream
+
+class FeedRecorder : public FeedTransport {
+
+    private:
+        FeedTransport   &live;
+        TeeStream       tee;
+        File            file;
+        bool            recording   = false;
+        bool            headers_in  = false;
+        bool            parsed      = false;
+        uint32_t        key         = 0;
+
+        void start_recording()
+        {
+            if (!lfs_OK || live.status() != HTTP_CODE_OK) return;
+
+            file = fileSystem->open(feedRecordingPath(key) + ".tmp", "w");
+            if (!file) return;
+
+            FeedRecordingHeader header;
+            memset(&header, 0, sizeof(header));
+            header.magic    = FEED_RECORDING_MAGIC;
+            header.status   = live.status();
+            header.msgpack  = live.msgpack_response;
+            header.key_hash = key;
+            strlcpy(header.etag,          live.etag,          sizeof(header.etag));
+            strlcpy(header.last_modified, live.last_modified, sizeof(header.last_modified));
+
+            file.write((const uint8_t *) &header, sizeof(header));
+            tee.begin(live.stream(), file);
+            recording = true;
+        }
+
+    public:
+        unsigned long   recordings  = 0;
+
+        FeedRecorder(FeedTransport &_live) : live(_live) { }
+
+        void begin(const char *host, const String &path, ConditionalGetEntry *validator = nullptr)
+        {
+            if (recording) file.close();    // Left over from a mode switch mid request
+
+            key         = feedRecordingKey(path);
+            recording   = false;
+            headers_in  = false;
+            parsed      = false;
+
+            // Unconditional, so there's a whole body to record
+            int etags = path.indexOf("&etag_");
+            live.begin(host, (etags < 0) ? path : path.substring(0, etags), nullptr);
+        }
+
+        bool poll(unsigned long budget_ms)
+        {
+            if ( live.poll(budget_ms) ) return true;
+
+            if (!headers_in) {
+                headers_in          = true;
+                msgpack_response    = live.msgpack_response;
+                strlcpy(etag,          live.etag,          sizeof(etag));
+                strlcpy(last_modified, live.last_modified, sizeof(last_modified));
+                start_recording();
+            }
+            return false;
+        }
+
+        int status()        { return live.status(); }
+        Stream& stream()    { return recording ? (Stream&) tee : live.stream(); }
+        bool body_failed()  { return live.body_failed(); }
+        void body_parsed()  { parsed = true; }
+
+        void end()
+        {
+            bool complete = parsed && !live.body_failed();
+            live.end();
+
+            if (!recording) return;
+            recording = false;
+
+            file.close();
+
+            String path = feedRecordingPath(key);
+            if (!complete) {
+                fileSystem->remove(path + ".tmp");
+                Sprint(F("[Replay] Not recorded, the response didn't parse: ")); Sprintln(path);
+                return;
+            }
+
+            fileSystem->remove(path);
+            fileSystem->rename(path + ".tmp", path);
+
+            recordings++;
+            Sprint(F("[Replay] Recorded ")); Sprintln(path);
+        }
+
+        // The live connection timed it
+        void record_telemetry(const char *action, unsigned long parse_us)
+        {
+            live.record_telemetry(action, parse_us);
+        }
+
+}; // end FeedRecorder
+
+
+/*---- REPLAY ----*/
+// A file, let through no faster than bytes_per_s
+class ThrottledStream : public Stream {
+
+    private:
+        File            *file       = nullptr;
+        uint32_t        bytes_per_s = 0;
+        unsigned long   start_ms    = 0;
+
+        int allowed()
+        {
+            int left = file->available();
+            if (bytes_per_s == 0) return left;
+
+            uint64_t budget = ((uint64_t) (millis() - start_ms) * bytes_per_s) / 1000;
+            return (budget > bytes_read) ? min((uint64_t) left, budget - bytes_read) : 0;
+        }
+
+    public:
+        unsigned long   bytes_read  = 0;
+
+        void begin(File &_file, uint32_t _bytes_per_s)
+        {
+            file        = &_file;
+            bytes_per_s = _bytes_per_s;
+            start_ms    = millis();
+            bytes_read  = 0;
+        }
+
+        int available() { return allowed(); }
+        int peek()      { return (allowed() > 0) ? file->peek() : -1; }
+
+        int read()
+        {
+            if (allowed() <= 0) return -1;
+
+            bytes_read++;
+            return file->read();
+        }
+
+        size_t readBytes(char *buffer, size_t length)
+        {
+            size_t n = file->readBytes(buffer, min(length, (size_t) max(allowed(), 0)));
+            bytes_read += n;
+            return n;
+        }
+
+        size_t write(uint8_t) { return 0; }
+
+}; // end ThrottledStream
+
+class FeedReplayer : public FeedTransport {
+
+    private:
+        File            file;
+        ThrottledStream body;
+        int             status_code = 0;
+        bool            waiting     = false;
+        unsigned long   start_ms    = 0;
+
+        bool open(const String &path)
+        {
+            uint32_t key = feedRecordingKey(path);
+            String   file_path = feedRecordingPath(key);
+
+            if ( !lfs_OK || !fileSystem->exists(file_path) ) return false;
+
+            file = fileSystem->open(file_path, "r");
+
+            FeedRecordingHeader header;
+            if ( !file || file.read((uint8_t *) &header, sizeof(header)) != sizeof(header) ||
+                 header.magic != FEED_RECORDING_MAGIC || header.key_hash != key ) {
+                file.close();
+                return false;
+            }
+
+            status_code         = header.status;
+            msgpack_response    = header.msgpack;
+            strlcpy(etag,          header.etag,          sizeof(etag));
+            strlcpy(last_modified, header.last_modified, sizeof(last_modified));
+            return true;
+        }
+
+    public:
+        unsigned long   latency_ms  = FEED_REPLAY_LATENCY_MS;
+        uint32_t        bytes_per_s = FEED_REPLAY_BYTES_PER_S;
+
+        unsigned long   replays     = 0;
+        unsigned long   misses      = 0;    // Requests there was no recording of
+
+        void begin(const char *host, const String &path, ConditionalGetEntry *validator = nullptr)
+        {
+            if (file) file.close();
+
+            Sprint(F("> Replaying: ")); Sprintln(path);
+            begin_telemetry();
+
+            msgpack_response    = false;
+            etag[0]             = '\0';
+            last_modified[0]    = '\0';
+
+            if ( open(path) ) {
+                replays++;
+            } else {
+                Sprintln(F("[Replay] Nothing recorded."));
+                status_code = HTTP_CODE_NOT_FOUND;
+                misses++;
+            }
+
+            start_ms    = millis();
+            waiting     = true;
+        }
+
+        bool poll(unsigned long budget_ms)
+        {
+            if (!waiting) return false;
+            if ( (millis() - start_ms) < latency_ms ) return true;
+
+            waiting             = false;
+            first_byte_ms       = millis();
+            telemetry.ttfb_ms   = first_byte_ms - start_ms;
+
+            if (file) body.begin(file, bytes_per_s);
+            return false;
+        }
+
+        int status()        { return status_code; }
+        Stream& stream()    { return body; }
+
+        void end()
+        {
+            end_ms          = millis();
+            telemetry.bytes = file ? body.bytes_read : 0;
+            waiting         = false;
+
+            if (file) file.close();
+        }
+
+        void print()
+        {
+            Serial.printf_P(PSTR("Replay: %lu ms latency, %lu bytes/s, %lu replayed, %lu not recorded\r\n"),
+                latency_ms, (unsigned long) bytes_per_s, replays, misses);
+        }
+
+}; // end FeedReplayer
+
+
+/*---- SELECTION ----*/
+FeedRecorder    feedRecorder(iotConnection);
+FeedReplayer    feedReplayer;
+
+int             feedTransportMode   = FEED_TRANSPORT_LIVE;
+FeedTransport   *feedTransport      = &iotConnection;
+
+void setFeedTransportMode(int mode)
+{
+    feedTransportMode = mode;
+
+    switch (mode)
+    {
+        case FEED_TRANSPORT_RECORD: feedTransport = &feedRecorder;  break;
+        case FEED_TRANSPORT_REPLAY: feedTransport = &feedReplayer;  break;
+        default:                    feedTransport = &iotConnection; feedTransportMode = FEED_TRANSPORT_LIVE; break;
+    }
+
+    if (lfs_OK && mode != FEED_TRANSPORT_LIVE) fileSystem->mkdir(FEED_RECORDING_DIR);
+
+    Serial.print(F("Feed transport: "));
+    Serial.println(feedTransportMode == FEED_TRANSPORT_RECORD ? F("record") : (feedTransportMode == FEED_TRANSPORT_REPLAY ? F("replay") : F("live")));
+    if (feedTransportMode == FEED_TRANSPORT_RECORD) Serial.printf_P(PSTR("Recorded: %lu\r\n"), feedRecorder.recordings);
+    if (feedTransportMode == FEED_TRANSPORT_REPLAY) feedReplayer.print();
+}
+
+#endif
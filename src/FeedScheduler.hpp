@@ -0,0 +1,178 @@
+#ifndef FEED_SCHEDULER_H
+#define FEED_SCHEDULER_H
+
+#include "TickerDebug.hpp"
+
+/*--------------------------- FEED SCHEDULER -----------------------------*/
+/*
+ * Every feed is refreshed on its own interval, rather than all of them together once an hour.
+ * Crypto prices move by the minute, a forecast doesn't. A random jitter is added to each
+ * interval so the feeds drift apart and don't all fall due in the same idle slot.
+ *
+ * A failed refresh is retried after FEED_RETRY_BASE_MS, doubling with each consecutive
+ * failure up to the feed's own interval.
+ *
+ * The main loop asks for next_due() when the display is between states, and fetches that
+ * one feed (or everything that is due, in one bundle request).
+ *
+ * Each feed keeps its own health (consecutive failures, last latency, last error), so one
+ * broken feed only backs off itself. It's shown at /feeds.json and with 'xq'.
+ */
+#define FEED_RETRY_BASE_MS      (30UL * 1000)
+#define FEED_NONE               -1
+
+// Last error of a feed: 0, an HTTP status code, a negative HTTPC_ERROR_* or one of these
+#define FEED_ERROR_NONE         0
+#define FEED_ERROR_PARSE        -100    // Response didn't parse, or 'cod' said no
+#define FEED_ERROR_MISSING      -101    // The bundle came back without this section
+#define FEED_ERROR_NO_WIFI      -102
+
+enum FeedId { FEED_TIME, FEED_WEATHER, FEED_WEATHER_FORECAST, FEED_TICKER, FEED_STOCK, FEED_NEWS, FEED_COUNT };
+
+struct FeedSchedule
+{
+    const char      *action;            // IoT proxy action
+    unsigned long   interval_ms;
+    unsigned long   jitter_ms;          // Up to this much is added to each interval
+
+    unsigned long   next_due_ms;
+    unsigned long   last_success_ms;
+    bool            succeeded;          // At least once, i.e. last_success_ms means something
+    uint8_t         failures;           // Consecutive
+
+    bool            attempted;
+    bool            disabled;           // Nothing to fetch with the user's configuration
+    unsigned long   last_latency_ms;    // Request start until parsed (slowest request of the feed)
+    int             last_error;         // FEED_ERROR_*
+    bool            stale;              // Restored from the cache at boot, not fetched since
+
+    const char* state()
+    {
+        if (disabled)       return "disabled";
+        if (!attempted)     return "pending";
+        if (failures > 0)   return succeeded ? "failing" : "down";
+        return "ok";
+    }
+};
+
+String feedErrorToString(int error)
+{
+    switch (error)
+    {
+        case FEED_ERROR_NONE:       return "";
+        case FEED_ERROR_PARSE:      return F("response didn't parse");
+        case FEED_ERROR_MISSING:    return F("missing from bundle");
+        case FEED_ERROR_NO_WIFI:    return F("no WiFi");
+    }
+
+    return (error > 0) ? ("HTTP " + String(error)) : HTTPClient::errorToString(error);
+}
+
+class FeedScheduler {
+
+    private:
+        FeedSchedule feeds[FEED_COUNT] = {
+            { "time",               6UL * 60 * 60 * 1000,   15UL * 60 * 1000 },
+            { "weather",            30UL * 60 * 1000,       3UL * 60 * 1000 },
+            { "weather_forecast",   3UL * 60 * 60 * 1000,   10UL * 60 * 1000 },
+            { "ticker",             5UL * 60 * 1000,        30UL * 1000 },
+            { "stock",              15UL * 60 * 1000,       90UL * 1000 },
+            { "news",               30UL * 60 * 1000,       3UL * 60 * 1000 }
+        };
+
+        // millis() wraps after 49 days, so compare the difference rather than the values
+        static bool reached(unsigned long now, unsigned long when)
+        {
+            return (long)(now - when) >= 0;
+        }
+
+    public:
+        FeedSchedule& get(int feed) { return feeds[feed]; }
+
+        bool is_due(int feed, unsigned long now)
+        {
+            return reached(now, feeds[feed].next_due_ms);
+        }
+
+        // Refresh everything on the next idle slot (first boot, config changed, 'xl')
+        void schedule_all(unsigned long now)
+        {
+            for (int i = 0; i < FEED_COUNT; i++) {
+                feeds[i].next_due_ms = now;
+            }
+        }
+
+        // The most overdue feed, or FEED_NONE
+        int next_due(unsigned long now)
+        {
+            int             feed        = FEED_NONE;
+            unsigned long   most_late   = 0;
+
+            for (int i = 0; i < FEED_COUNT; i++)
+            {
+                if ( !is_due(i, now) ) continue;
+
+                unsigned long late = now - feeds[i].next_due_ms;
+                if (feed == FEED_NONE || late > most_late) {
+                    feed        = i;
+                    most_late   = late;
+                }
+            }
+
+            return feed;
+        }
+
+        // Nothing to fetch for this feed just now, look again after its interval
+        void skip(int feed, unsigned long now)
+        {
+            feeds[feed].disabled    = true;
+            feeds[feed].next_due_ms = now + feeds[feed].interval_ms;
+        }
+
+        void completed(int feed, bool success, unsigned long now, unsigned long latency_ms = 0, int error = FEED_ERROR_NONE)
+        {
+            FeedSchedule &schedule = feeds[feed];
+
+            schedule.attempted          = true;
+            schedule.disabled           = false;
+            schedule.last_latency_ms    = latency_ms;
+            schedule.last_error         = success ? FEED_ERROR_NONE : error;
+
+            if (success)
+            {
+                schedule.failures           = 0;
+                schedule.succeeded          = true;
+                schedule.stale              = false;
+                schedule.last_success_ms    = now;
+                schedule.next_due_ms        = now + schedule.interval_ms + random(schedule.jitter_ms + 1);
+                return;
+            }
+
+            if (schedule.failures < 16) schedule.failures++;
+
+            unsigned long backoff_ms = min(FEED_RETRY_BASE_MS << (schedule.failures - 1), schedule.interval_ms);
+            schedule.next_due_ms = now + backoff_ms + random(backoff_ms/8 + 1);
+
+            Serial.printf_P(PSTR("[Feed] %s failed (%u in a row, %s), retrying in %lu s.\r\n"), schedule.action, schedule.failures, feedErrorToString(error).c_str(), backoff_ms/1000);
+        }
+
+        // 'xq' in handleSerialRead
+        void print(unsigned long now)
+        {
+            Serial.println(F("Feed              State     Interval  Due in  Last OK  Failures  Latency  Error"));
+
+            for (int i = 0; i < FEED_COUNT; i++) {
+                FeedSchedule &schedule = feeds[i];
+
+                long due_in_s   = (long)(schedule.next_due_ms - now) / 1000;
+                long last_ok_s  = schedule.succeeded ? (long)((now - schedule.last_success_ms) / 1000) : -1;
+
+                Serial.printf_P(PSTR("%-18s%-8s  %7lus  %5lds  %6lds  %8u  %5lums  %s\r\n"), schedule.action, schedule.state(), schedule.interval_ms/1000, due_in_s, last_ok_s, schedule.failures, schedule.last_latency_ms, (feedErrorToString(schedule.last_error) + (schedule.stale ? " (stale)" : "")).c_str());
+            }
+        }
+
+}; // end FeedScheduler
+
+FeedScheduler feedScheduler;
+
+#endif
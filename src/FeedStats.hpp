@@ -0,0 +1,234 @@
+#ifndef FEED_STATS_H
+#define FEED_STATS_H
+
+#include "TickerDebug.hpp"
+
+/*--------------------------- FEED ACTION STATISTICS -----------------------------*/
+// One slot per IoT proxy action (time, weather, weather_forecast, ticker, stock, news).
+#define FEED_STATS_MAX_ACTIONS 8
+
+// Response bodies in one wire format (JSON or MessagePack)
+struct FeedFormatStats
+{
+    unsigned int    responses;
+    unsigned long   bytes;
+    unsigned long   parse_us;   // Time spent in the streaming parser, processors included
+
+    unsigned long average_bytes()   { return responses ? (bytes / responses) : 0; }
+    unsigned long average_us()      { return responses ? (parse_us / responses) : 0; }
+};
+
+/*---- REQUEST TELEMETRY ----*/
+/*
+ * Where the time (and heap) of each request went, to tell a slow DNS server from a slow proxy
+ * from a slow parse. The phases are filled in by IoTConnection::record_telemetry().
+ *
+ * The histogram of total request times is a rolling one. Once FEED_TELEMETRY_WINDOW requests
+ * are in it, every bucket (and the sums behind the averages) is halved, so older requests
+ * count for less and less rather than being kept forever.
+ */
+#define FEED_TELEMETRY_BUCKETS      8       // < 250ms, < 500ms, < 1s ... < 16s, and the rest
+#define FEED_TELEMETRY_BUCKET_MS    250
+#define FEED_TELEMETRY_WINDOW       32
+
+struct FeedTelemetrySample
+{
+    unsigned long   dns_ms;         // 0 on a kept-alive socket
+    unsigned long   connect_ms;
+    unsigned long   ttfb_ms;        // Request sent until the first byte of the response
+    unsigned long   transfer_ms;    // First byte until the end of the body, less parse_us
+    unsigned long   parse_us;
+    unsigned long   bytes;          // On the wire, so compressed if it was
+    uint32_t        heap_before;
+    uint32_t        heap_after;
+    uint32_t        max_block;      // Largest free block, after
+    uint8_t         fragmentation_before;   // ESP.getHeapFragmentation(), as a %
+    uint8_t         fragmentation_after;
+
+    unsigned long total_ms() { return dns_ms + connect_ms + ttfb_ms + transfer_ms + parse_us/1000; }
+};
+
+struct FeedTelemetry
+{
+    FeedTelemetrySample last;
+    FeedTelemetrySample sum;        // Of the rolling window, for averages. The heap fields are unused.
+    unsigned int        window;     // Requests in sum / histogram
+    unsigned long       requests;   // All of them
+    long                worst_heap_delta;
+    uint32_t            min_max_block;
+    int                 worst_fragmentation_delta;  // Percentage points, of a news refresh for one
+    uint8_t             histogram[FEED_TELEMETRY_BUCKETS];
+
+    unsigned long average(unsigned long FeedTelemetrySample::*field) { return window ? (sum.*field / window) : 0; }
+
+    static int bucket(unsigned long ms)
+    {
+        int i = 0;
+        while (i < (FEED_TELEMETRY_BUCKETS-1) && ms >= ((unsigned long) FEED_TELEMETRY_BUCKET_MS << i)) i++;
+        return i;
+    }
+
+    void record(FeedTelemetrySample &sample)
+    {
+        if (window >= FEED_TELEMETRY_WINDOW) age();
+
+        long heap_delta = (long) sample.heap_after - (long) sample.heap_before;
+
+        if (requests == 0 || heap_delta < worst_heap_delta)        worst_heap_delta    = heap_delta;
+        if (requests == 0 || sample.max_block < min_max_block)     min_max_block       = sample.max_block;
+
+        int fragmentation_delta = (int) sample.fragmentation_after - (int) sample.fragmentation_before;
+        if (requests == 0 || fragmentation_delta > worst_fragmentation_delta)  worst_fragmentation_delta = fragmentation_delta;
+
+        last = sample;
+        requests++;
+        window++;
+
+        sum.dns_ms      += sample.dns_ms;
+        sum.connect_ms  += sample.connect_ms;
+        sum.ttfb_ms     += sample.ttfb_ms;
+        sum.transfer_ms += sample.transfer_ms;
+        sum.parse_us    += sample.parse_us;
+        sum.bytes       += sample.bytes;
+
+        histogram[bucket(sample.total_ms())]++;
+    }
+
+    void age()
+    {
+        window          /= 2;
+        sum.dns_ms      /= 2;
+        sum.connect_ms  /= 2;
+        sum.ttfb_ms     /= 2;
+        sum.transfer_ms /= 2;
+        sum.parse_us    /= 2;
+        sum.bytes       /= 2;
+
+        for (uint8_t &count : histogram) count /= 2;
+    }
+};
+
+struct FeedActionStats
+{
+    char    action[20];
+    size_t  doc_capacity;       // What the last request asked the heap for
+    size_t  doc_peak_usage;     // High-water mark of JsonDocument::memoryUsage() for this action
+    size_t  doc_last_usage;
+    unsigned int requests;
+
+    FeedFormatStats json;
+    FeedFormatStats msgpack;
+
+    FeedTelemetry   telemetry;
+};
+
+FeedActionStats feedActionStats[FEED_STATS_MAX_ACTIONS];
+int             feedActionStatsCount = 0;
+
+FeedActionStats& getFeedActionStats(const char *action)
+{
+    for (int i = 0; i < feedActionStatsCount; i++) {
+      if (strcmp(feedActionStats[i].action, action) == 0) return feedActionStats[i];
+    }
+
+    // New action. If we've somehow run out of slots, recycle the last one.
+    int slot = (feedActionStatsCount < FEED_STATS_MAX_ACTIONS) ? feedActionStatsCount++ : (FEED_STATS_MAX_ACTIONS-1);
+
+    memset(&feedActionStats[slot], 0, sizeof(FeedActionStats));
+    strncpy(feedActionStats[slot].action, action, sizeof(feedActionStats[slot].action)-1);
+
+    return feedActionStats[slot];
+}
+
+void recordFeedDocumentUsage(const char *action, size_t capacity, size_t usage)
+{
+    FeedActionStats &stats = getFeedActionStats(action);
+
+    stats.requests++;
+    stats.doc_capacity    = capacity;
+    stats.doc_last_usage  = usage;
+    stats.doc_peak_usage  = max(stats.doc_peak_usage, usage);
+
+#if DEBUG_MODE
+    Serial.printf_P(PSTR("[JSON] %s: document %u of %u bytes used (peak %u).\r\n"), action, usage, capacity, stats.doc_peak_usage);
+#endif
+}
+
+// Bytes over the air and parse time, to compare formats on the same feeds
+void recordFeedFormatUsage(const char *action, bool msgpack, size_t bytes, unsigned long parse_us)
+{
+    FeedActionStats &stats  = getFeedActionStats(action);
+    FeedFormatStats &format = msgpack ? stats.msgpack : stats.json;
+
+    format.responses++;
+    format.bytes    += bytes;
+    format.parse_us += parse_us;
+
+#if DEBUG_MODE
+    Serial.printf_P(PSTR("[Feed] %s: %u bytes of %s, parsed in %lu us.\r\n"), action, bytes, msgpack ? "MessagePack" : "JSON", parse_us);
+#endif
+}
+
+// One request, under its action (or "bundle")
+void recordFeedTelemetry(const char *action, FeedTelemetrySample &sample)
+{
+    getFeedActionStats(action).telemetry.record(sample);
+
+#if DEBUG_MODE
+    Serial.printf_P(PSTR("[Feed] %s: dns %lu, connect %lu, ttfb %lu, transfer %lu, parse %lu ms, %lu bytes, heap %u -> %u (block %u, fragmented %u%% -> %u%%).\r\n"),
+        action, sample.dns_ms, sample.connect_ms, sample.ttfb_ms, sample.transfer_ms, sample.parse_us/1000, sample.bytes,
+        sample.heap_before, sample.heap_after, sample.max_block, sample.fragmentation_before, sample.fragmentation_after);
+#endif
+}
+
+// Dump to serial, 'xh' in handleSerialRead. Frag is the heap fragmentation (%) before and after
+// the last request, and Worst the most any request has added to it.
+void printFeedTelemetry()
+{
+    Serial.println(F("Action            Reqs    DNS  Conn  TTFB  Xfer  Parse   Bytes  Heap delta  Min block     Frag  Worst  Last ms"));
+
+    for (int i = 0; i < feedActionStatsCount; i++) {
+      FeedTelemetry &telemetry = feedActionStats[i].telemetry;
+      if (telemetry.requests == 0) continue;
+
+      Serial.printf_P(PSTR("%-18s%4lu  %5lu %5lu %5lu %5lu %6lu  %6lu  %10ld  %9u  %3u->%3u  %+5d  %7lu\r\n"), feedActionStats[i].action, telemetry.requests,
+          telemetry.average(&FeedTelemetrySample::dns_ms), telemetry.average(&FeedTelemetrySample::connect_ms), telemetry.average(&FeedTelemetrySample::ttfb_ms),
+          telemetry.average(&FeedTelemetrySample::transfer_ms), telemetry.average(&FeedTelemetrySample::parse_us)/1000, telemetry.average(&FeedTelemetrySample::bytes),
+          telemetry.worst_heap_delta, telemetry.min_max_block, telemetry.last.fragmentation_before, telemetry.last.fragmentation_after,
+          telemetry.worst_fragmentation_delta, telemetry.last.total_ms());
+    }
+
+    Serial.print(F("Histogram of request times, from <"));
+    Serial.print(FEED_TELEMETRY_BUCKET_MS);
+    Serial.println(F("ms doubling:"));
+
+    for (int i = 0; i < feedActionStatsCount; i++) {
+      FeedTelemetry &telemetry = feedActionStats[i].telemetry;
+      if (telemetry.requests == 0) continue;
+
+      Serial.printf_P(PSTR("%-18s"), feedActionStats[i].action);
+      for (uint8_t count : telemetry.histogram) Serial.printf_P(PSTR("%4u"), count);
+      Serial.println();
+    }
+}
+
+// Dump to serial, 'xs' in handleSerialRead
+void printFeedActionStats()
+{
+    Serial.println(F("Action            Requests  Capacity  Last  Peak"));
+
+    for (int i = 0; i < feedActionStatsCount; i++) {
+      FeedActionStats &stats = feedActionStats[i];
+      Serial.printf_P(PSTR("%-18s%8u  %8u  %4u  %4u\r\n"), stats.action, stats.requests, stats.doc_capacity, stats.doc_last_usage, stats.doc_peak_usage);
+    }
+
+    Serial.println(F("Action            JSON avg bytes / us   MsgPack avg bytes / us"));
+
+    for (int i = 0; i < feedActionStatsCount; i++) {
+      FeedActionStats &stats = feedActionStats[i];
+      Serial.printf_P(PSTR("%-18s%9lu / %-8lu  %9lu / %-8lu\r\n"), stats.action,
+          stats.json.average_bytes(), stats.json.average_us(), stats.msgpack.average_bytes(), stats.msgpack.average_us());
+    }
+}
+
+#endif
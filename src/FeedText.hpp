@@ -0,0 +1,134 @@
+#ifndef FEED_TEXT_H
+#define FEED_TEXT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*--------------------------- FEED DISPLAY STRINGS -----------------------------*/
+/*
+ * The lines a feed is shown as (news headlines), packed into one fixed block rather than a
+ * std::list of std::strings. Each line is an offset and length into the block, and is NUL
+ * terminated, so Parola can scroll it from where it is. Building a new generation (refer to
+ * FeedBuffer.hpp) makes no allocations, as the news feed recycles slots allocated at boot, so
+ * refreshes don't leave holes all over the heap. The heap fragmentation before and after each request is in
+ * the 'xh' telemetry (and /telemetry.json), to see that a news refresh doesn't add to it.
+ *
+ * Once the block (or the line table) is full, further lines are dropped and counted, rather
+ * than it growing. The size is in JsonProcessor.hpp.
+ */
+struct FeedTextLine
+{
+    uint16_t    offset;
+    uint16_t    length;     // Not counting the NUL
+};
+
+class FeedTextStore {
+
+    private:
+        char            *text;
+        FeedTextLine    *lines;
+        uint16_t        text_capacity;
+        uint16_t        line_capacity;
+        uint16_t        used        = 0;
+        uint16_t        count       = 0;
+
+        // Room for a line of length at position (0 is the front), or nullptr if there isn't any
+        char* insert(size_t position, size_t length)
+        {
+            if ( count >= line_capacity || (used + length + 1) > text_capacity ) {
+                dropped++;
+                return nullptr;
+            }
+
+            memmove(&lines[position + 1], &lines[position], (count - position) * sizeof(FeedTextLine));
+            lines[position] = { used, (uint16_t) length };
+
+            char *line      = text + used;
+            line[length]    = '\0';
+
+            used  += length + 1;
+            count++;
+            return line;
+        }
+
+        bool add(size_t position, const char *s, const char *prefix)
+        {
+            size_t prefix_length    = prefix ? strlen(prefix) : 0;
+            size_t s_length         = strlen(s);
+
+            char *line = insert(position, prefix_length + s_length);
+            if (!line) return false;
+
+            memcpy(line, prefix, prefix_length);
+            memcpy(line + prefix_length, s, s_length);
+            return true;
+        }
+
+    protected:
+        FeedTextStore(char *_text, size_t _text_capacity, FeedTextLine *_lines, size_t _line_capacity) :
+            text(_text), lines(_lines), text_capacity(_text_capacity), line_capacity(_line_capacity) { }
+
+    public:
+        uint16_t        dropped     = 0;    // Lines there wasn't room for
+
+        // The lines point into this object, so it stays where it was built
+        FeedTextStore(const FeedTextStore &) = delete;
+        FeedTextStore& operator=(const FeedTextStore &) = delete;
+
+        // Add prefix then s as a line. Returns false if there wasn't room for it.
+        bool push_back(const char *s, const char *prefix = nullptr)     { return add(count, s, prefix); }
+        bool push_front(const char *s, const char *prefix = nullptr)    { return add(0, s, prefix); }
+
+        // Room for a line of length at the end, for the caller to fill (i.e. from a file)
+        char* append(size_t length)                                     { return insert(count, length); }
+
+        size_t      size() const                    { return count; }
+        bool        empty() const                   { return count == 0; }
+        size_t      bytes_used() const              { return used; }
+        const char* operator[](size_t i) const      { return text + lines[i].offset; }
+        size_t      length(size_t i) const          { return lines[i].length; }
+
+        void clear()
+        {
+            used    = 0;
+            count   = 0;
+            dropped = 0;
+        }
+
+        class const_iterator {
+
+            private:
+                const FeedTextStore *store;
+                size_t              i;
+
+            public:
+                const_iterator(const FeedTextStore *_store = nullptr, size_t _i = 0) : store(_store), i(_i) { }
+
+                const char*     operator*() const                               { return (*store)[i]; }
+                const_iterator& operator++()                                    { i++; return *this; }
+                bool            operator==(const const_iterator &other) const   { return store == other.store && i == other.i; }
+                bool            operator!=(const const_iterator &other) const   { return !(*this == other); }
+        };
+
+        const_iterator begin() const    { return const_iterator(this, 0); }
+        const_iterator end() const      { return const_iterator(this, count); }
+
+}; // end FeedTextStore
+
+// BYTES includes a NUL for each line
+template <size_t BYTES, size_t LINES>
+class FeedText : public FeedTextStore {
+
+    static_assert(BYTES <= UINT16_MAX && LINES <= UINT16_MAX, "Offsets are 16 bit");
+
+    private:
+        char            block[BYTES];
+        FeedTextLine    line_table[LINES];
+
+    public:
+        FeedText() : FeedTextStore(block, BYTES, line_table, LINES) { }
+
+}; // end FeedText
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef FEED_TRANSPORT_H
+#define FEED_TRANSPORT_H
+
+#include "TickerDebug.hpp"
+#include "ConditionalGet.hpp"
+#include "FeedStats.hpp"
+
+/*--------------------------- FEED TRANSPORT -----------------------------*/
+/*
+ * What get_json_and_parse_v3() and FeedFetch get their responses from. Normally that's the
+ * IoT proxy (IoTConnection), but it can also be one that records what the proxy sends to
+ * LittleFS, or one that plays those recordings back without any network at all. Refer to
+ * FeedReplay.hpp.
+ *
+ * A request is begin(), then poll() until it returns false (the headers are in), status(),
+ * the body from stream(), body_parsed() if all of it parsed, and end().
+ */
+#define FEED_TRANSPORT_GET_POLL_MS  1000    // get() waits anyway, so there's no need to give back often
+
+class FeedTransport {
+
+    protected:
+        unsigned long       first_byte_ms   = 0;    // Of the response, 0 until it has
+        unsigned long       end_ms          = 0;
+
+        // For record_telemetry(), refer to FeedStats.hpp
+        FeedTelemetrySample telemetry;
+
+        void begin_telemetry()
+        {
+            memset(&telemetry, 0, sizeof(telemetry));
+            telemetry.heap_before           = ESP.getFreeHeap();
+            telemetry.fragmentation_before  = ESP.getHeapFragmentation();
+            first_byte_ms                   = 0;
+        }
+
+    public:
+        bool            msgpack_response    = false;    // The body is MessagePack rather than JSON
+
+        // Validators of the last response, to hand to conditionalGets.store() once it's parsed
+        char            etag[48]            = {0};
+        char            last_modified[32]   = {0};
+
+        virtual ~FeedTransport() { }
+
+        // Start a GET of path (i.e. "/iot/ticker/?action=time&...") from host. With a validator,
+        // the request is conditional and may come back 304.
+        virtual void begin(const char *host, const String &path, ConditionalGetEntry *validator = nullptr) = 0;
+
+        // Do as much of the request as can be done in budget_ms without waiting. Returns true
+        // while it's still in progress.
+        virtual bool poll(unsigned long budget_ms) = 0;
+
+        // The HTTP status code (or a negative HTTPC_ERROR_*)
+        virtual int status() = 0;
+
+        // The response body, without any chunk framing (or compression).
+        virtual Stream& stream() = 0;
+
+        // All of the body was read and parsed. Only the recorder cares, as it keeps nothing else.
+        virtual void body_parsed() { }
+
+        // Done with the response, whether or not all of the body was read.
+        virtual void end() = 0;
+
+        // The body couldn't be decoded, so a parser waiting on the rest of it would wait in vain.
+        // Only a compressed one that didn't inflate, refer to IoTConnection.
+        virtual bool body_failed() { return false; }
+
+        // Send a GET and wait for the response headers. Returns the HTTP status code (or a
+        // negative HTTPC_ERROR_*).
+        int get(const char *host, const String &path, ConditionalGetEntry *validator = nullptr)
+        {
+            begin(host, path, validator);
+
+            while ( poll(FEED_TRANSPORT_GET_POLL_MS) ) {
+                yield();
+            }
+
+            return status();
+        }
+
+        // How the request that's just ended went, under action. parse_us is the time spent in the
+        // parser, which ran as the body came in, so it's taken off the transfer time. Call once
+        // the response has been dealt with and freed, for the heap after.
+        virtual void record_telemetry(const char *action, unsigned long parse_us)
+        {
+            unsigned long response_ms = first_byte_ms ? (end_ms - first_byte_ms) : 0;
+
+            telemetry.parse_us              = parse_us;
+            telemetry.transfer_ms           = (response_ms > parse_us/1000) ? (response_ms - parse_us/1000) : 0;
+            telemetry.heap_after            = ESP.getFreeHeap();
+            telemetry.max_block             = ESP.getMaxFreeBlockSize();
+            telemetry.fragmentation_after   = ESP.getHeapFragmentation();
+
+            recordFeedTelemetry(action, telemetry);
+        }
+
+}; // end FeedTransport
+
+#endif
@@ -0,0 +1,522 @@
+#ifndef INFLATE_STREAM_H
+#define INFLATE_STREAM_H
+
+#include "TickerDebug.hpp"
+
+/*--------------------------- STREAMING INFLATE -----------------------------*/
+/*
+ * News and forecast text compresses to about a quarter of its size, and over a weak 2.4GHz
+ * link the bytes on the air are what take the time. With Accept-Encoding the proxy can gzip
+ * (or zlib 'deflate') its responses, and this sits between the response body and the JSON /
+ * MessagePack parser, inflating as the bytes come in. Nothing is ever buffered whole.
+ *
+ * Deflate (https://www.rfc-editor.org/rfc/rfc1951) refers back up to 32KB into what it has
+ * already output, which is more than we'd like to keep around. The window here is only
+ * INFLATE_WINDOW_SIZE, so the proxy has to compress with a window no bigger than that
+ * (i.e. zlib wbits 12, or gzip's -12), and requests say so with deflate_window_bits. A zlib
+ * header says what window it used, and is refused if it's too big. Gzip doesn't say, so a
+ * reference too far back fails the response.
+ *
+ * Once it has failed, available() is -1 and reads don't wait, so the parser gives up at once
+ * rather than after the response timeout. IoTConnection then turns compression off, and the
+ * request is made again without it.
+ *
+ * Decoding is done one step at a time: a block header, a literal, or a length/distance
+ * pair. If the input runs out part way through a step, it is undone and tried again once
+ * more has arrived, so it can be fed whatever the socket has (as the parsers are), without
+ * ever blocking. The gzip / zlib checksums are skipped, as the parser will catch nonsense.
+ *
+ * The decoder is canonical Huffman as in tinf (https://github.com/jibsen/tinf).
+ */
+#define INFLATE_WINDOW_BITS     12
+#define INFLATE_WINDOW_SIZE     (1 << INFLATE_WINDOW_BITS)
+#define INFLATE_WINDOW_MASK     (INFLATE_WINDOW_SIZE - 1)
+#define INFLATE_INPUT_BUFFER    640     // A dynamic block header has to fit in one go
+#define INFLATE_INPUT_COMPACT   64      // Free space at the end of the input buffer below which it's compacted
+
+struct InflateTree
+{
+    uint16_t counts[16];    // Number of codes of each length
+    uint16_t symbols[288];  // In code order
+};
+
+class InflateStream : public Stream {
+
+    private:
+        enum InflateState { INFLATE_GZIP_HEADER, INFLATE_ZLIB_HEADER, INFLATE_BLOCK_HEADER, INFLATE_STORED, INFLATE_HUFFMAN, INFLATE_TRAILER, INFLATE_DONE, INFLATE_ERROR };
+
+        Stream          *source         = nullptr;
+        InflateState    state           = INFLATE_DONE;
+        bool            gzip            = false;
+        bool            last_block      = false;
+        uint16_t        stored_remaining = 0;
+
+        // Compressed bytes that have arrived but aren't used yet
+        uint8_t         *input          = nullptr;
+        size_t          input_start     = 0;
+        size_t          input_end       = 0;
+        uint32_t        bit_buffer      = 0;
+        uint8_t         bit_count       = 0;
+        bool            starved         = false;    // Ran out of input part way through a step
+
+        // Output, which is also the dictionary that matches refer back into
+        uint8_t         *window         = nullptr;
+        uint32_t        written         = 0;
+        uint16_t        pending         = 0;        // Of the last bytes written, not read yet
+
+        InflateTree     *literals       = nullptr;
+        InflateTree     *distances      = nullptr;
+
+        /*---- BITS ----*/
+        // Least significant bit first. Sets starved, rather than wait, if there aren't enough.
+        uint32_t bits(uint8_t count)
+        {
+            while (bit_count < count)
+            {
+                if (input_start == input_end) {
+                    starved = true;
+                    return 0;
+                }
+                bit_buffer |= (uint32_t) input[input_start++] << bit_count;
+                bit_count  += 8;
+            }
+
+            uint32_t value = bit_buffer & ((1UL << count) - 1);
+            bit_buffer >>= count;
+            bit_count   -= count;
+            return value;
+        }
+
+        void align()
+        {
+            bits(bit_count & 7);
+        }
+
+        /*---- HUFFMAN ----*/
+        static void build(InflateTree &tree, const uint8_t *lengths, int count)
+        {
+            uint16_t offsets[16];
+
+            memset(tree.counts, 0, sizeof(tree.counts));
+            for (int i = 0; i < count; i++) tree.counts[lengths[i]]++;
+            tree.counts[0] = 0;
+
+            for (int i = 0, sum = 0; i < 16; i++) {
+                offsets[i]  = sum;
+                sum        += tree.counts[i];
+            }
+
+            for (int i = 0; i < count; i++) {
+                if (lengths[i]) tree.symbols[offsets[lengths[i]]++] = i;
+            }
+        }
+
+        int decode(const InflateTree &tree)
+        {
+            int sum = 0, code = 0, length = 0;
+
+            do {
+                code = (2 * code) + bits(1);
+                if (starved) return 0;
+
+                if (++length > 15) {
+                    state = INFLATE_ERROR;
+                    return 0;
+                }
+
+                sum  += tree.counts[length];
+                code -= tree.counts[length];
+            } while (code >= 0);
+
+            return tree.symbols[sum + code];
+        }
+
+        void build_fixed_trees()
+        {
+            uint8_t lengths[288];
+
+            memset(lengths,         8, 144);
+            memset(lengths + 144,   9, 112);
+            memset(lengths + 256,   7, 24);
+            memset(lengths + 280,   8, 8);
+            build(*literals, lengths, 288);
+
+            memset(lengths, 5, 30);
+            build(*distances, lengths, 30);
+        }
+
+        void read_dynamic_trees()
+        {
+            static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+            uint8_t lengths[288 + 32];
+
+            int literal_count   = bits(5) + 257;
+            int distance_count  = bits(5) + 1;
+            int length_count    = bits(4) + 4;
+
+            memset(lengths, 0, 19);
+            for (int i = 0; i < length_count; i++) lengths[order[i]] = bits(3);
+            if (starved) return;
+
+            build(*literals, lengths, 19); // The code lengths are coded too
+
+            int total = literal_count + distance_count;
+            for (int i = 0; i < total; )
+            {
+                int     symbol  = decode(*literals);
+                uint8_t repeat  = 0;
+                int     times   = 0;
+
+                if (starved || state == INFLATE_ERROR) return;
+
+                switch (symbol)
+                {
+                    case 16:    // Previous length 3-6 times
+                        if (i == 0) { state = INFLATE_ERROR; return; }
+                        repeat  = lengths[i-1];
+                        times   = bits(2) + 3;
+                        break;
+                    case 17:    // Zero 3-10 times
+                        times   = bits(3) + 3;
+                        break;
+                    case 18:    // Zero 11-138 times
+                        times   = bits(7) + 11;
+                        break;
+                    default:
+                        lengths[i++] = symbol;
+                        continue;
+                }
+
+                if (starved) return;
+                if (i + times > total) { state = INFLATE_ERROR; return; }
+
+                while (times--) lengths[i++] = repeat;
+            }
+
+            build(*literals,  lengths, literal_count);
+            build(*distances, lengths + literal_count, distance_count);
+        }
+
+        /*---- OUTPUT ----*/
+        void put(uint8_t c)
+        {
+            window[written++ & INFLATE_WINDOW_MASK] = c;
+            pending++;
+        }
+
+        void copy(uint16_t length, uint16_t distance)
+        {
+            while (length--) put(window[(written - distance) & INFLATE_WINDOW_MASK]);
+        }
+
+        /*---- STEPS ----*/
+        void step_header()
+        {
+            if (gzip)
+            {
+                uint8_t id1 = bits(8), id2 = bits(8), method = bits(8), flags = bits(8);
+                bits(16); bits(16); bits(16);                       // mtime, xfl, os
+
+                if (flags & 0x04) {                                 // FEXTRA
+                    uint16_t extra = bits(16);
+                    if (extra > INFLATE_INPUT_BUFFER/2) { state = INFLATE_ERROR; return; }
+                    while (extra-- && !starved) bits(8);
+                }
+                if (flags & 0x08) while (!starved && bits(8)) { }   // FNAME
+                if (flags & 0x10) while (!starved && bits(8)) { }   // FCOMMENT
+                if (flags & 0x02) bits(16);                         // FHCRC
+                if (starved) return;
+
+                if (id1 != 0x1f || id2 != 0x8b || method != 8) {
+                    Sprintln(F("[Inflate] Not gzip."));
+                    state = INFLATE_ERROR;
+                    return;
+                }
+            }
+            else
+            {
+                uint8_t cmf = bits(8), flags = bits(8);
+                if (starved) return;
+
+                if ( (cmf & 0x0f) != 8 || ((cmf << 8) | flags) % 31 != 0 || (flags & 0x20) ) {
+                    Sprintln(F("[Inflate] Not zlib."));
+                    state = INFLATE_ERROR;
+                    return;
+                }
+
+                if ( (cmf >> 4) + 8 > INFLATE_WINDOW_BITS ) {
+                    Sprintln(F("[Inflate] Compressed with a bigger window than we have."));
+                    state = INFLATE_ERROR;
+                    return;
+                }
+            }
+
+            state = INFLATE_BLOCK_HEADER;
+        }
+
+        void step_block_header()
+        {
+            bool    final   = bits(1);
+            uint8_t type    = bits(2);
+            if (starved) return;
+
+            switch (type)
+            {
+                case 0: // Stored
+                {
+                    align();
+                    uint16_t length     = bits(16);
+                    uint16_t n_length   = bits(16);
+                    if (starved) return;
+
+                    if (length != (uint16_t) ~n_length) { state = INFLATE_ERROR; return; }
+
+                    stored_remaining    = length;
+                    state               = INFLATE_STORED;
+                    break;
+                }
+
+                case 1:
+                    build_fixed_trees();
+                    state = INFLATE_HUFFMAN;
+                    break;
+
+                case 2:
+                    read_dynamic_trees();
+                    if (starved || state == INFLATE_ERROR) return;
+                    state = INFLATE_HUFFMAN;
+                    break;
+
+                default:
+                    state = INFLATE_ERROR;
+                    return;
+            }
+
+            last_block = final;
+        }
+
+        void end_block()
+        {
+            state = last_block ? INFLATE_TRAILER : INFLATE_BLOCK_HEADER;
+        }
+
+        void step_stored()
+        {
+            if (stored_remaining == 0) { end_block(); return; }
+
+            uint8_t c = bits(8);
+            if (starved) return;
+
+            put(c);
+            stored_remaining--;
+        }
+
+        void step_huffman()
+        {
+            static const uint16_t length_base[29]   = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+            static const uint8_t  length_extra[29]  = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+            static const uint16_t distance_base[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+            static const uint8_t  distance_extra[30]= { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+            int symbol = decode(*literals);
+            if (starved || state == INFLATE_ERROR) return;
+
+            if (symbol < 256) { put(symbol); return; }
+            if (symbol == 256) { end_block(); return; }
+
+            symbol -= 257;
+            if (symbol >= 29) { state = INFLATE_ERROR; return; }
+
+            uint16_t length = length_base[symbol] + bits(length_extra[symbol]);
+
+            int distance_symbol = decode(*distances);
+            if (starved || state == INFLATE_ERROR) return;
+            if (distance_symbol >= 30) { state = INFLATE_ERROR; return; }
+
+            uint16_t distance = distance_base[distance_symbol] + bits(distance_extra[distance_symbol]);
+            if (starved) return;
+
+            if (distance > INFLATE_WINDOW_SIZE || distance > written) {
+                Sprintln(F("[Inflate] Reference beyond our window."));
+                state = INFLATE_ERROR;
+                return;
+            }
+
+            copy(length, distance);
+        }
+
+        void step_trailer()
+        {
+            align();
+            for (int i = 0; i < (gzip ? 8 : 4); i++) bits(8);  // CRC32 and size, or Adler-32
+            if (starved) return;
+
+            state = INFLATE_DONE;
+        }
+
+        // One step, or none at all if the input ran out part way through it.
+        bool step()
+        {
+            size_t      saved_start     = input_start;
+            uint32_t    saved_buffer    = bit_buffer;
+            uint8_t     saved_count     = bit_count;
+
+            starved = false;
+
+            switch (state)
+            {
+                case INFLATE_GZIP_HEADER:
+                case INFLATE_ZLIB_HEADER:   step_header();          break;
+                case INFLATE_BLOCK_HEADER:  step_block_header();    break;
+                case INFLATE_STORED:        step_stored();          break;
+                case INFLATE_HUFFMAN:       step_huffman();         break;
+                case INFLATE_TRAILER:       step_trailer();         break;
+                default:                                            break;
+            }
+
+            if (starved) {
+                input_start = saved_start;
+                bit_buffer  = saved_buffer;
+                bit_count   = saved_count;
+                return false;
+            }
+
+            return true;
+        }
+
+        // Whatever compressed bytes have arrived, as far as they fit. What's left of the input is
+        // only moved down to the start once there's little room after it, not on every read.
+        void fill()
+        {
+            if (input_start == input_end) input_start = input_end = 0;
+
+            int available = source->available();
+            if (available <= 0) return;
+
+            size_t room = INFLATE_INPUT_BUFFER - input_end;
+            if ( input_start > 0 && room < min((size_t) available, (size_t) INFLATE_INPUT_COMPACT) ) {
+                memmove(input, input + input_start, input_end - input_start);
+                input_end   -= input_start;
+                input_start  = 0;
+                room         = INFLATE_INPUT_BUFFER - input_end;
+            }
+
+            if (room > 0)
+            {
+                size_t length = source->readBytes(input + input_end, min((size_t) available, room));
+                input_end   += length;
+                wire_bytes  += length;
+            }
+        }
+
+        // Decode until there's something to read, or we have to wait for more input. Only goes
+        // back to the source when a step runs out of input.
+        bool produce()
+        {
+            if (pending > 0) return true;
+
+            unsigned long start_us = micros();
+
+            while (pending == 0 && state != INFLATE_DONE && state != INFLATE_ERROR)
+            {
+                if (step()) continue;
+
+                size_t unused = input_end - input_start;
+                fill();
+                if (input_end - input_start > unused) continue;
+
+                // A step that doesn't fit in the buffer would never finish
+                if (unused >= INFLATE_INPUT_BUFFER) {
+                    Sprintln(F("[Inflate] Input buffer too small."));
+                    state = INFLATE_ERROR;
+                }
+                break;
+            }
+
+            if (state == INFLATE_ERROR) setTimeout(0);  // Nothing more is coming, so don't wait for it
+
+            inflate_us += micros() - start_us;
+            return (pending > 0);
+        }
+
+        void release()
+        {
+            delete[] input;
+            delete[] window;
+            delete literals;
+            delete distances;
+
+            input       = nullptr;
+            window      = nullptr;
+            literals    = nullptr;
+            distances   = nullptr;
+        }
+
+    public:
+        unsigned long   wire_bytes  = 0;    // Compressed, of this response
+        unsigned long   inflate_us  = 0;
+
+        ~InflateStream()
+        {
+            release();
+        }
+
+        // Start on a gzip (or zlib, for 'deflate') body. The buffers are only held until end().
+        void begin(Stream &_source, bool _gzip)
+        {
+            release();
+
+            input       = new uint8_t[INFLATE_INPUT_BUFFER];
+            window      = new uint8_t[INFLATE_WINDOW_SIZE];
+            literals    = new InflateTree;
+            distances   = new InflateTree;
+
+            source      = &_source;
+            gzip        = _gzip;
+            state       = gzip ? INFLATE_GZIP_HEADER : INFLATE_ZLIB_HEADER;
+            last_block  = false;
+
+            input_start = input_end = 0;
+            bit_buffer  = 0;
+            bit_count   = 0;
+            written     = 0;
+            pending     = 0;
+            wire_bytes  = 0;
+            inflate_us  = 0;
+        }
+
+        void end()
+        {
+            release();
+            state = INFLATE_DONE;
+        }
+
+        bool        failed()        { return state == INFLATE_ERROR; }
+        uint32_t    body_bytes()    { return written; }
+
+        // -1 once it has failed, as nothing more is ever coming
+        int available()
+        {
+            if (produce()) return pending;
+            return failed() ? -1 : 0;
+        }
+
+        int read()
+        {
+            if (!produce()) return -1;
+            return window[(written - pending--) & INFLATE_WINDOW_MASK];
+        }
+
+        int peek()
+        {
+            return produce() ? window[(written - pending) & INFLATE_WINDOW_MASK] : -1;
+        }
+
+        size_t write(uint8_t c)
+        {
+            return 0; // read only
+        }
+
+}; // end InflateStream
+
+#endif
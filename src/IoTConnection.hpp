@@ -0,0 +1,604 @@
+#ifndef IOT_CONNECTION_H
+#define IOT_CONNECTION_H
+
+#include "TickerDebug.hpp"
+#include "ConditionalGet.hpp"
+#include "EndpointPool.hpp"
+#include "InflateStream.hpp"
+#include "FeedTransport.hpp"
+
+extern WiFiClient client;
+
+/*--------------------------- HTTP RESPONSE BODY -----------------------------*/
+/*
+ * The response body is read straight off the socket. That's fine for HTTP/1.0 where the
+ * server closes the connection at the end of the body, but with HTTP/1.1 keep-alive the body
+ * may be chunked, and the next response follows straight on from this one. This sits between
+ * the socket and the JSON parser: it strips the chunk framing, and knows where the body ends
+ * so the rest of it can be consumed before the socket is reused.
+ *
+ * https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/Transfer-Encoding
+ */
+class HttpBodyStream : public Stream {
+
+    private:
+        enum ChunkState { CHUNK_SIZE, CHUNK_EXTENSION, CHUNK_DATA, CHUNK_DATA_END, CHUNK_TRAILER, CHUNK_DONE };
+
+        Stream      *source     = nullptr;
+        bool        chunked     = false;
+        long        remaining   = 0;        // Of the body, or of the current chunk. -1 = until the server closes.
+
+        ChunkState  state       = CHUNK_DONE;
+        long        chunk_size  = 0;
+        bool        line_empty  = true;     // For the trailer, which ends with an empty line
+
+        // Consume chunk framing until we're sitting on chunk data (or the end).
+        void read_framing()
+        {
+            while (state != CHUNK_DATA && state != CHUNK_DONE && source->available() > 0)
+            {
+                char c = source->read();
+
+                switch (state)
+                {
+                    case CHUNK_SIZE:
+                        if (isxdigit(c)) {
+                            chunk_size = (chunk_size << 4) | (isdigit(c) ? (c - '0') : ((tolower(c) - 'a') + 10));
+                        } else if (c == ';') {
+                            state = CHUNK_EXTENSION;
+                        } else if (c == '\n') {
+                            start_chunk();
+                        }
+                        break;
+
+                    case CHUNK_EXTENSION:
+                        if (c == '\n') start_chunk();
+                        break;
+
+                    case CHUNK_DATA_END: // CRLF after the chunk data
+                        if (c == '\n') {
+                            state       = CHUNK_SIZE;
+                            chunk_size  = 0;
+                        }
+                        break;
+
+                    case CHUNK_TRAILER:
+                        if (c == '\n') {
+                            if (line_empty) state = CHUNK_DONE;
+                            line_empty = true;
+                        } else if (c != '\r') {
+                            line_empty = false;
+                        }
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+        }
+
+        void start_chunk()
+        {
+            if (chunk_size == 0) { // last-chunk
+                state       = CHUNK_TRAILER;
+                line_empty  = true;
+            } else {
+                state       = CHUNK_DATA;
+                remaining   = chunk_size;
+            }
+        }
+
+    public:
+        unsigned long   bytes_read  = 0;    // Of this body, less the chunk framing
+
+        // content_length is from the Content-Length header, -1 if the server didn't say.
+        void begin(Stream &_source, bool _chunked, long content_length)
+        {
+            bytes_read  = 0;
+            source      = &_source;
+            chunked     = _chunked;
+            chunk_size  = 0;
+
+            if (chunked) {
+                state       = CHUNK_SIZE;
+                remaining   = 0;
+            } else {
+                state       = (content_length == 0) ? CHUNK_DONE : CHUNK_DATA;
+                remaining   = content_length;
+            }
+        }
+
+        // All of the body has been read
+        bool finished()
+        {
+            if (chunked) read_framing();
+            return (state == CHUNK_DONE);
+        }
+
+        // Can we tell where this body ends? If not, the socket can't be reused.
+        bool delimited()
+        {
+            return chunked || (remaining >= 0);
+        }
+
+        int available()
+        {
+            if (!source) return 0;
+
+            if (chunked) read_framing();
+            if (state != CHUNK_DATA) return 0;
+
+            long available = source->available();
+            return (remaining < 0) ? available : min(available, remaining);
+        }
+
+        int read()
+        {
+            if (available() <= 0) return -1;
+
+            int c = source->read();
+            bytes_read++;
+
+            if (remaining > 0 && --remaining == 0) {
+                state = chunked ? CHUNK_DATA_END : CHUNK_DONE;
+            }
+
+            return c;
+        }
+
+        int peek()
+        {
+            return (available() > 0) ? source->peek() : -1;
+        }
+
+        size_t write(uint8_t c)
+        {
+            return 0; // read only
+        }
+
+        // Read and discard whatever is left of the body. False if it didn't arrive in time.
+        bool drain(unsigned long timeout_ms)
+        {
+            if (!delimited()) return false;
+
+            unsigned long start = millis();
+            while (!finished())
+            {
+                if (available() > 0) {
+                    read();
+                } else if ( (millis() - start) > timeout_ms ) {
+                    return false;
+                } else {
+                    yield();
+                }
+            }
+
+            return true;
+        }
+
+}; // end HttpBodyStream
+
+
+/*--------------------------- IOT ENDPOINT CONNECTION -----------------------------*/
+/*
+ * Keeps one HTTP/1.1 keep-alive socket open to the IoT endpoint host, so each feed request
+ * doesn't pay for a DNS lookup and a TCP handshake. If a kept-alive socket turns out to have
+ * been closed by the server, the request is retried once on a fresh connection.
+ *
+ * The request is a state machine (connect, send, status line, headers) advanced by poll(),
+ * so the main loop can keep the display animating while a response trickles in. Only the
+ * connect step blocks, as DNS lookups and TCP handshakes are synchronous in the core. With
+ * the kept-alive socket that's only the first request, or after the server dropped it.
+ * get() runs the same steps to completion, for when there's nothing else to do (i.e. setup).
+ *
+ * Latency (request start until the response headers are in) is tracked separately for
+ * requests that reused the socket and those that had to connect, so the gain can be seen
+ * with the 'xc' serial command. 'xk' turns reuse off, to compare on the same unit.
+ *
+ * How each request went is reported to endpointPool, which picks the host for the next one.
+ */
+#define IOT_ENDPOINT_PORT           80
+#define IOT_RESPONSE_TIMEOUT_MS     8000
+#define IOT_DRAIN_TIMEOUT_MS        100     // Only the end of the chunk framing should be left
+#define IOT_HEADER_LINE_LENGTH      128
+
+struct IoTLatencyStats
+{
+    unsigned long   requests;
+    unsigned long   total_ms;
+    unsigned long   last_ms;
+    unsigned long   max_ms;
+
+    void record(unsigned long ms)
+    {
+        requests++;
+        total_ms   += ms;
+        last_ms     = ms;
+        max_ms      = max(max_ms, ms);
+    }
+
+    unsigned long average_ms() { return requests ? (total_ms / requests) : 0; }
+};
+
+// Response bodies, to compare with and without compression ('xz')
+struct IoTTransferStats
+{
+    unsigned long   responses;
+    unsigned long   wire_bytes;
+    unsigned long   body_bytes;     // After inflating
+    unsigned long   transfer_ms;    // Headers in until end(), so parsing as it arrives is included
+    unsigned long   inflate_us;
+
+    void record(unsigned long wire, unsigned long body, unsigned long ms, unsigned long us)
+    {
+        responses++;
+        wire_bytes  += wire;
+        body_bytes  += body;
+        transfer_ms += ms;
+        inflate_us  += us;
+    }
+
+    void print(const __FlashStringHelper *name)
+    {
+        unsigned long n = responses ? responses : 1;
+        Serial.print(name);
+        Serial.printf_P(PSTR("%lu responses, avg %lu bytes on the wire, %lu bytes of body, %lu ms, %lu us inflating\r\n"),
+            responses, wire_bytes/n, body_bytes/n, transfer_ms/n, inflate_us/n);
+    }
+};
+
+enum IoTRequestState { IOT_IDLE, IOT_CONNECT, IOT_SEND, IOT_STATUS_LINE, IOT_HEADERS, IOT_BODY, IOT_FAILED };
+
+class IoTConnection : public FeedTransport {
+
+    private:
+        WiFiClient      &client;
+        HttpBodyStream  body;
+        InflateStream   inflater;
+        bool            inflating           = false;
+        bool            inflate_failed      = false;    // Of the last response
+
+        char            connected_host[65]  = {0};
+        char            host[65]            = {0};
+        String          request;                    // All of it, ready to write
+
+        IoTRequestState state               = IOT_IDLE;
+        int             status_code         = 0;    // Or a negative HTTPC_ERROR_*
+        bool            was_connected       = false;
+        bool            retried             = false;
+
+        // From the response headers
+        bool            chunked             = false;
+        bool            server_close        = false;
+        long            content_length      = -1;
+        char            encoding[12]        = {0};  // Content-Encoding
+
+        char            line[IOT_HEADER_LINE_LENGTH];
+        size_t          line_length         = 0;
+
+        unsigned long   start_ms            = 0;
+        unsigned long   sent_ms             = 0;
+        unsigned long   body_start_ms       = 0;
+        unsigned long   last_progress_ms    = 0;
+
+        void fail(int error)
+        {
+            status_code = error;
+            state       = IOT_FAILED;
+
+            endpointPool.report(host, status_code, millis() - start_ms, millis());
+
+            client.stop();
+            connected_host[0] = '\0';
+        }
+
+        // The kept-alive socket had been closed by the server. Start again on a new one, once.
+        bool retry()
+        {
+            if (!was_connected || retried) return false;
+
+            Sprintln(F("[HTTP] Kept-alive connection was dropped. Reconnecting."));
+            reconnects++;
+
+            client.stop();
+            connected_host[0] = '\0';
+
+            retried         = true;
+            was_connected   = false;
+            state           = IOT_CONNECT;
+            return true;
+        }
+
+        void header_line()
+        {
+            line[line_length] = '\0';
+
+            if (state == IOT_STATUS_LINE) // i.e. "HTTP/1.1 200 OK"
+            {
+                char *code  = strchr(line, ' ');
+                status_code = code ? atoi(code + 1) : 0;
+
+                if (status_code <= 0) {
+                    fail(HTTPC_ERROR_NO_HTTP_SERVER);
+                    return;
+                }
+
+                if (strncmp(line, "HTTP/1.0", 8) == 0) server_close = true;
+                state = IOT_HEADERS;
+                return;
+            }
+
+            if (line_length == 0) { // Blank line, the body follows
+                headers_done();
+                return;
+            }
+
+            char *value = strchr(line, ':');
+            if (!value) return;
+
+            *value++ = '\0';
+            while (*value == ' ') value++;
+
+            if      (strcasecmp(line, "Content-Length")    == 0)  content_length  = atol(value);
+            else if (strcasecmp(line, "Transfer-Encoding") == 0)  chunked         = (strcasecmp(value, "chunked") == 0);
+            else if (strcasecmp(line, "Connection")        == 0)  server_close    = (strcasecmp(value, "close")   == 0);
+            else if (strcasecmp(line, "Content-Encoding")  == 0)  strlcpy(encoding, value, sizeof(encoding));
+            else if (strcasecmp(line, "Content-Type")      == 0)  msgpack_response = (strstr(value, "msgpack") != nullptr);
+            else if (strcasecmp(line, "ETag")              == 0)  strlcpy(etag,          value, sizeof(etag));
+            else if (strcasecmp(line, "Last-Modified")     == 0)  strlcpy(last_modified, value, sizeof(last_modified));
+        }
+
+        void headers_done()
+        {
+            if (was_connected) {
+                reused.record(millis() - start_ms);
+            } else {
+                fresh.record(millis() - start_ms);
+            }
+
+            endpointPool.report(host, status_code, millis() - sent_ms, millis());
+
+            bool no_body = (status_code == HTTP_CODE_NO_CONTENT || status_code == HTTP_CODE_NOT_MODIFIED);
+
+            body.begin(client, chunked, no_body ? 0 : content_length);
+            body.setTimeout(IOT_RESPONSE_TIMEOUT_MS);
+
+            // Inflated on the way to the parser, refer to InflateStream.hpp
+            bool gzip   = (strcasecmp(encoding, "gzip")    == 0);
+            inflating   = !no_body && (gzip || strcasecmp(encoding, "deflate") == 0);
+            if (inflating) {
+                inflater.begin(body, gzip);
+                inflater.setTimeout(IOT_RESPONSE_TIMEOUT_MS);
+            }
+
+            body_start_ms = millis();
+
+            state = IOT_BODY;
+        }
+
+    public:
+        bool            keep_alive = true;
+        bool            msgpack    = FEED_MSGPACK_MODE;    // Ask for MessagePack, refer to MsgPackStreamParser.hpp
+        bool            compress   = FEED_COMPRESS_MODE;   // Accept gzip / deflate, refer to InflateStream.hpp
+
+        IoTTransferStats plain;
+        IoTTransferStats compressed;
+        unsigned long   inflate_failures = 0;
+
+        IoTLatencyStats reused;     // Sent on an already open socket
+        IoTLatencyStats fresh;      // Had to look up the host and connect first
+        unsigned long   reconnects = 0;
+
+        IoTConnection(WiFiClient &_client) : client(_client) { }
+
+        // Nothing is sent until poll()
+        void begin(const char *_host, const String &path, ConditionalGetEntry *validator = nullptr)
+        {
+            // New host (i.e. we've failed over), or something unexpected waiting on the socket.
+            if ( !keep_alive || strcmp(_host, connected_host) != 0 || client.available() > 0 ) {
+                client.stop();
+                connected_host[0] = '\0';
+            }
+
+            strlcpy(host, _host, sizeof(host));
+            Sprint(F("> Getting JSON data from URL: http://")); Sprint(host); Sprintln(path);
+
+            request.reserve(path.length() + 256);
+            request  = "GET " + path + (keep_alive ? " HTTP/1.1\r\n" : " HTTP/1.0\r\n");
+            request += "Host: " + String(host) + "\r\n";
+            request += F("User-Agent: RetroTicker/2.0 (ESP)\r\n");
+            request += keep_alive ? F("Connection: keep-alive\r\n") : F("Connection: close\r\n");
+            if (msgpack)  request += F("Accept: application/msgpack, application/json;q=0.5\r\n");
+            if (compress) request += F("Accept-Encoding: gzip, deflate\r\n");
+
+            if (validator && validator->has_validator()) {
+                if (validator->etag[0])          request += "If-None-Match: "     + String(validator->etag)          + "\r\n";
+                if (validator->last_modified[0]) request += "If-Modified-Since: " + String(validator->last_modified) + "\r\n";
+            }
+
+            request += "\r\n";
+
+            status_code         = 0;
+            retried             = false;
+            chunked             = false;
+            server_close        = !keep_alive;
+            content_length      = -1;
+            encoding[0]         = '\0';
+            inflate_failed      = false;
+            line_length         = 0;
+            etag[0]             = '\0';
+            last_modified[0]    = '\0';
+            msgpack_response    = false;
+
+            begin_telemetry();
+
+            was_connected       = client.connected();
+            state               = was_connected ? IOT_SEND : IOT_CONNECT;
+            start_ms            = millis();
+            last_progress_ms    = start_ms;
+        }
+
+        // Still connecting, sending or waiting on headers?
+        bool in_progress()
+        {
+            return (state != IOT_IDLE && state != IOT_BODY && state != IOT_FAILED);
+        }
+
+        // Do as much of the request as can be done in budget_ms without waiting on the
+        // network. Returns true while it's still in progress.
+        bool poll(unsigned long budget_ms)
+        {
+            unsigned long poll_start = millis();
+
+            while ( in_progress() && (millis() - poll_start) < budget_ms )
+            {
+                switch (state)
+                {
+                    case IOT_CONNECT:
+                    {
+                        // Looked up here rather than in connect(), to time it on its own
+                        IPAddress       address;
+                        unsigned long   phase_start = millis();
+
+                        if ( !WiFi.hostByName(host, address) ) {
+                            fail(HTTPC_ERROR_CONNECTION_FAILED);
+                            break;
+                        }
+                        telemetry.dns_ms += millis() - phase_start;
+                        phase_start = millis();
+
+                        if ( !client.connect(address, IOT_ENDPOINT_PORT) ) {
+                            fail(HTTPC_ERROR_CONNECTION_FAILED);
+                            break;
+                        }
+                        telemetry.connect_ms += millis() - phase_start;
+
+                        strlcpy(connected_host, host, sizeof(connected_host));
+                        client.setNoDelay(true);
+                        state = IOT_SEND;
+                        break;
+                    }
+
+                    case IOT_SEND:
+                        if ( client.write((const uint8_t *) request.c_str(), request.length()) != request.length() ) {
+                            if (!retry()) fail(HTTPC_ERROR_SEND_HEADER_FAILED);
+                            break;
+                        }
+                        last_progress_ms    = millis();
+                        sent_ms             = last_progress_ms;
+                        state               = IOT_STATUS_LINE;
+                        break;
+
+                    case IOT_STATUS_LINE:
+                    case IOT_HEADERS:
+                        if (client.available() > 0)
+                        {
+                            char c = client.read();
+                            last_progress_ms = millis();
+
+                            if (first_byte_ms == 0) {
+                                first_byte_ms       = last_progress_ms;
+                                telemetry.ttfb_ms   = first_byte_ms - sent_ms;
+                            }
+
+                            if (c == '\n') {
+                                header_line();
+                                line_length = 0;
+                            } else if (c != '\r' && line_length < (sizeof(line)-1)) {
+                                line[line_length++] = c;
+                            }
+                        }
+                        else if (!client.connected())
+                        {
+                            // Nothing at all back on a reused socket means the server had closed it
+                            bool nothing_back = (state == IOT_STATUS_LINE && line_length == 0);
+                            if ( !(nothing_back && retry()) ) fail(HTTPC_ERROR_CONNECTION_LOST);
+                        }
+                        else if ( (millis() - last_progress_ms) > IOT_RESPONSE_TIMEOUT_MS )
+                        {
+                            fail(HTTPC_ERROR_READ_TIMEOUT);
+                        }
+                        else
+                        {
+                            return true; // Nothing to do until more arrives
+                        }
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+
+            return in_progress();
+        }
+
+        int status()
+        {
+            return status_code;
+        }
+
+        Stream& stream()
+        {
+            if (inflating) return inflater;
+            return body;
+        }
+
+        bool body_failed()
+        {
+            return inflate_failed || (inflating && inflater.failed());
+        }
+
+        // Finished with this response. The rest of the body is consumed so the socket can be reused.
+        void end()
+        {
+            bool reusable = (state == IOT_BODY) && keep_alive && !server_close && body.drain(IOT_DRAIN_TIMEOUT_MS);
+
+            end_ms          = millis();
+            telemetry.bytes = (state == IOT_BODY) ? body.bytes_read : 0;
+
+            if (state == IOT_BODY)
+            {
+                if (inflating) {
+                    compressed.record(body.bytes_read, inflater.body_bytes(), millis() - body_start_ms, inflater.inflate_us);
+                } else {
+                    plain.record(body.bytes_read, body.bytes_read, millis() - body_start_ms, 0);
+                }
+            }
+
+            // Most likely compressed with a bigger window than we have, and the proxy will do the
+            // same again. Without compression from here on, like the other fallbacks.
+            if (inflating && inflater.failed()) {
+                Sprintln(F("[Inflate] Response didn't inflate. Turning compression off."));
+                inflate_failed = true;
+                inflate_failures++;
+                compress = false;
+            }
+
+            if (inflating) {
+                inflater.end();
+                inflating = false;
+            }
+
+            if (!reusable) {
+                client.stop();
+                connected_host[0] = '\0';
+            }
+
+            state = IOT_IDLE;
+        }
+
+        void printStats()
+        {
+            Serial.printf_P(PSTR("Keep-alive: %s, reconnects: %lu\r\n"), keep_alive ? "on":"off", reconnects);
+            Serial.printf_P(PSTR("Reused socket:  %lu requests, avg %lu ms, max %lu ms, last %lu ms\r\n"), reused.requests, reused.average_ms(), reused.max_ms, reused.last_ms);
+            Serial.printf_P(PSTR("New connection: %lu requests, avg %lu ms, max %lu ms, last %lu ms\r\n"),  fresh.requests, fresh.average_ms(), fresh.max_ms, fresh.last_ms);
+            Serial.printf_P(PSTR("Compression: %s, failed to inflate: %lu\r\n"), compress ? "on":"off", inflate_failures);
+            plain.print(F("Plain:      "));
+            compressed.print(F("Compressed: "));
+        }
+
+}; // end IoTConnection
+
+IoTConnection iotConnection(client);
+
+#endif
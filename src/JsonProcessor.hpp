@@ -5,21 +5,12 @@
 #include <list>
 #include <string>
 #include <TimeLib2.hpp>
+#include "FeedBuffer.hpp"
+#include "FeedText.hpp"
+#include "TickerTable.hpp"
 
 //extern TimeLib2 clockMain;
 
-struct TickerInstance
-{
-    char name[64];     
-    char code[16];
-    char  currency_code[4];
-    float price_reporting_ccy;
-    float percent_change_24h;
-    float price_change_24h;
-    char parola_currency_code[2];
-    char parola_upordown_code[2];
-};
-
 // New - Weather instances (current and forecast)
 struct WeatherInstance
 {
@@ -36,39 +27,101 @@ struct WeatherInstance
 };
 
 // Current Weather
-WeatherInstance CurrentWeather;
-std::string CurrentWeather_str;
+struct CurrentWeatherData
+{
+    WeatherInstance weather;
+    std::string     text;
+};
 
-// Weather Forecasts
-std::list<std::string> WeatherForecasts_str; // X items
-std::list<WeatherInstance> WeatherForecasts; // X items
+// Weather Forecasts, 6 days at most. Turned into text as they're shown, refer to FeedRender.hpp.
+struct ForecastData
+{
+    std::list<WeatherInstance>  items;
+};
+
+// Crypto and Equities, likewise
+typedef TickerTable                     TickerData;
 
-// Crypto
-std::list<std::string> CryptoTicker_str;
-std::list<TickerInstance> CryptoTickers;
+// News Headlines, up to the largest limit on the config page (50). Refer to FeedText.hpp.
+typedef FeedText<4096, 50>              HeadlineData;
+#define NEWS_FEED_SLOTS                 3       // Allocated at boot, refer to FeedBuffer.hpp
 
-// Equities 
-std::list<std::string> EquitiesTicker_str;
-std::list<TickerInstance> EquitiesTickers;
+// Published generation of each feed, refer to FeedBuffer.hpp
+FeedBuffer<CurrentWeatherData>  CurrentWeatherFeed;
+FeedBuffer<ForecastData>        WeatherForecastFeed;
+FeedBuffer<TickerData>          CryptoFeed;
+FeedBuffer<TickerData>          EquitiesFeed;
+FeedBuffer<HeadlineData>        NewsFeed(NEWS_FEED_SLOTS);
 
-// News Headlines
-std::list<std::string> NewsHeadlines_str; // 10 items
 
+// String storage we allow for the member names of a filtered document (ArduinoJson de-duplicates
+// these, so it is paid once per document, not once per data[] element).
+#define JSON_FILTER_KEY_BYTES 96
 
 class JsonProcessor {
 
     private:
 
     public:
-        virtual bool process_json_document(DynamicJsonDocument &doc);
+        virtual bool process_json_document(DynamicJsonDocument &doc) = 0;
+
+        /* Declare the fields this processor reads from the IoT proxy response as an ArduinoJson
+         * filter. Anything not listed here is discarded while the stream is deserialized, so the
+         * document only needs to be big enough for what we actually use.
+         * https://arduinojson.org/v6/how-to/deserialize-a-very-large-document/
+         */
+        virtual void build_filter(JsonDocument &filter) = 0;
+
+        // Most data[] elements we expect, and the string bytes (values only) each one can hold.
+        virtual size_t max_items()              { return 1;  }
+        virtual size_t max_item_string_bytes()  { return 64; }
+
+        // Size a JsonDocument from the filter, rather than guessing at 8000 bytes for everything.
+        size_t document_capacity(JsonDocument &filter)
+        {
+            JsonVariant data = filter["data"];
+            size_t capacity  = JSON_OBJECT_SIZE(filter.size()) + JSON_FILTER_KEY_BYTES;
+
+            if (data.is<JsonArray>()) {
+                capacity += JSON_ARRAY_SIZE(max_items());
+                capacity += max_items() * ( JSON_OBJECT_SIZE(data[0].size()) + max_item_string_bytes() );
+            } else {
+                capacity += JSON_OBJECT_SIZE(data.size()) + max_item_string_bytes();
+            }
+
+            return capacity;
+        }
+
+        // Size a JsonDocument for a single data[] element (streaming mode).
+        size_t item_capacity(JsonVariant item_filter)
+        {
+            return JSON_OBJECT_SIZE(item_filter.size()) + max_item_string_bytes() + JSON_FILTER_KEY_BYTES;
+        }
+
+        /* Streaming mode, refer to JsonStreamParser.hpp. The whole document is never held in
+         * memory: begin_items() is called first, then process_json_item() for each data[] element
+         * as soon as it has arrived, and finally end_items() once 'cod' is known.
+         *
+         * Items go into the feed's back buffer, which end_items() only publishes if 'cod' says
+         * the response was good (refer to FeedBuffer.hpp).
+         */
+        virtual bool supports_streaming()               { return false; }
+        virtual void begin_items()                      { }
+        virtual void process_json_item(JsonObject item) { }
+        virtual bool end_items(int cod)                 { return (cod != 0); }
+
+        // Can the proxy answer with a 304 Not Modified? Refer to ConditionalGet.hpp.
+        virtual bool conditional_get()                  { return true; }
 
 };
 
 class CurrentWeatherProcessor : public JsonProcessor {
 
     private:
-        WeatherInstance weather;    
-        time_t gmt_offset;
+        WeatherInstance     weather;    
+        time_t              gmt_offset;
+        CurrentWeatherData  *data = nullptr;   // Back buffer
+        bool                no_room = false;   // Couldn't begin one
 
     public:
         void set_gmt_offset(time_t offset)
@@ -76,6 +129,23 @@ class CurrentWeatherProcessor : public JsonProcessor {
             gmt_offset = offset;
         }
 
+        void build_filter(JsonDocument &filter)
+        {
+            filter["cod"] = true;
+
+            JsonObject item = filter.createNestedArray("data").createNestedObject();
+            item["dt"]          = true;
+            item["id"]          = true;
+            item["name"]        = true;
+            item["humidity"]    = true;
+            item["temp"]        = true;
+            item["icon_day"]    = true;
+            item["summary"]     = true;
+            item["description"] = true;
+        }
+
+        size_t max_item_string_bytes() { return 128; }
+
         bool process_json_document(DynamicJsonDocument &doc)
         {
 
@@ -105,14 +175,38 @@ class CurrentWeatherProcessor : public JsonProcessor {
             int cod = doc["cod"];
             if (!cod) return false;
 
+            begin_items();
 
             JsonArray array = doc["data"].as<JsonArray>();
             for (JsonObject item : array)
             {
+                process_json_item(item);
+            }
+
+            return end_items(cod);
+
+        } // processTickerData
+
+        void begin_items()
+        {
+            data    = nullptr;
+            no_room = false;
+        }
+
+        // Only the first data[] element is of interest.
+        void process_json_item(JsonObject item)
+        {
+                    if (data || no_room) return;
+                    data = CurrentWeatherFeed.begin();
+                    if (!data) {
+                        no_room = true;
+                        return;
+                    }
+
                     weather.datetime                = item["dt"].as<long>(); 
                     weather.datetime_tzadjusted     = weather.datetime + gmt_offset;                           
 
-                    snprintf_P(weather.city_id, sizeof(weather.city_id), "%ld", doc["id"].as<long>());                                             
+                    snprintf_P(weather.city_id, sizeof(weather.city_id), "%ld", item["id"].as<long>());                                             
 
                     const char* city_name = item["name"];
                     Sprintln(city_name);
@@ -135,18 +229,23 @@ class CurrentWeatherProcessor : public JsonProcessor {
                     char temp[128]= {0};  // hack
                     snprintf_P(temp, sizeof(temp), "Current Weather in %s \x10 %s and %d\xB0.", weather.city_name, weather.description, weather.temp_now);
 
-                    // CurrentWeather_str.empty();
-                    CurrentWeather_str = temp; // http://www.cplusplus.com/forum/general/48362/ 
+                    data->text      = temp; // http://www.cplusplus.com/forum/general/48362/ 
+                    data->weather   = weather;
 
-                    // Empty it
-                    CurrentWeather = weather;
+        } // process_json_item
 
-                    break;
+        // Nothing to publish without an item, keep the last weather we had
+        bool end_items(int cod)
+        {
+            if (cod && data) {
+                CurrentWeatherFeed.publish();
+            } else {
+                CurrentWeatherFeed.discard();
             }
 
-            return true;
-
-        } // processTickerData
+            data = nullptr;
+            return (cod != 0 && !no_room);
+        }
 
 }; // end CurrentWeatherProcessor
 
@@ -155,6 +254,7 @@ class ForecastWeatherProcessor : public JsonProcessor {
 
     private:
         WeatherInstance weather; 
+        ForecastData    *data           = nullptr;  // Back buffer
         int     forecast_count  = 0;   // Apparently forward_list doesn't have a size function..
         int     previous_forecast_day_of_month  = -1;  
         time_t  gmt_offset;             
@@ -165,12 +265,51 @@ class ForecastWeatherProcessor : public JsonProcessor {
             gmt_offset = offset;
         }
 
-        bool process_json_document(DynamicJsonDocument &doc)
+        void build_filter(JsonDocument &filter)
         {
+            filter["cod"] = true;
+
+            JsonObject item = filter.createNestedArray("data").createNestedObject();
+            item["dt"]          = true;
+            item["id"]          = true;
+            item["name"]        = true;
+            item["humidity"]    = true;
+            item["temp"]        = true;
+            item["icon_day"]    = true;
+            item["summary"]     = true;
+            item["description"] = true;
+        }
 
+        // 5 days of 3 hourly forecasts. City name and icon values repeat, so are only stored once.
+        size_t max_items()              { return 40; }
+        size_t max_item_string_bytes()  { return 48; }
+
+        bool supports_streaming() { return true; }
+
+        void begin_items()
+        {
             forecast_count = 0;
-            WeatherForecasts_str.clear();
-            WeatherForecasts.clear(); // get rid of struct 
+            previous_forecast_day_of_month = -1;
+            data = WeatherForecastFeed.begin();
+        }
+
+        // No back buffer (no room for one) fails the parse
+        bool end_items(int cod)
+        {
+            bool ok = (cod != 0 && data);
+
+            if (ok) {
+                WeatherForecastFeed.publish();
+            } else {
+                WeatherForecastFeed.discard();
+            }
+
+            data = nullptr;
+            return ok;
+        }
+
+        bool process_json_document(DynamicJsonDocument &doc)
+        {
                         
             /*
                 {
@@ -208,14 +347,26 @@ class ForecastWeatherProcessor : public JsonProcessor {
             int cod = doc["cod"];
             if (!cod) return false;
 
+            begin_items();
 
             JsonArray array = doc["data"].as<JsonArray>();
             for (JsonObject item : array)
             {
+                process_json_item(item);
+            } // iterate through array item
+
+            return end_items(cod);
+
+        } // processTickerData
+
+        void process_json_item(JsonObject item)
+        {
+                    if (!data) return;
+
                     weather.datetime    = item["dt"].as<long>();         
                     weather.datetime_tzadjusted     = weather.datetime + gmt_offset;                                                 
 
-                    snprintf_P(weather.city_id, sizeof(weather.city_id), "%ld", doc["id"].as<long>());                                             
+                    snprintf_P(weather.city_id, sizeof(weather.city_id), "%ld", item["id"].as<long>());                                             
 
                     const char* city_name = item["name"];
                    
@@ -237,46 +388,32 @@ class ForecastWeatherProcessor : public JsonProcessor {
                     //
                     // Now check to see if we want to process and store this weather forecast?
                     //
-                    int forecast_day_of_week           = clockMain.weekday(weather.datetime_tzadjusted);   // the weekday (Sunday is day 1) 
                     int forecast_day_of_month          = clockMain.day(weather.datetime_tzadjusted);      // the day of month (first day of the month is 1, not 0 :-) )
 
                     // Get the first forecast of the afternoon each day, and not for the remainder of today.
                     
                     if ( clockMain.day() == forecast_day_of_month ) {
                         Sprintln (F("Skipping forecast: Current day"));    
-                        continue;
+                        return;
                     } else if ( clockMain.isAM(weather.datetime_tzadjusted) ) {
                         Sprintln ( F("Skipping forecast: Morning time") ); 
-                        continue;
+                        return;
                     } else if ( previous_forecast_day_of_month == forecast_day_of_month ) {
                         Sprintln ( F("Skipping forecast: Already covered this day.") );  
-                        continue;
+                        return;
                     } else if (forecast_count++ > 5) {
                         Sprintln(F("Forecast beyond our horizon - ignoring..."));
-                        continue;     
+                        return;     
                     
                     }
 
                     previous_forecast_day_of_month = forecast_day_of_month;
 
-                    char temp[128] = {0};  // hack   
-                    std::string s;
-                    if ( (clockMain.day() + 1) ==  forecast_day_of_month ) { // is the forecast for tomrrow?
-                        snprintf_P(temp, sizeof(temp), "Tomorrow \x10 %s and %d\xB0.", weather.description, weather.temp_now);
-                    } else {
-                        snprintf_P(temp, sizeof(temp), "%s \x10 %s and %d\xB0.", dayStr(forecast_day_of_week), weather.description, weather.temp_now);    
-                    }
-                    s = temp;
-                    Sprint("== "); Sprintln(temp);
-
-                    WeatherForecasts_str.push_back(temp); // add compiled string to list
-                    WeatherForecasts.push_back(weather); // add the raw forecast
+                    Sprint("== "); Sprintln(weather.description);
 
-            } // iterate through array item
-
-            return true;
+                    data->items.push_back(weather); // add the raw forecast
 
-        } // processTickerData
+        } // process_json_item
 
 }; 
 
@@ -284,11 +421,49 @@ class ForecastWeatherProcessor : public JsonProcessor {
 class NewsProcessor : public JsonProcessor {
 
     private:         
+        unsigned int limit = 0;     // 0 = keep everything the proxy sends
+        unsigned int count = 0;
+        HeadlineData *data = nullptr;  // Back buffer
 
     public:
+        void set_limit(unsigned int _limit) {
+            limit = _limit;
+        }
+
+        void build_filter(JsonDocument &filter)
+        {
+            filter["cod"] = true;
+            filter.createNestedArray("data").createNestedObject()["title"] = true;
+        }
+
+        size_t max_items()              { return 20;  }
+        size_t max_item_string_bytes()  { return 128; }
+
+        bool supports_streaming() { return true; }
+
+        void begin_items()
+        {
+            count = 0;
+            data  = NewsFeed.begin();
+        }
+
+        // No back buffer (all NEWS_FEED_SLOTS still held) fails the parse
+        bool end_items(int cod)
+        {
+            bool ok = (cod != 0 && data);
+
+            if (ok) {
+                NewsFeed.publish();
+            } else {
+                NewsFeed.discard();
+            }
+
+            data = nullptr;
+            return ok;
+        }
+
         bool process_json_document(DynamicJsonDocument &doc)
         {
-            NewsHeadlines_str.clear();
 
             /*
                 {
@@ -325,27 +500,33 @@ class NewsProcessor : public JsonProcessor {
             int cod = doc["cod"];
             if (!cod) return false;
 
+            begin_items();
 
             JsonArray array = doc["data"].as<JsonArray>();
             for (JsonObject item : array)
             {
-                const char* headline = item["title"];
-
-                //const char* feed = item["feed_code"];
-
-                if (headline)
-                {
-                  //  Sprint(feed); Sprint(": ");
-                    Sprintln(headline);
-                    std::string tmp = "\x7 " + (std::string) headline;
-                    NewsHeadlines_str.push_front(tmp);                       
-                }
-            
+                process_json_item(item);
             } // iterate through array item
 
-            return true;            
+            return end_items(cod);
 
         } // processTickerData
+
+        void process_json_item(JsonObject item)
+        {
+            const char* headline = item["title"];
+
+            //const char* feed = item["feed_code"];
+
+            if (data && headline && (limit == 0 || count < limit))
+            {
+              //  Sprint(feed); Sprint(": ");
+                Sprintln(headline);
+                data->push_front(headline, "\x7 ");
+                count++;
+            }
+
+        } // process_json_item
 };  // end processor
 
 
@@ -353,25 +534,59 @@ class TickerProcessor : public JsonProcessor {
 
     private:
         bool crypto_mode = false;
-        TickerInstance ticker;
+        TickerData *data = nullptr;    // Back buffer
         int count = 0;       
 
+        FeedBuffer<TickerData>& feed()
+        {
+            return crypto_mode ? CryptoFeed : EquitiesFeed;
+        }
+
     public:
         void set_crypto_mode(bool mode) {
             crypto_mode = mode;
         }
 
-        bool process_json_document(DynamicJsonDocument &doc)
+        void build_filter(JsonDocument &filter)
+        {
+            filter["cod"] = true;
+
+            JsonObject item = filter.createNestedArray("data").createNestedObject();
+            item["name"]                = true;
+            item["code"]                = true;
+            item["price_reporting_ccy"] = true;
+            item["percent_change_24h"]  = true;
+            item["price_change_24h"]    = true;
+            item["feed_reporting_ccy"]  = true;
+        }
+
+        // TickerConfig only holds 6 crypto and 6 stock symbols.
+        size_t max_items()              { return 6;  }
+        size_t max_item_string_bytes()  { return 48; }
+
+        void begin_items()
         {
             count = 0;
+            data  = feed().begin();
+        }
 
-            if (crypto_mode) {  
-                CryptoTicker_str.clear(); // list of strings
-                CryptoTickers.clear(); // list of objects
+        // No back buffer (no room for one) fails the parse
+        bool end_items(int cod)
+        {
+            bool ok = (cod != 0 && data);
+
+            if (ok) {
+                feed().publish();
             } else {
-                EquitiesTicker_str.clear(); // list of strings
-                EquitiesTickers.clear(); // list of objects
+                feed().discard();
             }
+
+            data = nullptr;
+            return ok;
+        }
+
+        bool process_json_document(DynamicJsonDocument &doc)
+        {
                         
             /*
                 {
@@ -394,82 +609,35 @@ class TickerProcessor : public JsonProcessor {
             int cod = doc["cod"];
             if (!cod) return false;
 
+            begin_items();
 
             JsonArray array = doc["data"].as<JsonArray>();
             for (JsonObject item : array)
             {
-                    // name
-                    const char* name = item["name"];
-                    if (name)
-                        strncpy(ticker.name, name, sizeof(ticker.name));
-
-                    // symbol
-                    const char* code = item["code"];
-                    if (code)
-                        strncpy(ticker.code, code, sizeof(ticker.code));
-
-                    // price_reporting_ccy
-                    float price_reporting_ccy = item["price_reporting_ccy"];
-                    if (price_reporting_ccy)
-                        ticker.price_reporting_ccy = price_reporting_ccy;
-
-                    // percent_change_24h
-                    float percent_change_24h = item["percent_change_24h"];
-                    if (percent_change_24h)
-                        ticker.percent_change_24h = percent_change_24h;
-
-                    // price_change_24h
-                    float price_change_24h = item["price_change_24h"];
-                    if (price_change_24h)
-                        ticker.price_change_24h = price_change_24h;
-
-
-                    const char* feed_reporting_ccy = item["feed_reporting_ccy"];
-                    if (feed_reporting_ccy)
-                        strncpy(ticker.currency_code, feed_reporting_ccy, sizeof(ticker.currency_code));
-
+                process_json_item(item);
+            } // iterate through array item
 
-                    // 
-                    // Now process item
-                    //            
-                    Sprintln(F("Processing ticker."));
+            return end_items(cod);
 
-                    memset(ticker.parola_upordown_code, '\0', sizeof(ticker.parola_upordown_code));
-                    memset(ticker.parola_currency_code, '\0', sizeof(ticker.parola_currency_code));
+        } // processTickerData
 
-                    ticker.parola_upordown_code[0] = (ticker.percent_change_24h > 0) ? 0x18:0x19;
+        void process_json_item(JsonObject item)
+        {
+                    if (!data) return;
 
-                    if ( strcmp(ticker.currency_code, "EUR") == 0 ) {
-                    ticker.parola_currency_code[0]   = (char)128;  //   5, 62, 85, 85, 85, 65,		// 128 - 'Euro symbol'   
-                    } else if ( strcmp(ticker.currency_code, "GBP") == 0 ) {
-                        ticker.parola_currency_code[0] = (char)163;    // 4, 68, 126, 69, 65,		// 163 - '£ Pound sign'
-                    } else
-                    {
-                        ticker.parola_currency_code[0] = (char)'$';    
+                    const char* name = item["name"];
+                    int row = data->add( name, item["code"], item["feed_reporting_ccy"],
+                                         item["price_reporting_ccy"], item["percent_change_24h"], item["price_change_24h"] );
+                    if (row < 0) {
+                        Sprintln(F("Ticker table full - ignoring..."));
+                        return;
                     }
 
-
-                    char temp[128];  // hack  
-                    // Refer to https://github.com/MajicDesigns/MD_MAX72XX/blob/main/src/MD_MAX72xx_font.cpp for the hex values
-                    // Currently use bullet point then right arrow.
-                    snprintf_P(temp, sizeof(temp), "\x7 %s \x16 %s%0.2lf%s  %s  %0.2lf%%", ticker.name, ticker.parola_currency_code, ticker.price_reporting_ccy, "", ticker.parola_upordown_code, ticker.percent_change_24h); 
-                    Sprintln(temp); 
-
-                    if (crypto_mode) {
-                        CryptoTicker_str.push_back(temp);   // http://www.cplusplus.com/forum/general/48362/ 
-                        CryptoTickers.push_back(ticker);  // add struct to list
-                    } else {
-                        EquitiesTicker_str.push_back(temp);   // http://www.cplusplus.com/forum/general/48362/ 
-                        EquitiesTickers.push_back(ticker);     // add struct to list
-                    }
+                    Sprint(F("Processing ticker: ")); Sprintln(name);
 
                     count++;
 
-            } // iterate through array item
-
-            return true;            
-
-        } // processTickerData
+        } // process_json_item
 
 }; 
 
@@ -489,6 +657,20 @@ class TimeProcessor : public JsonProcessor {
             timestamp = _timestamp; offset = _offset;
         }
 
+        void build_filter(JsonDocument &filter)
+        {
+            filter["cod"] = true;
+
+            JsonObject data = filter.createNestedObject("data");
+            data["timestamp"]           = true;
+            data["timestamp_offset"]    = true;
+        }
+
+        size_t max_item_string_bytes()  { return 0; }
+
+        // The timestamp is the whole point, never cached.
+        bool conditional_get()          { return false; }
+
         bool process_json_document(DynamicJsonDocument &doc)
         {
 
@@ -506,14 +688,20 @@ class TimeProcessor : public JsonProcessor {
             int cod = doc["cod"];
             if (!cod) return false;
 
-            _timestamp          = doc["data"]["timestamp"];
-            _offset             = doc["data"]["timestamp_offset"];
-
-            // The PHP should return a timezone name as well. Europe/London should be 'London'.
-           // _timezone_name      = doc["data"]["timezone_name"];
+            process_json_item(doc["data"].as<JsonObject>());
 
             return true;            
 
 
         } // processTickerData
+
+        // 'data' is a single object for this action.
+        void process_json_item(JsonObject item)
+        {
+            _timestamp          = item["timestamp"];
+            _offset             = item["timestamp_offset"];
+
+            // The PHP should return a timezone name as well. Europe/London should be 'London'.
+           // _timezone_name      = item["timezone_name"];
+        }
 };  // end processor
@@ -0,0 +1,540 @@
+#ifndef JSON_STREAM_PARSER_H
+#define JSON_STREAM_PARSER_H
+
+#include <ArduinoJson.h>
+#include "TickerDebug.hpp"
+#include "JsonProcessor.hpp"
+#include "FeedStats.hpp"
+
+/*--------------------------- STREAMING (SAX STYLE) PARSER -----------------------------*/
+/*
+ * ArduinoJson has no SAX interface, so this walks the raw byte stream itself and only
+ * tracks nesting depth and string state. The v3 IoT proxy always returns:
+ *
+ *    { "data": [ {...}, {...}, ... ], "api_version": 3, "cod": 200 }
+ *
+ * Each data[] element is copied into a small buffer as it arrives, and the moment its
+ * closing brace is seen it is deserialized (with the processor's filter) and passed to
+ * JsonProcessor::process_json_item(). Peak memory is one element, not the whole payload.
+ * If 'data' is an object rather than an array, it is handed over as a single item.
+ *
+ * It's fed one byte at a time and keeps all its state between calls, so it doesn't care
+ * how the bytes turn up.
+ *
+ * begin_items() is only called once the first item turns up (or at the end). A response of
+ * just { "cod": 304 } therefore leaves the processor's lists alone (see ConditionalGet.hpp).
+ */
+
+#define JSON_STREAM_ITEM_BUFFER 768   // Largest raw data[] element we'll accept (forecast ~350 bytes)
+#define JSON_STREAM_KEY_LENGTH  24
+#define JSON_STREAM_COD_NOT_MODIFIED 304
+
+// Tracks nesting and string state, and remembers the last member name of the root object.
+class JsonScanner {
+
+    protected:
+        int     depth           = 0;
+        bool    in_string       = false;
+        bool    escaped         = false;
+        bool    expect_key      = false;
+        bool    reading_key     = false;
+
+        char    key[JSON_STREAM_KEY_LENGTH] = {0};
+        size_t  key_length      = 0;
+
+        // Returns true if c is a structural character (i.e. not part of a string). Depth has
+        // already been adjusted for brackets and braces by the time this returns.
+        bool scan(char c)
+        {
+            if (in_string)
+            {
+                if (escaped)            { escaped = false; }
+                else if (c == '\\')     { escaped = true;  }
+                else if (c == '"')
+                {
+                    in_string = false;
+                    if (reading_key) { reading_key = false; key[key_length] = '\0'; }
+                }
+                else if (reading_key && key_length < (JSON_STREAM_KEY_LENGTH-1)) { key[key_length++] = c; }
+
+                return false;
+            }
+
+            switch (c)
+            {
+                case '"':
+                    in_string = true;
+                    if (depth == 1 && expect_key) {
+                        reading_key = true;
+                        expect_key  = false;
+                        key_length  = 0;
+                    }
+                    return false;
+
+                case '{':
+                case '[':
+                    depth++;
+                    if (depth == 1) expect_key = (c == '{');
+                    break;
+
+                case '}':
+                case ']':
+                    depth--;
+                    break;
+
+                case ',':
+                    if (depth == 1) expect_key = true;
+                    break;
+            }
+
+            return true;
+        }
+
+};
+
+
+// The processor's filter describes the whole document, we want the part for one data[] element.
+JsonVariant getItemFilter(JsonDocument &filter)
+{
+    JsonVariant data_filter = filter["data"];
+    return data_filter.is<JsonArray>() ? data_filter[0].as<JsonVariant>() : data_filter;
+}
+
+
+// Anything that is fed a response body a byte at a time (JSON or MessagePack, refer to
+// MsgPackStreamParser.hpp), so FeedFetch doesn't need to know which it's got.
+class FeedStreamer {
+
+    public:
+        size_t          bytes       = 0;    // Fed so far
+        unsigned long   parse_us    = 0;    // Time spent in feed(), see pumpJsonStream()
+
+        virtual ~FeedStreamer() { }
+
+        virtual void feed(char c)   = 0;
+        virtual bool done()         = 0;
+        virtual bool ok()           = 0;
+};
+
+
+/*
+ * The processor's side of an item streamer: each data[] element is copied into item_buffer
+ * as it arrives, then deserialized (with the processor's filter) and handed over on its own.
+ */
+class ItemStreamer : public FeedStreamer {
+
+    protected:
+        enum Member { MEMBER_OTHER, MEMBER_DATA, MEMBER_COD, MEMBER_ETAG };
+
+        JsonProcessor       &processor;
+        JsonVariant         item_filter;
+        DynamicJsonDocument item_doc;
+
+        char    *item_buffer;
+        size_t  item_length     = 0;
+        bool    capturing       = false;
+        bool    overflowed      = false;
+        int     capture_depth   = 0;
+
+        bool    data_is_array   = false;
+        bool    started         = false;    // begin_items() has been called
+
+        Member  member          = MEMBER_OTHER;
+        int     _cod            = 0;
+
+        static Member root_member(const char *key)
+        {
+            if (strcmp(key, "data") == 0)   return MEMBER_DATA;
+            if (strcmp(key, "cod")  == 0)   return MEMBER_COD;
+            if (strcmp(key, "etag") == 0)   return MEMBER_ETAG;
+            return MEMBER_OTHER;
+        }
+
+        // The element starts with c, and ends when we're back at _capture_depth.
+        void start_capture(char c, int _capture_depth)
+        {
+            capturing       = true;
+            overflowed      = false;
+            capture_depth   = _capture_depth;
+            item_length     = 0;
+            append(c);
+        }
+
+        void append(char c)
+        {
+            if (item_length < (JSON_STREAM_ITEM_BUFFER-1)) {
+                item_buffer[item_length++] = c;
+            } else {
+                overflowed = true;
+            }
+        }
+
+        void end_capture()
+        {
+            capturing = false;
+            peak_item_bytes = max(peak_item_bytes, item_length);
+
+            if (overflowed) {
+                Sprintln(F("[JSON] Stream item too large for buffer. Skipping."));
+                items_skipped++;
+                return;
+            }
+
+            item_doc.clear();
+            DeserializationError err = deserialize_item();
+            if (err) {
+                Sprint(F("[JSON] Stream item failed to parse: ")); Sprintln(err.c_str());
+                items_skipped++;
+                return;
+            }
+
+            peak_doc_usage = max(peak_doc_usage, item_doc.memoryUsage());
+            items_parsed++;
+
+            if (!started) {
+                processor.begin_items();
+                started = true;
+            }
+
+            processor.process_json_item(item_doc.as<JsonObject>());
+        }
+
+        // The captured element, into item_doc
+        virtual DeserializationError deserialize_item() = 0;
+
+    public:
+        size_t          peak_item_bytes = 0;
+        size_t          peak_doc_usage  = 0;
+        unsigned int    items_parsed    = 0;
+        unsigned int    items_skipped   = 0;
+
+        char            etag[48]        = {0};  // Root "etag" member, if any (bundle sections)
+        bool            not_modified    = false;
+
+        ItemStreamer(JsonProcessor &_processor, JsonVariant _item_filter) :
+            processor(_processor), item_filter(_item_filter), item_doc(_processor.item_capacity(_item_filter))
+        {
+            item_buffer = new char[JSON_STREAM_ITEM_BUFFER];
+        }
+
+        ~ItemStreamer()
+        {
+            delete[] item_buffer;
+        }
+
+        int     cod()           { return _cod; }
+        size_t  capacity()      { return item_doc.capacity() + JSON_STREAM_ITEM_BUFFER; }
+        size_t  peak_usage()    { return peak_doc_usage + peak_item_bytes; }
+
+        // Hand the verdict to the processor. A 304 with no items doesn't touch it at all.
+        bool finish()
+        {
+            if (ok() && _cod == JSON_STREAM_COD_NOT_MODIFIED && !started) {
+                not_modified = true;
+                return true;
+            }
+
+            if (!started) processor.begin_items();
+            return processor.end_items( ok() ? _cod : 0 );
+        }
+
+}; // end ItemStreamer
+
+
+class JsonItemStreamer : public ItemStreamer, protected JsonScanner {
+
+    private:
+        bool    completed       = false;
+        bool    error           = false;
+
+        DeserializationError deserialize_item()
+        {
+            return deserializeJson(item_doc, (const char *) item_buffer, item_length, DeserializationOption::Filter(item_filter));
+        }
+
+    public:
+        JsonItemStreamer(JsonProcessor &_processor, JsonVariant _item_filter) : ItemStreamer(_processor, _item_filter) { }
+
+        bool    done()          { return completed || error; }
+        bool    ok()            { return completed && !error; }
+
+        void feed(char c)
+        {
+            if (done()) return;
+
+            if (capturing) append(c);
+
+            bool was_in_string = in_string;
+
+            if (!scan(c))
+            {
+                // Characters between the quotes of the "etag" value
+                if (depth == 1 && member == MEMBER_ETAG && was_in_string && in_string) {
+                    size_t length = strlen(etag);
+                    if (length < (sizeof(etag)-1)) etag[length] = c;
+                }
+                return;
+            }
+
+            switch (c)
+            {
+                case '{':
+                case '[':
+                    if (depth == 2 && member == MEMBER_DATA) {
+                        if (c == '[')   data_is_array = true;
+                        else            start_capture(c, depth-1);  // 'data' is a single object
+                    } else if (depth == 3 && member == MEMBER_DATA && data_is_array && c == '{') {
+                        start_capture(c, depth-1);                  // data[] element
+                    }
+                    break;
+
+                case '}':
+                case ']':
+                    if (depth < 0) { error = true; break; }
+                    if (capturing && depth == capture_depth) end_capture();
+                    if (depth == 0) completed = true;
+                    break;
+
+                case ':':
+                    if (depth == 1) member = root_member(key);
+                    break;
+
+                case ',':
+                    if (depth == 1) member = MEMBER_OTHER;
+                    break;
+
+                default:
+                    if (depth == 1 && member == MEMBER_COD && isdigit(c)) {
+                        _cod = (_cod * 10) + (c - '0');
+                    }
+                    break;
+            }
+        }
+
+}; // end JsonItemStreamer
+
+
+/*--------------------------- BUNDLE DEMULTIPLEXER -----------------------------*/
+/*
+ * action=bundle returns every requested feed in one response, keyed by section name.
+ * Each section is exactly what the single action would have returned:
+ *
+ *    {
+ *      "weather":          { "data": [ {...} ],      "cod": 200 },
+ *      "news":             { "data": [ {...}, ... ], "cod": 200 },
+ *      ...
+ *      "api_version": 3, "cod": 200
+ *    }
+ *
+ * The bytes of each known section are forwarded to a JsonItemStreamer for that section's
+ * processor, so only one section (and one item of it) is ever in memory. Unknown members
+ * are skipped.
+ *
+ * A section may carry an "etag". Sent back as etag_<section>=... on the next request, the
+ * proxy can answer that section with just { "cod": 304 } if nothing has changed.
+ */
+struct JsonBundleSection
+{
+    const char      *name;          // Member of the bundle response, i.e. "news"
+    JsonProcessor   *processor;
+    bool            received;       // The proxy sent this section
+    bool            result;         // ... and the processor was happy with it
+    bool            not_modified;   // ... or it was a 304, and the processor wasn't touched
+    char            etag[48];       // The section's validator, if the proxy sent one
+};
+
+class JsonBundleStreamer : public FeedStreamer, protected JsonScanner {
+
+    private:
+        JsonBundleSection   *sections;
+        size_t              section_count;
+
+        JsonBundleSection   *pending    = nullptr;     // Key read, waiting for its value
+        JsonBundleSection   *active     = nullptr;
+        JsonItemStreamer    *streamer   = nullptr;
+
+        StaticJsonDocument<256> filter;
+
+        bool    completed   = false;
+        bool    error       = false;
+
+        JsonBundleSection* find_section(const char *name)
+        {
+            for (size_t i = 0; i < section_count; i++) {
+                if (strcmp(sections[i].name, name) == 0) return &sections[i];
+            }
+            return nullptr;
+        }
+
+        void start_section(char c)
+        {
+            Sprint(F("[JSON] Bundle section: ")); Sprintln(pending->name);
+
+            active  = pending;
+            pending = nullptr;
+
+            filter.clear();
+            active->processor->build_filter(filter);
+
+            streamer = new JsonItemStreamer(*active->processor, getItemFilter(filter));
+            streamer->feed(c);
+        }
+
+        void end_section()
+        {
+            active->received        = true;
+            active->result          = streamer->finish();
+            active->not_modified    = streamer->not_modified;
+            strlcpy(active->etag, streamer->etag, sizeof(active->etag));
+
+            recordFeedDocumentUsage(active->name, streamer->capacity(), streamer->peak_usage());
+
+            delete streamer;
+            streamer    = nullptr;
+            active      = nullptr;
+        }
+
+    public:
+        JsonBundleStreamer(JsonBundleSection *_sections, size_t _section_count) :
+            sections(_sections), section_count(_section_count)
+        {
+            for (size_t i = 0; i < section_count; i++) {
+                sections[i].received        = false;
+                sections[i].result          = false;
+                sections[i].not_modified    = false;
+                sections[i].etag[0]         = '\0';
+            }
+        }
+
+        ~JsonBundleStreamer()
+        {
+            delete streamer; // Only if the response was truncated mid-section
+        }
+
+        bool done() { return completed || error; }
+        bool ok()   { return completed && !error; }
+
+        void feed(char c)
+        {
+            if (done()) return;
+
+            bool structural = scan(c);
+
+            if (streamer)
+            {
+                streamer->feed(c);
+                if (structural && depth == 1) end_section();
+                return;
+            }
+
+            if (!structural) return;
+
+            switch (c)
+            {
+                case ':':
+                    if (depth == 1) pending = find_section(key);
+                    break;
+
+                case ',':
+                    if (depth == 1) pending = nullptr;
+                    break;
+
+                case '{':
+                    if (depth == 2 && pending) start_section(c);
+                    break;
+
+                case '}':
+                case ']':
+                    if (depth < 0)  error = true;
+                    if (depth == 0) completed = true;
+                    break;
+            }
+        }
+
+}; // end JsonBundleStreamer
+
+
+// Feed a chunk, and keep count of the bytes and the time it took
+void feedStreamer(FeedStreamer &streamer, const char *chunk, size_t length)
+{
+    unsigned long start_us = micros();
+
+    for (size_t i = 0; i < length; i++) {
+        streamer.feed(chunk[i]);
+    }
+
+    streamer.parse_us  += micros() - start_us;
+    streamer.bytes     += length;
+}
+
+/*
+ * Pump bytes off the wire into a streamer until it has seen the end of the document. We never
+ * read past the closing brace, and give up if nothing turns up for timeout_ms (or the stream
+ * says nothing ever will, with a negative available()).
+ */
+bool pumpJsonStream(Stream &stream, FeedStreamer &streamer, unsigned long timeout_ms)
+{
+    char            chunk[64];
+    unsigned long   last_byte_ms = millis();
+
+    while (!streamer.done())
+    {
+        int available = stream.available();
+
+        if (available > 0)
+        {
+            size_t length = stream.readBytes(chunk, min(available, (int) sizeof(chunk)));
+            feedStreamer(streamer, chunk, length);
+            last_byte_ms = millis();
+        }
+        else if (available < 0)     // A stream that has given up, i.e. InflateStream on bad input
+        {
+            Sprintln(F("[JSON] Stream failed before the document ended."));
+            break;
+        }
+        else if ( (millis() - last_byte_ms) > timeout_ms )
+        {
+            Sprintln(F("[JSON] Stream timed out before the document ended."));
+            break;
+        }
+        else
+        {
+            yield();
+        }
+    }
+
+    return streamer.ok();
+}
+
+
+/*
+ * Read a response off the wire and push it through an item streamer (MessagePack if that's
+ * what the proxy sent, refer to MsgPackStreamParser.hpp). Returns the processor's verdict
+ * once the end of the document has been seen, and the time spent parsing in parse_us.
+ */
+ItemStreamer* newItemStreamer(bool msgpack, JsonProcessor &processor, JsonVariant item_filter);
+
+bool streamJsonItems(Stream &stream, JsonProcessor &processor, const char *action, unsigned long timeout_ms, bool msgpack = false, unsigned long *parse_us = nullptr)
+{
+    StaticJsonDocument<256> filter;
+    processor.build_filter(filter);
+
+    ItemStreamer *streamer = newItemStreamer(msgpack, processor, getItemFilter(filter));
+
+    pumpJsonStream(stream, *streamer, timeout_ms);
+
+    recordFeedDocumentUsage(action, streamer->capacity(), streamer->peak_usage());
+    recordFeedFormatUsage(action, msgpack, streamer->bytes, streamer->parse_us);
+
+    Sprint(F("[JSON] Streamed items: ")); Sprint(streamer->items_parsed);
+    Sprint(F(", skipped: "));            Sprintln(streamer->items_skipped);
+
+    bool result = streamer->finish();
+    if (parse_us) *parse_us = streamer->parse_us;
+    delete streamer;
+
+    return result;
+
+} // streamJsonItems
+
+#endif
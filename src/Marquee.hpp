@@ -0,0 +1,164 @@
+#ifndef MARQUEE_H
+#define MARQUEE_H
+
+/*--------------------------- MARQUEE -----------------------------*/
+/*
+ * A list (headlines, forecasts, tickers) as one continuous scroll. With Parola each line is a
+ * separate PA_SCROLL_LEFT, which scrolls right off before the next comes in from the right
+ * edge, so the display is blank for a whole display width between lines. Here the columns of
+ * the next line follow straight on from the last, with just a gap glyph in between.
+ *
+ * Lines are pulled from the source one at a time, as the one before runs out, so nothing more
+ * than the line being shown is ever rendered. Columns are pushed onto the right of the display
+ * with MD_MAX72XX::transform(TSL), one per frame at the Parola speed, while Parola's zones sit
+ * idle. Once the source is done, the last line scrolls off as it would with Parola.
+ *
+ * Lines that already start with the gap glyph (the bullet on headlines and tickers) don't get
+ * a second one.
+ */
+#ifndef MARQUEE_GAP_GLYPH
+  #define MARQUEE_GAP_GLYPH     '\x7'   // Bullet, or '\0' for a plain gap
+#endif
+#define MARQUEE_GAP_COLUMNS     6       // Blank either side of the gap glyph
+
+// The next line to show, rendered into buffer if it needs to be. nullptr when there are no more.
+typedef const char* (*MarqueeLine)(char *buffer, size_t size);
+
+class Marquee {
+
+    private:
+        MarqueeLine     source          = nullptr;
+        char            buffer[MAX_TICKER_LENGTH];
+        const char      *text           = nullptr;      // Characters not yet started
+        const char      *next           = nullptr;      // Line to follow the gap
+
+        uint8_t         glyph[16];
+        uint8_t         glyph_width     = 0;
+        uint8_t         glyph_column    = 0;
+        uint8_t         blank           = 0;            // Columns to go before the next glyph
+        uint16_t        drain           = 0;            // Blank columns left to clear the display
+        bool            in_gap          = false;
+        bool            active          = false;
+
+        uint16_t        speed           = 0;
+        unsigned long   last_ms         = 0;
+
+        const char* skipGap(const char *line)
+        {
+            if ( gap_glyph && line[0] == gap_glyph ) line += (line[1] == ' ') ? 2 : 1;
+            return line;
+        }
+
+        // The next column to push, or -1 when the last line has scrolled off
+        int nextColumn()
+        {
+            for (;;)
+            {
+                if (glyph_column < glyph_width) return glyph[glyph_column++];
+
+                if (blank) {
+                    blank--;
+                    return 0;
+                }
+
+                if (text && *text) {
+                    glyph_width     = glyphColumns(*text++, glyph, sizeof(glyph));
+                    glyph_column    = 0;
+                    blank           = *text ? Parola.getCharSpacing(ZONE_LEFT) : 0;
+                    continue;
+                }
+
+                // The gap glyph, then its blank columns, then the next line
+                if (in_gap) {
+                    in_gap          = false;
+                    glyph_width     = gap_glyph ? glyphColumns(gap_glyph, glyph, sizeof(glyph)) : 0;
+                    glyph_column    = 0;
+                    blank           = MARQUEE_GAP_COLUMNS;
+                    text            = next;
+                    continue;
+                }
+
+                if (text) {
+                    next = source(buffer, sizeof(buffer));
+                    if (next) {
+                        next    = skipGap(next);
+                        in_gap  = true;
+                        blank   = MARQUEE_GAP_COLUMNS;
+                        text    = "";
+                        lines++;
+                        continue;
+                    }
+
+                    text    = nullptr;
+                    drain   = MAX_DEVICES * COL_SIZE;
+                }
+
+                if (drain) {
+                    drain--;
+                    return 0;
+                }
+                return -1;
+            }
+        }
+
+    public:
+        char            gap_glyph       = MARQUEE_GAP_GLYPH;
+        unsigned long   lines           = 0;
+        unsigned long   columns         = 0;
+
+        // Starts with the display clear. Returns false if the source had nothing to show.
+        bool start(MarqueeLine _source, uint16_t _speed)
+        {
+            const char *first = _source(buffer, sizeof(buffer));
+            if (!first) return false;
+
+            source          = _source;
+            speed           = _speed;
+            text            = skipGap(first);
+            next            = nullptr;
+            glyph_width     = 0;
+            glyph_column    = 0;
+            blank           = 0;
+            drain           = 0;
+            in_gap          = false;
+            active          = true;
+            last_ms         = millis() - speed;
+            lines++;
+
+            Parola.displayClear();
+            return true;
+        }
+
+        void stop()
+        {
+            active = false;
+            source = nullptr;
+        }
+
+        bool running() const    { return active; }
+
+        // From the display engine's tick, as Parola.displayAnimate() is. One column per frame.
+        void animate(unsigned long now)
+        {
+            if ( !active || (now - last_ms) < speed ) return;
+            last_ms = now;
+
+            int column = nextColumn();
+            if (column < 0) {
+                stop();
+                return;
+            }
+
+            MD_MAX72XX *graphics = Parola.getGraphicObject();
+            graphics->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+            graphics->transform(MD_MAX72XX::TSL);
+            graphics->setColumn(0, column);
+            graphics->control(MD_MAX72XX::UPDATE, MD_MAX72XX::ON);
+            columns++;
+        }
+
+}; // end Marquee
+
+Marquee marquee;
+
+#endif
@@ -0,0 +1,350 @@
+#ifndef MSGPACK_STREAM_PARSER_H
+#define MSGPACK_STREAM_PARSER_H
+
+#include <ArduinoJson.h>
+#include "TickerDebug.hpp"
+#include "JsonStreamParser.hpp"
+
+/*--------------------------- STREAMING MESSAGEPACK PARSER -----------------------------*/
+/*
+ * The same documents as JsonStreamParser.hpp, in MessagePack (https://msgpack.org/). It's
+ * less than half the bytes over the air, as every number is binary and the member names
+ * repeated in each data[] element are short length-prefixed strings without any quoting.
+ *
+ * The proxy answers with MessagePack when asked (Accept: application/msgpack, and
+ * format=msgpack), and says so in the Content-Type. An older proxy ignores the request and
+ * sends JSON, so the parser is picked per response.
+ *
+ * MessagePack has no closing brackets. Every map and array says up front how many entries
+ * it has, so the scanner keeps a count of what's left at each level and knows a container
+ * has ended once its last entry has. Each data[] element is still copied into a buffer and
+ * handed to deserializeMsgPack() on its own, with the processor's filter, so the
+ * processors don't know (or care) which format it came in.
+ */
+#define MSGPACK_STREAM_MAX_DEPTH    8
+
+class MsgPackScanner {
+
+    protected:
+        enum Phase  { PHASE_TYPE, PHASE_LENGTH, PHASE_PAYLOAD };
+        enum Kind   { KIND_OTHER, KIND_INT, KIND_STR, KIND_BIN, KIND_EXT, KIND_ARRAY, KIND_MAP };
+
+        Phase       phase       = PHASE_TYPE;
+        Kind        kind        = KIND_OTHER;       // Of the value being read
+        uint32_t    need        = 0;                // Bytes left of its length or payload
+        uint32_t    length      = 0;
+
+        int         depth       = 0;                // Containers we're inside
+        uint32_t    remaining[MSGPACK_STREAM_MAX_DEPTH] = { 1 };   // Values left in each. Level 0 is the document.
+
+        bool        completed   = false;
+        bool        error       = false;
+
+        char        key[JSON_STREAM_KEY_LENGTH] = {0};  // Last member name of the root map
+        size_t      key_length  = 0;
+
+        static bool is_map(uint8_t type)    { return (type & 0xf0) == 0x80 || type == 0xde || type == 0xdf; }
+        static bool is_array(uint8_t type)  { return (type & 0xf0) == 0x90 || type == 0xdc || type == 0xdd; }
+
+        // Map entries alternate key, value
+        bool is_root_key()
+        {
+            return depth == 1 && (remaining[1] % 2) == 0;
+        }
+
+        // Called with depth at the level of the value, i.e. 1 for members of the root map.
+        virtual void value_start(uint8_t type)  { }
+        virtual void value_payload(uint8_t c)   { }
+        virtual void value_end()                { }
+
+        void scan(uint8_t c)
+        {
+            switch (phase)
+            {
+                case PHASE_TYPE:
+                    start(c);
+                    break;
+
+                case PHASE_LENGTH:  // Big-endian
+                    length = (length << 8) | c;
+                    if (--need == 0) length_read();
+                    break;
+
+                case PHASE_PAYLOAD:
+                    if ( is_root_key() && kind == KIND_STR && key_length < (JSON_STREAM_KEY_LENGTH-1) ) key[key_length++] = c;
+                    value_payload(c);
+                    if (--need == 0) end();
+                    break;
+            }
+        }
+
+    private:
+        void start(uint8_t type)
+        {
+            if ( is_root_key() ) key_length = 0;
+            value_start(type);
+
+            kind = KIND_OTHER;
+
+            if (type <= 0x7f || type >= 0xe0)   { kind = KIND_INT; end();   return; }  // fixint
+            if ((type & 0xf0) == 0x80)          { open(2 * (type & 0x0f));  return; }  // fixmap
+            if ((type & 0xf0) == 0x90)          { open(type & 0x0f);        return; }  // fixarray
+            if ((type & 0xe0) == 0xa0)          { kind = KIND_STR; payload(type & 0x1f); return; }  // fixstr
+
+            switch (type)
+            {
+                case 0xc0: case 0xc2: case 0xc3:                        end();                                  break;  // nil, false, true
+                case 0xc4: case 0xc5: case 0xc6:    kind = KIND_BIN;    read_length(1 << (type - 0xc4));        break;
+                case 0xc7: case 0xc8: case 0xc9:    kind = KIND_EXT;    read_length(1 << (type - 0xc7));        break;
+                case 0xca:                                              payload(4);                             break;  // float 32
+                case 0xcb:                                              payload(8);                             break;  // float 64
+                case 0xcc: case 0xcd: case 0xce: case 0xcf:
+                                                    kind = KIND_INT;    payload(1 << (type - 0xcc));            break;  // uint
+                case 0xd0: case 0xd1: case 0xd2: case 0xd3:
+                                                    kind = KIND_INT;    payload(1 << (type - 0xd0));            break;  // int
+                case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8:
+                                                                        payload(1 + (1 << (type - 0xd4)));      break;  // fixext
+                case 0xd9: case 0xda: case 0xdb:    kind = KIND_STR;    read_length(1 << (type - 0xd9));        break;
+                case 0xdc:                          kind = KIND_ARRAY;  read_length(2);                         break;
+                case 0xdd:                          kind = KIND_ARRAY;  read_length(4);                         break;
+                case 0xde:                          kind = KIND_MAP;    read_length(2);                         break;
+                case 0xdf:                          kind = KIND_MAP;    read_length(4);                         break;
+                default:                            error = true;                                               break;  // 0xc1 is never used
+            }
+        }
+
+        void read_length(uint8_t bytes)
+        {
+            length  = 0;
+            need    = bytes;
+            phase   = PHASE_LENGTH;
+        }
+
+        void length_read()
+        {
+            switch (kind)
+            {
+                case KIND_ARRAY:    open(length);       break;
+                case KIND_MAP:      open(2 * length);   break;
+                case KIND_EXT:      payload(length + 1); break;   // + the ext type
+                default:            payload(length);    break;
+            }
+        }
+
+        void payload(uint32_t bytes)
+        {
+            if (bytes == 0) { end(); return; }
+
+            need    = bytes;
+            phase   = PHASE_PAYLOAD;
+        }
+
+        void open(uint32_t count)
+        {
+            phase = PHASE_TYPE;
+
+            if (depth >= (MSGPACK_STREAM_MAX_DEPTH-1)) { error = true; return; }
+
+            remaining[++depth] = count;
+            if (count == 0) close();
+        }
+
+        void close()
+        {
+            depth--;
+            end();
+        }
+
+        // The value at this depth is done. That may well be the last in its container too.
+        void end()
+        {
+            phase = PHASE_TYPE;
+
+            if ( is_root_key() ) key[key_length] = '\0';
+            value_end();
+
+            if (--remaining[depth] == 0) {
+                if (depth == 0) completed = true;
+                else            close();
+            }
+        }
+
+};
+
+
+class MsgPackItemStreamer : public ItemStreamer, protected MsgPackScanner {
+
+    private:
+        DeserializationError deserialize_item()
+        {
+            return deserializeMsgPack(item_doc, (const char *) item_buffer, item_length, DeserializationOption::Filter(item_filter));
+        }
+
+        void value_start(uint8_t type)
+        {
+            if (depth == 1 && !is_root_key())
+            {
+                if (member == MEMBER_DATA) {
+                    if      (is_array(type))    data_is_array = true;
+                    else if (is_map(type))      start_capture(type, 1);     // 'data' is a single map
+                } else if (member == MEMBER_COD) {
+                    _cod = (type <= 0x7f) ? type : 0;                       // Any bigger comes in the payload
+                }
+            }
+            else if (depth == 2 && member == MEMBER_DATA && data_is_array && is_map(type))
+            {
+                start_capture(type, 2);                                     // data[] element
+            }
+        }
+
+        void value_payload(uint8_t c)
+        {
+            if (depth != 1 || is_root_key()) return;
+
+            if (member == MEMBER_COD && kind == KIND_INT) {
+                _cod = (_cod << 8) | c;
+            } else if (member == MEMBER_ETAG && kind == KIND_STR) {
+                size_t etag_length = strlen(etag);
+                if (etag_length < (sizeof(etag)-1)) etag[etag_length] = c;
+            }
+        }
+
+        void value_end()
+        {
+            if (capturing && depth == capture_depth) end_capture();
+            if ( is_root_key() ) member = root_member(key);
+        }
+
+    public:
+        MsgPackItemStreamer(JsonProcessor &_processor, JsonVariant _item_filter) : ItemStreamer(_processor, _item_filter) { }
+
+        bool    done()          { return completed || error; }
+        bool    ok()            { return completed && !error; }
+
+        void feed(char c)
+        {
+            if (done()) return;
+
+            if (capturing) append(c);
+            scan(c);
+        }
+
+}; // end MsgPackItemStreamer
+
+
+// As JsonBundleStreamer, each known member of the root map is forwarded to an item streamer
+class MsgPackBundleStreamer : public FeedStreamer, protected MsgPackScanner {
+
+    private:
+        JsonBundleSection   *sections;
+        size_t              section_count;
+
+        JsonBundleSection   *pending    = nullptr;     // Key read, waiting for its value
+        JsonBundleSection   *active     = nullptr;
+        MsgPackItemStreamer *streamer   = nullptr;
+
+        StaticJsonDocument<256> filter;
+
+        JsonBundleSection* find_section(const char *name)
+        {
+            for (size_t i = 0; i < section_count; i++) {
+                if (strcmp(sections[i].name, name) == 0) return &sections[i];
+            }
+            return nullptr;
+        }
+
+        void value_start(uint8_t type)
+        {
+            if (depth != 1 || is_root_key() || !pending) return;
+
+            if (is_map(type))
+            {
+                Sprint(F("[MsgPack] Bundle section: ")); Sprintln(pending->name);
+
+                active = pending;
+
+                filter.clear();
+                active->processor->build_filter(filter);
+
+                streamer = new MsgPackItemStreamer(*active->processor, getItemFilter(filter));
+            }
+
+            pending = nullptr;
+        }
+
+        void value_end()
+        {
+            if (depth != 1) return;
+
+            if ( is_root_key() ) {
+                pending = find_section(key);
+            } else if (streamer) {
+                end_section();
+            }
+        }
+
+        void end_section()
+        {
+            active->received        = true;
+            active->result          = streamer->finish();
+            active->not_modified    = streamer->not_modified;
+            strlcpy(active->etag, streamer->etag, sizeof(active->etag));
+
+            recordFeedDocumentUsage(active->name, streamer->capacity(), streamer->peak_usage());
+
+            delete streamer;
+            streamer    = nullptr;
+            active      = nullptr;
+        }
+
+    public:
+        MsgPackBundleStreamer(JsonBundleSection *_sections, size_t _section_count) :
+            sections(_sections), section_count(_section_count)
+        {
+            for (size_t i = 0; i < section_count; i++) {
+                sections[i].received        = false;
+                sections[i].result          = false;
+                sections[i].not_modified    = false;
+                sections[i].etag[0]         = '\0';
+            }
+        }
+
+        ~MsgPackBundleStreamer()
+        {
+            delete streamer; // Only if the response was truncated mid-section
+        }
+
+        bool done() { return completed || error; }
+        bool ok()   { return completed && !error; }
+
+        void feed(char c)
+        {
+            if (done()) return;
+
+            // The first byte of a section starts its streamer, and the last one ends it. Both
+            // need to go to the streamer, so it's fed either side of the scan as need be.
+            bool in_section = (streamer != nullptr);
+            if (in_section) streamer->feed(c);
+
+            scan(c);
+
+            if (!in_section && streamer) streamer->feed(c);
+        }
+
+}; // end MsgPackBundleStreamer
+
+
+// An item (or bundle) streamer for whichever format the response is in
+ItemStreamer* newItemStreamer(bool msgpack, JsonProcessor &processor, JsonVariant item_filter)
+{
+    if (msgpack) return new MsgPackItemStreamer(processor, item_filter);
+    return new JsonItemStreamer(processor, item_filter);
+}
+
+FeedStreamer* newBundleStreamer(bool msgpack, JsonBundleSection *sections, size_t section_count)
+{
+    if (msgpack) return new MsgPackBundleStreamer(sections, section_count);
+    return new JsonBundleStreamer(sections, section_count);
+}
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef PRICE_FORMAT_H
+#define PRICE_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*--------------------------- PRICE FORMATTING -----------------------------*/
+/*
+ * Fixed point prices (refer to TickerTable.hpp) to text, using only integer arithmetic. The
+ * ESP8266 has no FPU, so "%0.2lf" goes through the software double printf path for every
+ * price shown.
+ *
+ * With decimals < 0, a price gets as many decimals as it needs to show significant digits:
+ * 16724.74 is "16,725" and 0.00001234 is "0.00001234". Zeros beyond min_decimals are then
+ * trimmed, and if there are fewer decimals than that and they're all zero, so is the point:
+ * 999.996 rounds up to "1,000" rather than "1,000.0". compact shows thousands, millions and
+ * billions as "12.3k", "4.51M" and "1.2B", to the same number of significant digits.
+ *
+ * The host tests are in test/test_price_format (pio test -e native).
+ *
+ * Build with PRICE_FORMAT_BENCH for 'xo', which times it against snprintf_P() in cycles. For
+ * flash, compare `pio run -t size` with and without PRICE_FORMAT_FLOAT, which puts the
+ * snprintf_P() path back.
+ */
+#ifndef PRICE_FORMAT_FLOAT
+  #define PRICE_FORMAT_FLOAT    0
+#endif
+#ifndef PRICE_FORMAT_BENCH
+  #define PRICE_FORMAT_BENCH    0
+#endif
+
+struct PriceFormat
+{
+    int8_t      decimals;       // < 0 for as many as significant needs
+    uint8_t     significant;
+    uint8_t     min_decimals;   // Automatic decimals trim trailing zeros down to this many
+    char        thousands;      // Separator, or '\0' for none
+    bool        compact;
+};
+
+const PriceFormat PRICE_FORMAT_FIXED2   = {  2, 0, 2, '\0', false };    // As "%0.2lf"
+const PriceFormat PRICE_FORMAT_TICKER   = { -1, 5, 2, ',',  false };
+const PriceFormat PRICE_FORMAT_COMPACT  = { -1, 3, 0, '\0', true  };
+
+// 10^n, for n up to 19
+uint64_t pricePow10(uint8_t n)
+{
+    uint64_t p = 1;
+    while (n--) p *= 10;
+    return p;
+}
+
+uint8_t priceDigitCount(uint64_t value)
+{
+    uint8_t  n = 0;
+    uint64_t p = 1;
+    while (n < 19 && value >= p) {
+        n++;
+        p *= 10;
+    }
+    return (n == 19 && value >= p) ? 20 : n;
+}
+
+// Least significant first, zero padded to at least min_digits. 32 bit division once it fits.
+uint8_t priceDigits(uint64_t value, char *digits, uint8_t min_digits)
+{
+    uint8_t n = 0;
+    while (value > UINT32_MAX) {
+        digits[n++] = '0' + (value % 10);
+        value /= 10;
+    }
+
+    uint32_t low = (uint32_t) value;
+    while (low || n < min_digits) {
+        digits[n++] = '0' + (low % 10);
+        low /= 10;
+    }
+    return n;
+}
+
+// Decimals needed to show significant digits of magnitude, which has scale implied decimals
+uint8_t priceAutoDecimals(uint64_t magnitude, uint8_t scale, uint8_t significant)
+{
+    uint8_t digits = priceDigitCount(magnitude);
+
+    if (digits > scale) {
+        uint8_t whole = digits - scale;
+        return (whole >= significant) ? 0 : (significant - whole);
+    }
+
+    // Below 1, so the zeros after the point, then the significant digits
+    return (scale - digits) + significant;
+}
+
+// Write value, which has value_decimals implied decimal places (up to 8), rounded half away
+// from zero. Returns the length it needed, as snprintf() does.
+size_t formatPrice(char *buffer, size_t size, int64_t value, uint8_t value_decimals, const PriceFormat &format)
+{
+    static const char suffixes[] = { '\0', 'k', 'M', 'B' };
+
+    uint64_t magnitude  = (value < 0) ? -(uint64_t) value : (uint64_t) value;
+    uint8_t  scale      = value_decimals;   // Implied decimals of magnitude, in units of the group
+    uint8_t  group      = 0;
+
+    if (format.compact) {
+        while ( group < 3 && magnitude >= pricePow10(scale + 3) ) {
+            group++;
+            scale += 3;
+        }
+    }
+
+    int8_t   wanted     = format.decimals;
+    uint8_t  decimals   = 0;
+    uint64_t rounded    = 0;
+    uint64_t one        = 1;
+
+    for (int pass = 0; pass < 8; pass++)
+    {
+        decimals = (wanted >= 0) ? wanted : priceAutoDecimals(magnitude, scale, format.significant);
+        if (decimals > scale) decimals = scale;
+
+        uint64_t drop = pricePow10(scale - decimals);
+        rounded = (magnitude + drop / 2) / drop;
+        one     = pricePow10(decimals);
+
+        // Rounding up can carry into the next group (999.96k is 1.00M), or another whole digit
+        // (999.96 is 1000.0), which leaves one decimal too many
+        if ( format.compact && group < 3 && rounded >= 1000 * one ) {
+            group++;
+            scale += 3;
+            wanted = format.decimals;
+            continue;
+        }
+
+        if ( format.decimals < 0 && decimals > 0 ) {
+            uint8_t needed = priceAutoDecimals(rounded, decimals, format.significant);
+            if (needed < decimals) {
+                wanted = needed;
+                continue;
+            }
+        }
+        break;
+    }
+
+    size_t length = 0;
+    auto put = [&](char c) {
+        if (length + 1 < size) buffer[length] = c;
+        length++;
+    };
+
+    if (value < 0 && rounded) put('-');
+
+    char    digits[24];
+    uint8_t n = priceDigits(rounded / one, digits, 1);
+    while (n > 0) {
+        put(digits[--n]);
+        if (format.thousands && n > 0 && n % 3 == 0) put(format.thousands);
+    }
+
+    if (decimals > 0) {
+        priceDigits(rounded % one, digits, decimals);
+
+        uint8_t trimmed = 0;
+        if (format.decimals < 0) {
+            uint8_t keep = (decimals >= format.min_decimals) ? format.min_decimals : ((rounded % one) ? decimals : 0);
+            while ( trimmed < decimals - keep && digits[trimmed] == '0' ) trimmed++;
+        }
+
+        if (trimmed < decimals) put('.');
+        for (n = decimals; n > trimmed; n--) put(digits[n - 1]);
+    }
+
+    if (group) put(suffixes[group]);
+
+    if (size) buffer[(length < size) ? length : size - 1] = '\0';
+    return length;
+}
+
+// As "%.*f" would
+size_t formatFixedPoint(char *buffer, size_t size, int64_t value, uint8_t value_decimals, uint8_t decimals)
+{
+    PriceFormat format = { (int8_t) decimals, 0, decimals, '\0', false };
+    return formatPrice(buffer, size, value, value_decimals, format);
+}
+
+
+#if PRICE_FORMAT_BENCH
+/*---- BENCHMARK ----*/
+#define PRICE_FORMAT_BENCH_RUNS     200
+#define PRICE_FORMAT_BENCH_DECIMALS 8
+
+// Cycles per call, of snprintf_P("%0.2lf"), and formatPrice() fixed to 2 places, automatic, and compact
+void benchPriceFormat()
+{
+    // Bitcoin, a stock, a small coin, a meme coin, a faller and a big one
+    static const int64_t samples[] = { 1672474000000LL, 13237000000LL, 7230000LL, 1234LL, -1234500000LL, 451234567000000LL };
+
+    const PriceFormat *formats[]    = { &PRICE_FORMAT_FIXED2, &PRICE_FORMAT_TICKER, &PRICE_FORMAT_COMPACT };
+    char              buffer[4][24];
+    uint32_t          cycles[4];
+
+    Serial.printf_P(PSTR("Price format, cycles per call (%d runs each):\r\n"), PRICE_FORMAT_BENCH_RUNS);
+
+    for (int64_t sample : samples)
+    {
+        double as_double = sample / 100000000.0;
+
+        uint32_t start = ESP.getCycleCount();
+        for (int i = 0; i < PRICE_FORMAT_BENCH_RUNS; i++) {
+            snprintf_P(buffer[0], sizeof(buffer[0]), PSTR("%0.2lf"), as_double);
+        }
+        cycles[0] = (ESP.getCycleCount() - start) / PRICE_FORMAT_BENCH_RUNS;
+
+        for (int f = 0; f < 3; f++) {
+            start = ESP.getCycleCount();
+            for (int i = 0; i < PRICE_FORMAT_BENCH_RUNS; i++) {
+                formatPrice(buffer[f + 1], sizeof(buffer[f + 1]), sample, PRICE_FORMAT_BENCH_DECIMALS, *formats[f]);
+            }
+            cycles[f + 1] = (ESP.getCycleCount() - start) / PRICE_FORMAT_BENCH_RUNS;
+        }
+
+        Serial.printf_P(PSTR("  %%0.2lf %-14s %6lu | 2dp %-14s %6lu | auto %-14s %6lu | compact %-8s %6lu\r\n"),
+            buffer[0], (unsigned long) cycles[0], buffer[1], (unsigned long) cycles[1],
+            buffer[2], (unsigned long) cycles[2], buffer[3], (unsigned long) cycles[3]);
+
+        yield();
+    }
+}
+#endif
+
+#endif
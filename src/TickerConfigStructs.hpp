@@ -40,6 +40,7 @@
 ///#define DEFAULT_DEVICE_PASSWORD     "123456"
 
 // Default Crypto
+#define DEFAULT_CRYPTO_CCY "USD"   // Any ISO 4217 code in CurrencyGlyphs.hpp
 #define DEFAULT_TICKER_1 "BTC"
 #define DEFAULT_TICKER_2 "ETH"
 #define DEFAULT_TICKER_3 "LTC"
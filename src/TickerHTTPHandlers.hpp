@@ -1,5 +1,7 @@
 #include "TickerConfigStructs.hpp"
 #include "TickerDebug.hpp"
+#include "FeedScheduler.hpp"
+#include "FeedStats.hpp"
 
 /* 
  * For Message Management //http://www.arduino.cc/playground/Code/Time - https://github.com/PaulStoffregen/Time - 
@@ -103,6 +105,7 @@ void EEPROM_TickerConfig_Start (bool flush = false) // function assume EEPROM.be
 
   // Set the default Crypto Tickers and the News Feeds
   // newConfig.ticker_mode      = TICKER_MODE_TOP;    // by default use pull what is the top marketcap
+  strcpy(newConfig.crypto_ccy, DEFAULT_CRYPTO_CCY );
   strcpy(newConfig.crypto_1,  DEFAULT_TICKER_1 );   
   strcpy(newConfig.crypto_2,  DEFAULT_TICKER_2 );       
   strcpy(newConfig.crypto_3,  DEFAULT_TICKER_3 );  
@@ -225,6 +228,7 @@ void HTTPGetConfigJSONHandler()
 
         "\"input_wakeup_time\":\""        + String(input_wakeup_time)               + "\","              
         "\"input_sleep_time\":\""         + String(input_sleep_time)                + "\","                       
+        "\"input_crypto_ccy\":\""         + String(tickerConfig.crypto_ccy) + "\","
         "\"input_crypto_1\":\""           + String(tickerConfig.crypto_1) + "\","                     
         "\"input_crypto_2\":\""           + String(tickerConfig.crypto_2) + "\","                     
         "\"input_crypto_3\":\""           + String(tickerConfig.crypto_3) + "\","                     
@@ -300,7 +304,14 @@ void HTTPConfigSubmitHandler() // Handler
 */
       // Float Precision, same as an int - https://chortle.ccsu.edu/java5/Notes/chap11/ch11_2.html
 
-      // Crypto
+      // Crypto, priced in a currency we have a symbol for
+      webServer.arg("input_crypto_ccy").toCharArray(newConfig.crypto_ccy,    sizeof(newConfig.crypto_ccy));
+      if ( findCurrencyGlyph(newConfig.crypto_ccy) < 0 ) {
+        strcpy(newConfig.crypto_ccy, DEFAULT_CRYPTO_CCY);
+      } else {
+        for (char *c = newConfig.crypto_ccy; *c; c++) *c = toupper(*c);
+      }
+
       webServer.arg("input_crypto_1").toCharArray(newConfig.crypto_1,        sizeof(newConfig.crypto_1));
       webServer.arg("input_crypto_2").toCharArray(newConfig.crypto_2,        sizeof(newConfig.crypto_1));
       webServer.arg("input_crypto_3").toCharArray(newConfig.crypto_3,        sizeof(newConfig.crypto_1));
@@ -597,6 +608,7 @@ void EEPROM_SerialDebug()
   Serial.print( F("Config: News Limit:") ); Serial.println(tickerConfig.news_limit, DEC);  
   Serial.println( F("---------------") );
   //Serial.print( F("Config: Ticker Currency:") ); Serial.println(tickerConfig.ticker_currency     );
+  Serial.print( F("Config: Crypto Currency:") ); Serial.println(tickerConfig.crypto_ccy  );
   Serial.print( F("Config: Crypto 1:") ); Serial.println(tickerConfig.crypto_1  );    
   Serial.print( F("Config: Stock 1:") ); Serial.println(tickerConfig.stock_1  );     
   Serial.println( F("---------------") );
@@ -653,4 +665,83 @@ void HTTPDisplayStateHandler()
         webServer.send(200, "application/json", F("{\"display_on\": false}")); // otherwise, respond with a 404 (Not Found) error      
     }
  
-} // return a configuration string
\ No newline at end of file
+} // return a configuration string
+
+
+
+// Health of each feed, i.e. which one is failing and why
+void HTTPFeedHealthHandler()
+{
+    unsigned long   now = millis();
+    String          json_output = "[";
+
+    for (int i = 0; i < FEED_COUNT; i++)
+    {
+        FeedSchedule &schedule = feedScheduler.get(i);
+
+        if (i > 0) json_output += ",";
+        json_output += "{\"feed\":\"" + String(schedule.action) + "\"";
+        json_output += ",\"state\":\"" + String(schedule.state()) + "\"";
+        json_output += ",\"stale\":" + String(schedule.stale ? "true" : "false");
+        json_output += ",\"failures\":" + String(schedule.failures);
+        json_output += ",\"last_latency_ms\":" + String(schedule.last_latency_ms);
+        json_output += ",\"last_error\":\"" + feedErrorToString(schedule.last_error) + "\"";
+        json_output += ",\"last_success_s\":" + String(schedule.succeeded ? (long)((now - schedule.last_success_ms) / 1000) : -1);
+        json_output += ",\"due_in_s\":" + String((long)(schedule.next_due_ms - now) / 1000);
+        json_output += "}";
+    }
+
+    json_output += "]";
+
+    webServer.send(200, "application/json", json_output);
+
+} // return the feed health
+
+// Where the time and heap of each action's requests went, refer to FeedStats.hpp
+void HTTPFeedTelemetryHandler()
+{
+    String json_output = "[";
+
+    for (int i = 0; i < feedActionStatsCount; i++)
+    {
+        FeedTelemetry &telemetry = feedActionStats[i].telemetry;
+        if (telemetry.requests == 0) continue;
+
+        if (json_output.length() > 1) json_output += ",";
+        json_output += "{\"action\":\"" + String(feedActionStats[i].action) + "\"";
+        json_output += ",\"requests\":" + String(telemetry.requests);
+        json_output += ",\"last\":{\"dns_ms\":" + String(telemetry.last.dns_ms);
+        json_output += ",\"connect_ms\":" + String(telemetry.last.connect_ms);
+        json_output += ",\"ttfb_ms\":" + String(telemetry.last.ttfb_ms);
+        json_output += ",\"transfer_ms\":" + String(telemetry.last.transfer_ms);
+        json_output += ",\"parse_us\":" + String(telemetry.last.parse_us);
+        json_output += ",\"bytes\":" + String(telemetry.last.bytes);
+        json_output += ",\"heap_before\":" + String(telemetry.last.heap_before);
+        json_output += ",\"heap_after\":" + String(telemetry.last.heap_after);
+        json_output += ",\"max_block\":" + String(telemetry.last.max_block);
+        json_output += ",\"fragmentation_before\":" + String(telemetry.last.fragmentation_before);
+        json_output += ",\"fragmentation_after\":" + String(telemetry.last.fragmentation_after) + "}";
+        json_output += ",\"average\":{\"dns_ms\":" + String(telemetry.average(&FeedTelemetrySample::dns_ms));
+        json_output += ",\"connect_ms\":" + String(telemetry.average(&FeedTelemetrySample::connect_ms));
+        json_output += ",\"ttfb_ms\":" + String(telemetry.average(&FeedTelemetrySample::ttfb_ms));
+        json_output += ",\"transfer_ms\":" + String(telemetry.average(&FeedTelemetrySample::transfer_ms));
+        json_output += ",\"parse_us\":" + String(telemetry.average(&FeedTelemetrySample::parse_us));
+        json_output += ",\"bytes\":" + String(telemetry.average(&FeedTelemetrySample::bytes)) + "}";
+        json_output += ",\"worst_heap_delta\":" + String(telemetry.worst_heap_delta);
+        json_output += ",\"min_max_block\":" + String(telemetry.min_max_block);
+        json_output += ",\"worst_fragmentation_delta\":" + String(telemetry.worst_fragmentation_delta);
+
+        json_output += ",\"histogram_bucket_ms\":" + String(FEED_TELEMETRY_BUCKET_MS);
+        json_output += ",\"histogram\":[";
+        for (int b = 0; b < FEED_TELEMETRY_BUCKETS; b++) {
+            if (b > 0) json_output += ",";
+            json_output += String(telemetry.histogram[b]);
+        }
+        json_output += "]}";
+    }
+
+    json_output += "]";
+
+    webServer.send(200, "application/json", json_output);
+
+} // return the feed telemetry
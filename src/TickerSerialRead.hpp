@@ -4,6 +4,8 @@
 extern void performFilesystemUpdate();
 extern void EEPROM_set_firmware_needs_update();
 extern bool reload_required;
+extern bool feed_bundle_mode;
+extern bool marquee_mode;
 
 // For serial read
 int     incomingByte    = 0;
@@ -59,6 +61,70 @@ void handleSerialRead()
                 reload_required = true;
                 break;                
 
+            case 's':
+                printFeedActionStats();
+                break;
+
+            case 'h':
+                printFeedTelemetry();
+                break;
+
+            case 'b':
+                feed_bundle_mode = !feed_bundle_mode;
+                Serial.print(F("Feed bundle mode: ")); Serial.println(feed_bundle_mode);
+                break;
+
+            case 'c':
+                iotConnection.printStats();
+                break;
+
+            case 'k':
+                iotConnection.keep_alive = !iotConnection.keep_alive;
+                iotConnection.printStats();
+                break;
+
+            case 'v':
+                conditionalGets.print();
+                break;
+
+            case 'q':
+                feedScheduler.print(millis());
+                break;
+
+            case 'g':
+                displayFrameStats.print();
+                break;
+
+            case 'e':
+                endpointPool.print(millis());
+                break;
+
+            case 'z':
+                iotConnection.compress = !iotConnection.compress;
+                iotConnection.printStats();
+                break;
+
+            case 'n':
+                setFeedTransportMode((feedTransportMode + 1) % 3);
+                break;
+
+            case 'p':
+                iotConnection.msgpack = !iotConnection.msgpack;
+                Serial.print(F("Ask for MessagePack: ")); Serial.println(iotConnection.msgpack);
+                break;
+
+            case 'w':
+                marquee_mode = !marquee_mode;
+                Serial.print(F("Marquee mode: ")); Serial.print(marquee_mode);
+                Serial.printf_P(PSTR(", %lu lines, %lu columns shown\r\n"), marquee.lines, marquee.columns);
+                break;
+
+        #if PRICE_FORMAT_BENCH
+            case 'o':
+                benchPriceFormat();
+                break;
+        #endif
+
         } // end switch
 
     } // end data received
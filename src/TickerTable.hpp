@@ -0,0 +1,146 @@
+#ifndef TICKER_TABLE_H
+#define TICKER_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "PriceFormat.hpp"
+#include "CurrencyGlyphs.hpp"
+
+/*--------------------------- TICKER TABLE -----------------------------*/
+/*
+ * One generation of crypto or stock tickers, held as an array per field with room for
+ * TICKER_TABLE_ROWS, rather than a std::list of structs. Names and codes are interned into a
+ * small pool, and rows refer to them by offset. Prices are fixed point, in units of
+ * 1/TICKER_PRICE_SCALE, and percentages in hundredths, so nothing after the parse needs the
+ * (software) floating point.
+ *
+ * It's all plain data, with nothing on the heap, so FeedCache writes it out as it is.
+ */
+#define TICKER_TABLE_ROWS           6       // TickerConfig only holds 6 crypto and 6 stock symbols
+#define TICKER_TABLE_POOL_BYTES     512     // 6 names and 6 codes at their longest, with NULs
+#define TICKER_NAME_MAX             63
+#define TICKER_CODE_MAX             15
+
+#define TICKER_PRICE_DECIMALS       8       // Enough for the smallest coins
+#define TICKER_PRICE_SCALE          100000000LL
+#define TICKER_PERCENT_DECIMALS     2
+
+typedef int64_t TickerPrice;
+
+class TickerTable {
+
+    private:
+        uint8_t         rows            = 0;
+        uint16_t        pool_used       = 1;        // pool[0] is the empty string
+
+        uint16_t        name_at[TICKER_TABLE_ROWS];
+        uint16_t        code_at[TICKER_TABLE_ROWS];
+        TickerPrice     prices[TICKER_TABLE_ROWS];
+        TickerPrice     price_changes[TICKER_TABLE_ROWS];
+        int32_t         percent_changes[TICKER_TABLE_ROWS];     // Hundredths of a percent
+        char            currencies[TICKER_TABLE_ROWS][4];
+        char            glyphs[TICKER_TABLE_ROWS][5];           // Currency symbol, refer to CurrencyGlyphs.hpp
+
+        char            pool[TICKER_TABLE_POOL_BYTES] = {0};
+
+        // Offset of s in the pool, adding it if it isn't already there. 0 ("") if there's no room.
+        uint16_t intern(const char *s, size_t max_length)
+        {
+            if (!s || !*s) return 0;
+
+            size_t length = strnlen(s, max_length);
+
+            for (uint16_t at = 1; at < pool_used; at += strlen(pool + at) + 1) {
+                if ( strncmp(pool + at, s, length) == 0 && pool[at + length] == '\0' ) return at;
+            }
+
+            if (pool_used + length + 1 > TICKER_TABLE_POOL_BYTES) return 0;
+
+            uint16_t at = pool_used;
+            memcpy(pool + at, s, length);
+            pool[at + length] = '\0';
+            pool_used += length + 1;
+            return at;
+        }
+
+        static int64_t fixed(double value, int64_t scale)
+        {
+            return (int64_t) (value * scale + ((value < 0) ? -0.5 : 0.5));
+        }
+
+    public:
+        uint8_t         dropped         = 0;        // Tickers there wasn't a row for
+
+        // Returns the row, or -1 if the table is full
+        int add(const char *name, const char *code, const char *currency, double price, double percent_change, double price_change)
+        {
+            if (rows >= TICKER_TABLE_ROWS) {
+                dropped++;
+                return -1;
+            }
+
+            int row = rows++;
+
+            name_at[row]            = intern(name, TICKER_NAME_MAX);
+            code_at[row]            = intern(code, TICKER_CODE_MAX);
+            prices[row]             = fixed(price,          TICKER_PRICE_SCALE);
+            price_changes[row]      = fixed(price_change,   TICKER_PRICE_SCALE);
+            percent_changes[row]    = fixed(percent_change, 100);
+
+            memset(currencies[row], '\0', sizeof(currencies[row]));
+            if (currency) strncpy(currencies[row], currency, sizeof(currencies[row]) - 1);
+
+            getCurrencySymbol(currencies[row], glyphs[row], sizeof(glyphs[row]));
+
+            return row;
+        }
+
+        // A table read back as it was in memory (refer to FeedCache.hpp) can't point outside itself
+        bool valid() const
+        {
+            if ( rows > TICKER_TABLE_ROWS || pool_used > TICKER_TABLE_POOL_BYTES || pool[TICKER_TABLE_POOL_BYTES - 1] != '\0' ) return false;
+
+            for (size_t row = 0; row < rows; row++) {
+                if ( name_at[row] >= TICKER_TABLE_POOL_BYTES || code_at[row] >= TICKER_TABLE_POOL_BYTES ) return false;
+                if ( currencies[row][sizeof(currencies[row]) - 1] != '\0' || glyphs[row][sizeof(glyphs[row]) - 1] != '\0' ) return false;
+            }
+            return true;
+        }
+
+        size_t      size() const                        { return rows; }
+        bool        empty() const                       { return rows == 0; }
+
+        const char* name(size_t row) const              { return pool + name_at[row]; }
+        const char* code(size_t row) const              { return pool + code_at[row]; }
+        const char* currency(size_t row) const          { return currencies[row]; }
+        const char* glyph(size_t row) const             { return glyphs[row]; }
+        TickerPrice price(size_t row) const             { return prices[row]; }
+        TickerPrice price_change(size_t row) const      { return price_changes[row]; }
+        int32_t     percent_change(size_t row) const    { return percent_changes[row]; }
+
+        bool        rising(size_t row) const            { return percent_changes[row] > 0; }
+        const char* arrow(size_t row) const             { return rising(row) ? "\x18" : "\x19"; }
+
+        // Refer to PriceFormat.hpp
+        size_t format_price(size_t row, char *buffer, size_t size, const PriceFormat &format = PRICE_FORMAT_TICKER) const
+        {
+        #if PRICE_FORMAT_FLOAT
+            return snprintf_P(buffer, size, PSTR("%0.2lf"), (double) prices[row] / TICKER_PRICE_SCALE);
+        #else
+            return formatPrice(buffer, size, prices[row], TICKER_PRICE_DECIMALS, format);
+        #endif
+        }
+
+        size_t format_percent_change(size_t row, char *buffer, size_t size) const
+        {
+        #if PRICE_FORMAT_FLOAT
+            return snprintf_P(buffer, size, PSTR("%0.2lf"), percent_changes[row] / 100.0);
+        #else
+            return formatFixedPoint(buffer, size, percent_changes[row], TICKER_PERCENT_DECIMALS, 2);
+        #endif
+        }
+
+}; // end TickerTable
+
+#endif
@@ -81,6 +81,29 @@ bool is_valid_symbol (char *symbol) {
 }
 
 
+/************************************* URL ENCODING ****************************************/
+// Percent-encode anything that isn't unreserved (RFC 3986), i.e. the quotes of an ETag
+String urlEncode(const char *str)
+{
+  static const char hex[] = "0123456789ABCDEF";
+
+  String encoded; encoded.reserve(strlen(str) * 3);
+
+  for (; *str != '\0'; str++) {
+    char c = *str;
+    if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+      encoded += c;
+    } else {
+      encoded += '%';
+      encoded += hex[(c >> 4) & 0x0F];
+      encoded += hex[c & 0x0F];
+    }
+  }
+
+  return encoded;
+}
+
+
 /************************************* MATH UTILS  ****************************************/
 
 // From: https://gist.github.com/bmccormack/d12f4bf0c96423d03f82
@@ -67,10 +67,32 @@ bool      clock3_active = false;
 String    clock3TimezoneName;
 
 #include "JsonProcessor.hpp"
+#include "JsonStreamParser.hpp"
+#include "MsgPackStreamParser.hpp"  // Same, for MessagePack responses
+#include "FeedRender.hpp"           // Feed data to display text, a line at a time
 
 /*--------------------------- NETWORK CONFIGURATION ------------------------------*/
 #define MDNS_LOCAL_PREFIX "ticker" // this will result in "ticker.local" as the mDNS 
-#define FEED_UPDATE_FREQUENCY_MS (1 * 60 * 60 * 1000) // every hour
+
+#ifndef FEED_BUNDLE_MODE
+  #define FEED_BUNDLE_MODE 1    // Ask the IoT proxy for all feeds in one request (falls back if unsupported)
+#endif
+
+#ifndef FEED_MSGPACK_MODE
+  #define FEED_MSGPACK_MODE 1   // Ask the IoT proxy for MessagePack rather than JSON (falls back if unsupported)
+#endif
+
+#ifndef FEED_COMPRESS_MODE
+  #define FEED_COMPRESS_MODE 0  // Accept gzip / deflate responses from the IoT proxy, if it keeps to our window (refer to InflateStream.hpp)
+#endif
+
+#ifndef FEED_CACHE_WIFI_WAIT_MS
+  #define FEED_CACHE_WIFI_WAIT_MS 1000  // With cached feeds to show, how long setup() waits on WiFi before showing them
+#endif
+
+#ifndef FEED_TRANSPORT_MODE
+  #define FEED_TRANSPORT_MODE FEED_TRANSPORT_LIVE   // Or _RECORD / _REPLAY, refer to FeedReplay.hpp
+#endif
 
 /*----------------------------- TOP LED CONFIG -----------------------------------*/
 #define FASTLED_ESP8266_RAW_PIN_ORDER // need to define this before include per: https://github.com/FastLED/FastLED/wiki/ESP8266-notes
@@ -103,6 +125,10 @@ String    clock3TimezoneName;
 #define SCROLL_SPEED_MS_DELAY_FAST 20
 #define SCROLL_SPEED_MS_DELAY_INSANE 8
 
+#ifndef MARQUEE_MODE
+  #define MARQUEE_MODE 1        // Scroll lists (news, forecast, stocks) as one continuous marquee
+#endif
+
 
 /*---------------------------- Class Instances -------------------------------*/
 #if defined(ESP8266)
@@ -113,7 +139,6 @@ String    clock3TimezoneName;
 AutoConnect         Portal(webServer);
 AutoConnectConfig   PortalConfig;
 WiFiClient          client;
-HTTPClient          http; 
 MD_Parola           Parola = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES); 
 
 
@@ -142,21 +167,34 @@ bool displayOn = true;                  // User has reqested screen stay off?
 std::map<displayStates, displayState> userDisplayStates;
 std::map<displayStates, displayState>::iterator uds_it;
 
-// For Data Structure Display using Parola
-std::list<std::string>::iterator string_list_itr;
-std::list<TickerInstance>::iterator crypto_list_itr;
+// For Data Structure Display using Parola. Holding these keeps the generation of the feed
+// being shown alive (refer to FeedBuffer.hpp), so a refresh can't pull it out from under Parola.
+// A line renderer is set with the list it's for, refer to displayStringList().
+typedef const char* (*StringListLine)(const void *list, size_t row, char *buffer, size_t size);
+
+std::shared_ptr<const void>                     string_list;
+StringListLine                                  string_list_line;
+size_t                                          string_list_row;
+size_t                                          string_list_rows;
+std::shared_ptr<const TickerTable>              crypto_table;
+size_t                                          crypto_row;
+std::shared_ptr<const CurrentWeatherData>       current_weather;
 
 /*--------------------------- GLOBAL VARIABLES -----------------------------*/
 // System and Ticker Configuration
 SystemConfig systemConfig;
 TickerConfig tickerConfig;
 
-// Global IOT Ticker Host and Path
-char  global_endpoint_host[65]= {'\0'};
+// Global IOT Ticker Path. The host is picked per request, see EndpointPool.hpp
 char  global_endpoint_path[65]= {'\0'};
 
 bool  first_setup = false;
 bool  internet_up = true; // can we connect to the internet?
+bool  feeds_restored = false; // the feed cache had something to show at boot, refer to FeedCache.hpp
+bool  wifi_optional = false;  // feeds_restored, or replaying recorded feeds (FeedReplay.hpp), so don't wait on WiFi
+bool  clock_set = false;   // clockMain has had the time from the IoT endpoint
+bool  feed_bundle_mode = FEED_BUNDLE_MODE; // cleared if the IoT proxy doesn't understand action=bundle
+bool  marquee_mode = MARQUEE_MODE;         // lists scroll as one, refer to Marquee.hpp
 
 // Current Custom User Message
 CustomMessage  customMessage;
@@ -175,7 +213,6 @@ char          parolaBuffer[MAX_TICKER_LENGTH] = {0};        // Generic Char Buff
 
 // For main loop event scheduling / duration calcuation
 unsigned long current_millisecond                 = 0;
-unsigned long previous_update_millisecond                = 0;
 //unsigned long leds_last_changed_millisecond       = 0; // leds (no longer operated)
 unsigned long last_brightness_change_millisecond  = 0; // matrix display
 
@@ -203,22 +240,46 @@ int             adc_darkness_threshold_maverage = 0; // lowest
 #include "TickerHTTPHandlers.hpp"   // EEPROM and HTTPServer Configuration Handlers
 //#include "CustomFastLED.h"    // custom gradient definition
 #include "CustomParola.hpp"
+#include "Marquee.hpp"          // Lists as one continuous scroll
+#include "DisplayEngine.hpp"    // Display frames on a timer, not loop()
+#include "DisplaySteps.hpp"     // What loop() draws for the states that take several passes
+#include "FeedStats.hpp"        // Per IoT action document sizes
+#include "ConditionalGet.hpp"   // ETag / Last-Modified of each feed
+#include "FeedScheduler.hpp"    // When each feed is next due
+#include "EndpointPool.hpp"     // Which IoT endpoint host is healthiest
+#include "IoTConnection.hpp"    // Keep-alive connection to the IoT endpoint
+#include "FeedReplay.hpp"       // Record the IoT endpoint's responses, and play them back
 #include "TickerSerialRead.hpp" // Custom actions 
 #include "UtilFunctions.hpp"
+#include "FeedFetch.hpp"        // Feed refresh that runs alongside the display
+#include "FeedCache.hpp"        // Last good feeds, kept on LittleFS for the next boot
 
 
 
 /*---------------------------------- FUNCTION DEFS ----------------------------------*/
-bool getAllFeedData();
-bool getWeatherForecastData();
-bool getWeatherCurrentData();
+bool startFeedUpdate(int feed);
+void addFeedSections(int feed);
+void finishFeedUpdate();
+bool isFeedEnabled(int feed);
 bool is_valid_symbol (char *symbol);
 
-bool getCryptoData();
-bool getStonksData();
-bool getNewsFeedData();
 bool getTimeFromServer();
-
+void setIoTEndpoints();
+
+void setMainClock(TimeProcessor &processor);
+void setExtraClock(TimeProcessor &processor, const String &tz, TimeLib2 &clock, String &timezone_name, bool &active);
+void checkWeatherCityId();
+
+String getWeatherParams();
+bool   hasCryptoSymbols();
+String getCryptoSymbols();
+String getCryptoCurrency();
+bool   hasStockSymbols();
+String getStockSymbols();
+bool   hasNewsFeeds();
+
+String getIoTRequestPath(const String& action_str, const String& params_str);
+int  http_get_v3(const String& action_str, const String& params_str, ConditionalGetEntry *validator = nullptr);
 bool get_json_and_parse_v3(JsonProcessor &parser, const String& action_str, const String& params_str);
 
 void checkForFirmwareUpdate();
@@ -231,6 +292,9 @@ void displayActivate()
 {
  // Setup and flush Dot Matrix Display immediately 
   Parola.begin(NUM_ZONES);
+  addCurrencyGlyphs(); // CustomParola.hpp
+  buildGlyphWidths();
+  displayEngine.begin(SCROLL_SPEED_MS_DELAY_NORMAL); // until the config says otherwise
   Parola.displayClear();
   Parola.displaySuspend(false);
   Parola.setInvert(false);
@@ -263,6 +327,12 @@ void displayActivate()
 // This gets called if captive portal is required.
 bool atDetect(IPAddress& softapIP) 
 {
+  // Showing the cached (or replayed) feeds instead. The portal stays up behind them (retainPortal).
+  if (wifi_optional) {
+    Sprintln(F(" * No WiFi yet. Captive Portal started in the background."));
+    return true;
+  }
+
   first_setup = true;
 
   Sprintln(F(" * No WiFi configuration found. Starting Portal."));
@@ -318,6 +388,15 @@ void setup()
     Serial.println(F("************* FILESYSTEM ERROR ***************"));
   }
 
+  // Whatever we had before the reboot, to show until it's been fetched again
+  feeds_restored = (feedCache.restore() > 0);
+
+  // Live from the IoT endpoint, unless built to record or replay
+  if (FEED_TRANSPORT_MODE != FEED_TRANSPORT_LIVE) setFeedTransportMode(FEED_TRANSPORT_MODE);
+
+  // A replay serves the time and the feeds from LittleFS, so it can do without WiFi as well
+  wifi_optional = feeds_restored || (feedTransportMode == FEED_TRANSPORT_REPLAY);
+
 
   /*-------------------- START THE NETWORKING --------------------*/
 
@@ -369,6 +448,16 @@ void setup()
   PortalConfig.autoReconnect = true;
   //PortalConfig.beginTimeout= 10000;
   PortalConfig.boundaryOffset = eeprom_addr_AutoConnectConfig;
+
+  // With cached feeds to show, or a replay, don't sit in Portal.begin() until WiFi connects. It
+  // gives up after FEED_CACHE_WIFI_WAIT_MS, and the captive portal (and reconnecting) carries on
+  // from Portal.handleRequest() in loop().
+  if (wifi_optional) {
+    PortalConfig.beginTimeout       = FEED_CACHE_WIFI_WAIT_MS;
+    PortalConfig.portalTimeout      = 1;      // ms, so begin() returns straight away...
+    PortalConfig.retainPortal       = true;   // ... but the portal keeps going
+    PortalConfig.reconnectInterval  = 1;      // Try the saved network again every 30s
+  }
   Portal.config(PortalConfig);
 
  // Starts user web site included the AutoConnect portal.
@@ -376,6 +465,9 @@ void setup()
   if (Portal.begin()) {
     Serial.println("Started, IP:" + WiFi.localIP().toString());
   }
+  else if (wifi_optional) {
+    Sprintln(feeds_restored ? F(" * No WiFi yet. Showing the cached feeds until there is.") : F(" * No WiFi yet. Replaying without it."));
+  }
   else {
     
     Sprintln(F("Something went wrong?"));
@@ -388,7 +480,7 @@ void setup()
 
 
   // Establish a connection with an autoReconnect option.
-  if (Portal.begin()) {
+  if ( (!wifi_optional || WiFi.status() == WL_CONNECTED) && Portal.begin() ) {
     Serial.println("WiFi connected: " + WiFi.localIP().toString());
   }
   Sprintln(F(" * Got past Portal.begin()"));
@@ -422,6 +514,8 @@ void setup()
   //webServer.on(F("/update"),           HTTPUpdateHandler); // Now handelled by ElegantOTA!!
   webServer.on(F("/onoff"),             HTTPDisplayOnOffHandler);
   webServer.on(F("/state"),             HTTPDisplayStateHandler);
+  webServer.on(F("/feeds.json"),        HTTPFeedHealthHandler);     // Health of each feed
+  webServer.on(F("/telemetry.json"),    HTTPFeedTelemetryHandler);  // Where each action's request time went
 
   // Final webserver catch-all
   webServer.onNotFound([]() {                              // If the client requests any URI
@@ -432,15 +526,20 @@ void setup()
   ElegantOTA.begin(&webServer);    // Start ElegantOTA
   webServer.begin();
 
-  Sprintln(F(" * Getting Time From Internet Endpoint "));
-  while (!getTimeFromServer() )  // Stay in the loop until we get internet connection.
+  // Starting from the feed cache, the time is the first feed loop() fetches instead (refer to
+  // FeedScheduler.hpp). Until then the clock says 1970, so the states that show it are skipped.
+  Sprintln(feeds_restored ? F(" * Showing Cached Feeds, Time To Follow ") : F(" * Getting Time From Internet Endpoint "));
+  setIoTEndpoints();
+  internet_up = !feeds_restored || (WiFi.status() == WL_CONNECTED);
+  while (!feeds_restored && !getTimeFromServer() )  // Stay in the loop until we get internet connection.
   { // while this is false        
         internet_up = false;  
+
         Parola.displayZoneText(ZONE_LEFT, "Could not connect to the Internet. Please check your Internet connection.", PA_LEFT, SCROLL_SPEED_MS_DELAY_SLOW, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);                     
 
         while ( !allZoneAnimationsCompleted() )
         {
-              Parola.displayAnimate();
+              serviceDisplay();
               webServer.handleClient();       // Handle any requests as they come.
               handleSerialRead(); // defined in TickerSerialRead.h
 
@@ -449,7 +548,6 @@ void setup()
               #endif   
         }        
   }
-  internet_up = true;
   
   
   // Display configuration
@@ -462,6 +560,13 @@ void setup()
   userDisplayStates.insert({S_COUNTDOWN,  displayState(0,tickerConfig.ticker_content_freq_countdown,-1,"COUNTDOWN")}); 
 
   Sprintln(F("Setup completed!"));
+
+  // Straight on to the cached feeds. The address is only in the serial log.
+  if (feeds_restored) {
+    if (WiFi.status() == WL_CONNECTED) Serial.println("Access this device @ http://" + WiFi.localIP().toString());
+    return;
+  }
+
   show_starting_greeting();
 
   Parola.displayClear();
@@ -545,23 +650,44 @@ void determineNextDisplayState()
  * itertion loop. Pass by reference to avoid copy.
  * https://arstechnica.com/civis/viewtopic.php?t=722588
  */
-void displayStringList(std::list<std::string> &string_list)
+template <typename T>
+void displayStringList(std::shared_ptr<const T> latest_list, size_t limit = SIZE_MAX)
 {
   
-          if (string_list.size() == 0) {
-           Sprintln(F("No items in this list... breaking."));
-          return;
-        }
-  
         if (displayStateCompleted) { // we've come in from some other displayState having completed
-          string_list_itr = string_list.begin(); 
+
+          if (feedLineCount(*latest_list) == 0) {
+            Sprintln(F("No items in this list... breaking."));
+            return;
+          }
+
+          string_list       = latest_list;    // Stick with this generation until we're through it
+          string_list_rows  = feedLineCount(*latest_list);
+          string_list_row   = 0;
+          string_list_line  = [](const void *list, size_t row, char *buffer, size_t size) {
+              return feedLine(*(const T *) list, row, buffer, size);    // Rendered as it's shown, refer to FeedRender.hpp
+          };
           displayStateCompleted = false;
           tmp_counter = 0;
+
+          // The whole list in one go, pulled a line at a time as the marquee gets to it
+          if (marquee_mode) {
+            if (string_list_rows > limit) string_list_rows = limit;
+
+            marquee.start([](char *buffer, size_t size) -> const char* {
+                if (string_list_row >= string_list_rows) return nullptr;
+                return string_list_line(string_list.get(), string_list_row++, buffer, size);
+            }, parola_display_speed);
+
+            displayStateCompleted = true;
+            return;
+          }
         }
 
-        Parola.displayZoneText(ZONE_LEFT, string_list_itr->c_str(), PA_RIGHT, parola_display_speed, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);   
+        const char *line = string_list_line(string_list.get(), string_list_row, parolaBuffer, sizeof(parolaBuffer));
+        Parola.displayZoneText(ZONE_LEFT, line, PA_RIGHT, parola_display_speed, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);   
 
-        if (++string_list_itr == string_list.end()) // iterate to next forecast.. but check that there isn't a next one
+        if (++string_list_row >= string_list_rows) // iterate to next forecast.. but check that there isn't a next one
             displayStateCompleted = true;      
 
         tmp_counter++;
@@ -578,7 +704,11 @@ void loop()
     webServer.handleClient();       // Handle any requests as they come.
 
     Portal.handleRequest();   // Need to handle AutoConnect menu.
-    if (WiFi.status() == WL_IDLE_STATUS) {
+
+    // Booted from the feed cache, the station may well sit idle until the portal's reconnect
+    // gets it going, so that's no reason to reset. Not until WiFi has been up long enough for the time.
+    // Nor ever while replaying, which doesn't need it.
+    if (WiFi.status() == WL_IDLE_STATUS && (clock_set || !feeds_restored) && feedTransportMode != FEED_TRANSPORT_REPLAY) {
     #if defined(ARDUINO_ARCH_ESP8266)
         ESP.reset();
     #elif defined(ARDUINO_ARCH_ESP32)
@@ -635,13 +765,18 @@ void loop()
       adc_last_sampled_millisecond = current_millisecond;
     } // end ADC value check / check every second
 
-     // If we're still animating, then no action required.
-    if ( !allZoneAnimationsCompleted() ) 
+    // A feed refresh in progress gets a few ms of every loop(), so the display keeps moving.
+    if (feedFetch.busy())
     {
-      Parola.displayAnimate();
-      return; // don't go any further from here
+      feedFetch.poll(FEED_FETCH_BUDGET_MS);
+      if (feedFetch.done()) finishFeedUpdate();
     }
 
+    // Frames run on the display engine's own tick (Parola, or the marquee when there is one),
+    // refer to DisplayEngine.hpp. If we're still animating, then no action required.
+    displayEngine.fetching = feedFetch.busy();
+    if ( displayEngine.service() ) return; // don't go any further from here
+
     // We have finised the current display state (because some last more that one loop of parola.)
     if (displayStateCompleted) 
     {
@@ -649,36 +784,35 @@ void loop()
       // Display is off.
       if (displayOn == false) {
         Parola.displayClear();        
-        delay(500);
+        displayEngine.wait(500);
         return;
       }
 
       //Sprintln(F("Display State completed: So determining next displayState"));
       determineNextDisplayState();
 
-      // Do we need to get new data?
-      if (  ( (current_millisecond - previous_update_millisecond) >= FEED_UPDATE_FREQUENCY_MS ) || reload_required) 
-      { 
-           Sprintln(F("Performing an update of feed data..."));         
+      // Refresh whichever feed is due. Only one per idle slot (or one bundle of everything
+      // that's due), so the display isn't held up by the lot of them.
+      if (reload_required) {
+          feedScheduler.schedule_all(current_millisecond);
+          reload_required = false;
+      }
 
-          // Do we still have internet?               
-          if (WiFi.status() != WL_CONNECTED) { 
-                internet_up = false; 
-          } else {
-                /* If this completes we assume the internet is up when in reality the user could
-                 * have chosen to show no content other than the TIME!
-                 */
-                internet_up = getAllFeedData(); 
-          }
+      if ( !feedFetch.busy() ) feedCache.poll(current_millisecond);
+
+      int feed = feedFetch.busy() ? FEED_NONE : feedScheduler.next_due(current_millisecond);
+      while (feed != FEED_NONE && !isFeedEnabled(feed)) { // Nothing to fetch, check again later
+          feedScheduler.skip(feed, current_millisecond);
+          feed = feedScheduler.next_due(current_millisecond);
+      }
+
+      if (feed != FEED_NONE)
+      {
+          Sprint(F("Performing an update of feed data: ")); Sprintln(feedScheduler.get(feed).action);
+
+          // Runs alongside the display from here on, see the top of loop()
+          if ( !startFeedUpdate(feed) ) internet_up = false;
 
-          if (internet_up ) { // Internet is up
-                previous_update_millisecond = current_millisecond;            
-                reload_required = false;
-          } else { // Internet is down, try again in 15 minutes
-              previous_update_millisecond += 60*1000*15; // add ten minutes
-               Sprintln(F("No Interenet, will try again in 15 minutes."));
-          }
-        
       } // end feed update check
 
     } // end displayState completed check
@@ -696,7 +830,8 @@ void loop()
         }
     } // end sleep wake mode - light
 
-    if (tickerConfig.wake_sleep_mode == SLEEP_WAKE_MODE_TIME) {
+    // The clock-based modes wait for the clock (it's 1970 when booted from the feed cache)
+    if (tickerConfig.wake_sleep_mode == SLEEP_WAKE_MODE_TIME && clock_set) {
         bool _result = false;
         // Are we after the wakeup hour or minute
         if (  clockMain.hour() > int(tickerConfig.wakeup_hour) ) {  _result = true; }
@@ -715,7 +850,7 @@ void loop()
         }
     } // end sleep wake mode  - time  
 
-    if (tickerConfig.wake_sleep_mode == SLEEP_WAKE_WEEKDAY_WEEKEND) {
+    if (tickerConfig.wake_sleep_mode == SLEEP_WAKE_WEEKDAY_WEEKEND && clock_set) {
         if (  ( clockMain.weekday() == 1 || clockMain.weekday() == 7) ) { // Weekend Day
           if (clockMain.hour() > 9 && clockMain.hour() < 22) { // between 9am and 10pm
             if (currentDisplayState == BLACKOUT) {  currentDisplayState = S_TIME;
@@ -787,12 +922,19 @@ void loop()
         parola_display_pause = 1000;      
         break;        
     }
+    displayEngine.setFramePeriod(parola_display_speed);
 
     //*************************** DISPLAY STATES ***************************/
     switch (currentDisplayState)
     {
       case S_TIME: // Current Time
       {
+        // Not until we've had the time. Booted from the feed cache, that can be a while.
+        if (!clock_set) {
+          displayStateCompleted = true;
+          break;
+        }
+
         Sprintln(F("Showing Time."));      
         getFormattedTimeToCharBuffer(parolaBuffer, clockMain);
 
@@ -868,6 +1010,11 @@ void loop()
 
       case S_DATE: // Current Date
       {
+        if (!clock_set) {
+          displayStateCompleted = true;
+          break;
+        }
+
         Sprintln(F("Showing Date."));
         getFormattedDateToCharBuffer(parolaBuffer, clockMain);
         Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_CENTER, parola_display_speed, parola_display_pause, PA_PRINT);
@@ -878,25 +1025,26 @@ void loop()
       case S_WEATHER_C: // Current Weather
       {
         Sprintln(F("Showing Weather."));   
+        current_weather = CurrentWeatherFeed.current();
         Parola.displayClear(ZONE_LEFT);   
-        Parola.displayZoneText(ZONE_LEFT, CurrentWeather_str.c_str(), PA_RIGHT, parola_display_speed, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);              
+        Parola.displayZoneText(ZONE_LEFT, current_weather->text.c_str(), PA_RIGHT, parola_display_speed, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);              
         displayStateCompleted = true;
       }
         break;
 
       case S_WEATHER_F: // Forecast Weather
       {
-        if (WeatherForecasts_str.size() == 0) {
+        if (displayStateCompleted && WeatherForecastFeed.current()->items.empty()) {
            Sprintln(F("No Weather... breaking."));
           break;
         }
-        displayStringList(WeatherForecasts_str);
+        displayStringList(WeatherForecastFeed.current());
       }
         break;
 
       case S_NEWS:
       {
-        if (NewsHeadlines_str.size() == 0) {
+        if (displayStateCompleted && NewsFeed.current()->size() == 0) {
            Sprintln(F("No News... breaking."));
           break;
         }
@@ -908,84 +1056,50 @@ void loop()
         }
 
         // else show news
-        displayStringList(NewsHeadlines_str);
+        displayStringList(NewsFeed.current(), tickerConfig.news_limit);
       }
         break;
 
       case S_CRYPTO:
       { 
         // https://stackoverflow.com/questions/11578936/getting-a-bunch-of-crosses-initialization-error
-        if (CryptoTicker_str.size() == 0) {
-           Sprintln(F("No Crypto... breaking."));
-          break;
-        } 
-
         if (displayStateCompleted == true)
         {
+          if (CryptoFeed.current()->empty()) {
+            Sprintln(F("No Crypto... breaking."));
+            break;
+          } 
+
           displayStateActivityStep = 0; // sub actions
-          crypto_list_itr = CryptoTickers.begin(); 
+          crypto_table    = CryptoFeed.current();  // Stick with this generation until we're through it
+          crypto_row      = 0;
           displayStateCompleted = false;
 
-          Parola.setZone(ZONE_RIGHT, 0, 0);               // Zone 0 we don't use just yet...
-          Parola.setZone(ZONE_LEFT, 1, MAX_DEVICES-1);   
-       
+          beginTickerRows();  // Zone 0 we don't use just yet...
         }
 
-          Sprint(F("Showing crypto: ")); Sprintln(crypto_list_itr->name);
+          Sprint(F("Showing crypto: ")); Sprintln(crypto_table->name(crypto_row));
           Sprint(F("displayStateActivityStep: ")); SprintlnDEC(displayStateActivityStep, DEC);
 
-          textEffect_t text_effect;
-
-          // Price go up or down?
-          text_effect = (crypto_list_itr->percent_change_24h > 0) ? PA_SCROLL_UP:PA_SCROLL_DOWN;          
-
-            switch(displayStateActivityStep)
-            {
-              case 0:
-                Parola.displayZoneText(ZONE_LEFT, crypto_list_itr->name, PA_CENTER, 0, 2000, PA_RANDOM, PA_NO_EFFECT);  // Name                   
-                Parola.displayClear(ZONE_RIGHT); // clear the new zone
-                displayStateActivityStep++;
-                break;
-
-              case 1:
-                Parola.displayZoneText(ZONE_RIGHT, crypto_list_itr->parola_upordown_code, PA_CENTER, parola_display_speed, 2000, text_effect, PA_NO_EFFECT);  // Arrow
-                displayStateActivityStep++;
-                break;
-
-              case 2:
-                snprintf_P(parolaBuffer, sizeof(parolaBuffer), "%s%0.2lf", crypto_list_itr->parola_currency_code, crypto_list_itr->price_reporting_ccy); 
-                Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_CENTER, parola_display_speed, 2000, text_effect, text_effect);  // Price
-                displayStateActivityStep++;
-                break;
-
-              case 3:
-                snprintf_P(parolaBuffer, sizeof(parolaBuffer), "%0.2lf%%",crypto_list_itr->percent_change_24h); 
-                Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_CENTER, parola_display_speed, 2000, text_effect, text_effect);  // Price
-                displayStateActivityStep++;
-                break;
-
-              default:
-                if (++crypto_list_itr == CryptoTickers.end()) { // iterate to next forecast.. but check that there isn't a next one
-                    displayStateCompleted = true;   
-                    setDefaultZoneSizes(); // back to normal
-                    Parola.displayClear();
-                }                
-
-                  displayStateActivityStep = 0;
-                  Sprintln("Setting to zero...");
-                break;
-            }
+          // Name, arrow, price and change, refer to DisplaySteps.hpp
+          if ( showTickerRowStep(*crypto_table, crypto_row, displayStateActivityStep) ) {
+              displayStateActivityStep++;
+          } else {
+              if (++crypto_row >= crypto_table->size()) { // iterate to next forecast.. but check that there isn't a next one
+                  displayStateCompleted = true;   
+                  endTickerRows();
+              }                
 
-          // Display old school strings
-          //displayStringList(CryptoTicker_str);
+              displayStateActivityStep = 0;
+              Sprintln("Setting to zero...");
+          }
        }
         break;       
 
 
       case S_COUNTDOWN:
       { // https://stackoverflow.com/questions/11578936/getting-a-bunch-of-crosses-initialization-error
-        // Not ideal to in
-        if ( strlen(tickerConfig.countdown_name) < 3 || (tickerConfig.countdown_datetime < current_timestamp) ) {
+        if ( !clock_set || !countdownValid(current_timestamp) ) {
            Sprintln(F("No valid countdown... breaking."));
           break;
         } 
@@ -994,48 +1108,14 @@ void loop()
         {
           displayStateActivityStep = 0; // sub actions
           displayStateCompleted = false;
-          displayStateStartTS = current_timestamp;
         }
 
-        // Difference from now.
-        int difference = tickerConfig.countdown_datetime - current_timestamp;
-
-        // From DateTime.h
-        int days = elapsedDays(difference);
-        int hours = numberOfHours(difference);
-        int minutes = numberOfMinutes(difference);
-        int seconds = numberOfSeconds(difference);   
-
-        if (displayStateActivityStep == 0)
+        // The title, then the time left until parola_display_pause is up, refer to DisplaySteps.hpp
+        if ( !showCountdownStep(current_timestamp, displayStateActivityStep, displayStateStartTS) )
         {
-             displayStateStartTS = current_timestamp;          
-            snprintf_P(parolaBuffer, sizeof(parolaBuffer), "Countdown to %s \x10 \x10", tickerConfig.countdown_name);
-            printTextOrScrollLeft(parolaBuffer, false, parola_display_speed);  
-            displayStateActivityStep++; // only do this once
+          displayStateCompleted = true;   
+          displayStateActivityStep = 0;   
         }
-        else
-        {
-          if (days > 0) {
-            snprintf_P(parolaBuffer, sizeof(parolaBuffer), "%dd %02dh %02dm", days, hours, minutes);            
-          } else {
-            /* code */
-            // TODO: https://forum.arduino.cc/index.php?topic=645252.0
-            // Fix shift of pixels due to '1' being a smaller character
-            snprintf_P(parolaBuffer, sizeof(parolaBuffer), "%02dh %02dm %02ds", hours, minutes, seconds);
-          }
-
-            Parola.displayZoneText(ZONE_LEFT, parolaBuffer, PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);    
-            //printTextOrScrollLeft(parolaBuffer, true);  // print in centre    
-            delay(100);
-        }
-                    //Serial.println( (current_timestamp - displayStateStartTS), DEC)            ;
-
-        if ( (current_timestamp - displayStateStartTS) > (parola_display_pause/1000) )
-        {
-                    displayStateCompleted = true;   
-                    displayStateActivityStep = 0;   
-                    break;    
-         }
 
        } // end countdown
       break;       
@@ -1043,24 +1123,18 @@ void loop()
 
       case S_STOCK:
       {
-        if (EquitiesTicker_str.size() == 0) {
+        if (displayStateCompleted && EquitiesFeed.current()->empty()) {
            Sprintln(F("No Stocks... breaking."));
           break;
         }
-        displayStringList(EquitiesTicker_str);  
+        displayStringList(EquitiesFeed.current());  
       }      
         break;        
 
       case S_MESSAGE:
       {
         Sprintln(F("Showing Message."));   
-
-        // message is grater than about 10 characters... will need to scroll
-        if (customMessage.message_length > 10) {
-          Parola.displayZoneText(ZONE_LEFT, customMessage.message, PA_LEFT, SCROLL_SPEED_MS_DELAY_SLOW, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);              
-        } else {
-          Parola.displayZoneText(ZONE_LEFT, customMessage.message, PA_CENTER, SCROLL_SPEED_MS_DELAY_SLOW, parola_display_pause, PA_PRINT);                        
-        } 
+        showCustomMessage();
         displayStateCompleted = true;
       }     
         break;
@@ -1069,7 +1143,7 @@ void loop()
       {
         printTextOrScrollLeft("No WiFi !", true);
          Sprintln(F("No Wifi !"));
-        delay(5000);
+        displayEngine.wait(5000);
       }
         break;
 
@@ -1079,308 +1153,448 @@ void loop()
     } // end Switch Statement
 } // end loop
 
-bool getAllFeedData()
+/*
+ * The processors of a feed refresh in progress. The fetch runs over many passes of loop(),
+ * so they can't live on the stack. Refer to FeedFetch.hpp.
+ */
+struct FeedProcessors
 {
-  bool success = true;
+  CurrentWeatherProcessor   weather;
+  ForecastWeatherProcessor  forecast;
+  TickerProcessor           crypto;
+  TickerProcessor           stocks;
+  NewsProcessor             news;
+  TimeProcessor             time_1;
+  TimeProcessor             time_2;
+  TimeProcessor             time_3;
+};
 
-  if (WiFi.status() != WL_CONNECTED)
+FeedProcessors *feedProcessors = nullptr;
+
+/*
+ * Start fetching a feed the scheduler says is due. In bundle mode everything else that's due
+ * comes along in the same request:
+ *
+ *    ?action=bundle&sections=weather,weather_forecast,ticker,stock,news,time,time_2,time_3&...
+ *
+ * The bundle parameters are the same as for the individual actions, except the ones that
+ * would clash (ticker_symbol, stock_symbol, timezone_2, timezone_3).
+ *
+ * loop() then advances it with feedFetch.poll(), and calls finishFeedUpdate() once it's done.
+ */
+bool startFeedUpdate(int feed)
+{
+  // Replays don't need it
+  if (WiFi.status() != WL_CONNECTED && feedTransportMode != FEED_TRANSPORT_REPLAY)
   {
-    Sprintln (F("Error: getAllFeedData - Not connected to WiFi!"));
-    success = false;
+    Sprintln (F("Error: startFeedUpdate - Not connected to WiFi!"));
+    feedScheduler.completed(feed, false, millis(), 0, FEED_ERROR_NO_WIFI);
+    return false;
   }
 
-  if ( tickerConfig.ticker_content_freq_weather != TICKER_CONTENT_FREQ_NEVER) {
-    if (success) success &= getWeatherCurrentData();    
-    if (success) success &= getWeatherForecastData();
-  } else { Sprintln(F("getAllFeedData(): User configuration skips weather data.")); }
-
-  if ( tickerConfig.ticker_content_freq_crypto != TICKER_CONTENT_FREQ_NEVER) {
-    if (success) success &= getCryptoData();
-  } else { Sprintln(F("getAllFeedData(): User configuration skips crypto data.")); }
+  feedProcessors = new FeedProcessors();
 
-  if ( tickerConfig.ticker_content_freq_news != TICKER_CONTENT_FREQ_NEVER) {
-    if (success) success &= getNewsFeedData();
-  } else { Sprintln(F("getAllFeedData(): User configuration skips news data.")); }
+  feedProcessors->weather.set_gmt_offset(clockMainOffset);
+  feedProcessors->forecast.set_gmt_offset(clockMainOffset);
+  feedProcessors->crypto.set_crypto_mode(true);
+  feedProcessors->stocks.set_crypto_mode(false);
+  feedProcessors->news.set_limit(tickerConfig.news_limit); // Streamed, so the limit is no longer bound by memory
 
-  if ( tickerConfig.ticker_content_freq_stock != TICKER_CONTENT_FREQ_NEVER) {
-    if (success) success &= getStonksData();
-  } else { Sprintln(F("getAllFeedData(): User configuration skips stocks data.")); }  
+  feedFetch.clear();
 
-  // Get additional clocks
-    TimeProcessor processor; 
-    time_t tmp_unix_timestamp = 0;     
-    time_t tmp_offset         = 0;           
-    String tmp_clock_tz = String(tickerConfig.clock_2_timezone);  
-    if ( tmp_clock_tz.length() > 2 )
-    {
-      Sprintln(F("Getting time data for secondary clock."));
-      if (   get_json_and_parse_v3(processor, "time", "timezone=" + tmp_clock_tz) )  
-      {
-        
-          processor.update(tmp_unix_timestamp, tmp_offset);
+  if (feed_bundle_mode)
+  {
+    // One round trip for everything that's due, if the IoT proxy is up for it.
+    for (int i = 0; i < FEED_COUNT; i++) {
+      if ( feedScheduler.is_due(i, millis()) && isFeedEnabled(i) ) addFeedSections(i);
+    }
+  }
+  else
+  {
+    addFeedSections(feed);
+  }
 
-          // Set the global time via TimeLib.h, set to GMT
-          clock2.setTime(tmp_unix_timestamp);
+  feedFetch.start(feed_bundle_mode);
+  return true;
 
-          // Set the offset for this TZ
-          clock2.setOffset(tmp_offset);
+} // startFeedUpdate
 
-          if (tmp_clock_tz.indexOf("/") == -1) { // isn't in the format of 'Australia/Sydney' or anything, so just use the full name
-            clock2TimezoneName = tmp_clock_tz;
-          }
-          else
-          {
-            clock2TimezoneName = tmp_clock_tz.substring(tmp_clock_tz.lastIndexOf("/")+1);            
-          }
+// The sections (i.e. requests, when not bundled) that make up a feed
+void addFeedSections(int feed)
+{
+  FeedProcessors &p = *feedProcessors;
 
-          clock2_active = true;
+  switch (feed)
+  {
+    case FEED_WEATHER:
+      feedFetch.add("weather",          "weather",          &p.weather,   feed, getWeatherParams(), getWeatherParams());
+      break;
 
-          Sprintln(F("Clock 2 active."));          
-      }
-    }
+    case FEED_WEATHER_FORECAST:
+      feedFetch.add("weather_forecast", "weather_forecast", &p.forecast,  feed, getWeatherParams(), getWeatherParams());
+      break;
 
-    tmp_clock_tz = String(tickerConfig.clock_3_timezone);  
-    if ( tmp_clock_tz.length() > 2 )
-    {
-      Sprintln(F("Getting time data for third clock."));
-      if (   get_json_and_parse_v3(processor, "time", "timezone=" + tmp_clock_tz) )  
-      {
-          processor.update(tmp_unix_timestamp, tmp_offset);
+    case FEED_TICKER: // by default the iot proxy script will return the top 20 or so.
+      feedFetch.add("ticker",           "ticker",           &p.crypto,    feed, "currency=" + getCryptoCurrency() + "&symbol=" + getCryptoSymbols(), "currency=" + getCryptoCurrency() + "&ticker_symbol=" + getCryptoSymbols());
+      break;
 
-          // Set the global time via TimeLib.h, set to GMT
-          clock3.setTime(tmp_unix_timestamp);
+    case FEED_STOCK:
+      feedFetch.add("stock",            "stock",            &p.stocks,    feed, "symbol=" + getStockSymbols(), "stock_symbol=" + getStockSymbols());
+      break;
 
-          // Set the offset for this TZ
-          clock3.setOffset(tmp_offset);
+    case FEED_NEWS:
+      feedFetch.add("news",             "news",             &p.news,      feed, "feed=" + String(tickerConfig.news_codes), "feed=" + String(tickerConfig.news_codes));
+      break;
 
-          if (tmp_clock_tz.indexOf("/") == -1) { // isn't in the format of 'Australia/Sydney' or anything, so just use the full name
-            clock3TimezoneName = tmp_clock_tz;
-          }
-          else
-          {
-            clock3TimezoneName = tmp_clock_tz.substring(tmp_clock_tz.lastIndexOf("/")+1);            
-          }
+    case FEED_TIME: // Main clock (picks up daylight saving changes), and the additional clocks
+    {
+      feedFetch.add("time",             "time",             &p.time_1,    feed, "timezone=" + String(tickerConfig.clock_timezone), "timezone=" + String(tickerConfig.clock_timezone));
 
-          clock3_active = true;
+      String clock_2_tz = String(tickerConfig.clock_2_timezone);
+      if ( clock_2_tz.length() > 2 ) {
+        feedFetch.add("time_2",         "time",             &p.time_2,    feed, "timezone=" + clock_2_tz, "timezone_2=" + clock_2_tz);
+      }
 
-          Sprintln(F("Clock 3 active."));                    
+      String clock_3_tz = String(tickerConfig.clock_3_timezone);
+      if ( clock_3_tz.length() > 2 ) {
+        feedFetch.add("time_3",         "time",             &p.time_3,    feed, "timezone=" + clock_3_tz, "timezone_3=" + clock_3_tz);
       }
+      break;
     }
+  }
+}
 
-    return success;
+// Follow up on a completed feedFetch, and tell the scheduler how each feed went.
+void finishFeedUpdate()
+{
+  // No section came back from the bundle. Same sections again, one request each. Only if the
+  // proxy doesn't understand action=bundle (it refused it, or answered in full without any
+  // section we asked for) are bundles off until 'xb' or a reboot. A 5xx or a body cut short
+  // is the link or the host, as EndpointPool sees it, so the next refresh bundles again. A
+  // negative code is no answer at all (no connection, a timeout), so that isn't retried here.
+  if (feedFetch.is_bundle() && feedFetch.http_code > 0 && feedFetch.received == 0)
+  {
+    int  code     = feedFetch.http_code;
+    bool refused  = (code == HTTP_CODE_BAD_REQUEST || code == HTTP_CODE_NOT_FOUND || code == HTTP_CODE_NOT_IMPLEMENTED);
 
-} // get all feed data
+    if (refused || feedFetch.bundle_completed) {
+      Sprintln(F("finishFeedUpdate(): IoT proxy doesn't do bundles. Using one request per feed."));
+      feed_bundle_mode = false;
+    } else {
+      Sprintln(F("finishFeedUpdate(): Bundle failed. One request per feed, this time only."));
+    }
+    feedFetch.start(false);
+    return;
+  }
 
+  FeedProcessors &p = *feedProcessors;
 
+  bool          fetched[FEED_COUNT] = { false };
+  bool          results[FEED_COUNT];
+  unsigned long latencies[FEED_COUNT];
+  int           errors[FEED_COUNT];
 
-/******************************* DATA GATHERING FUNCTIONS  *********************************/
-// Query to get current weather: http://api.openweathermap.org/data/2.5/weather?id=2643743&appid=700650b72d30a4662143cc010c89f700&units=metric
-// We use ArduinoJSON for this as the returned data size is small enough.
-bool getWeatherCurrentData() {
-   Sprintln(F("Obtaining Current Weather Data..."));
-   
-   CurrentWeatherProcessor processor;
+  for (size_t i = 0; i < feedFetch.section_count; i++)
+  {
+    JsonBundleSection &section  = feedFetch.sections[i];
+    FeedFetchPart     &part     = feedFetch.parts[i];
+    int               feed      = part.feed;
+
+    if (!fetched[feed]) {
+      fetched[feed]   = true;
+      results[feed]   = true;
+      latencies[feed] = 0;
+      errors[feed]    = FEED_ERROR_NONE;
+    }
 
-   processor.set_gmt_offset(clockMainOffset);
+    if (!section.result) {
+      Sprint(F("finishFeedUpdate(): Missing or failed section: ")); Sprintln(section.name);
+    }
 
-  if ( 
-        !get_json_and_parse_v3( processor,"weather",
-                      String("city_id=" + String(tickerConfig.weather_city_id) + "&city_name=" + String(tickerConfig.weather_city_name))
-      ))  {  
-            Sprintln(F("Failed to request and parse current weather."));
-           return false;
-   }
+    if (section.processor == &p.time_2) {
+      if (section.result) setExtraClock(p.time_2, String(tickerConfig.clock_2_timezone), clock2, clock2TimezoneName, clock2_active);
+      continue; // additional clocks are a nice to have
+    }
 
-   if( strcmp(CurrentWeather.city_id, tickerConfig.weather_city_id) != 0)
-   {
-      Sprintln(F("Open Weather Maps City ID's don't match. Updating EEPROM"));
-     EEPROM_cache_weather_city_id(CurrentWeather.city_id, sizeof(CurrentWeather.city_id));
-   }
-    return true;
-} // get current weather data
+    if (section.processor == &p.time_3) {
+      if (section.result) setExtraClock(p.time_3, String(tickerConfig.clock_3_timezone), clock3, clock3TimezoneName, clock3_active);
+      continue;
+    }
 
-// Query to get forecast:  http://api.openweathermap.org/data/2.5/forecast?id=2643743&appid=700650b72d30a4662143cc010c89f700&units=metric
-bool getWeatherForecastData() {
+    if (section.processor == &p.time_1 && section.result) {
+      setMainClock(p.time_1);
+    }
 
-  ForecastWeatherProcessor processor;  // Open Weather Map JSON Streaming Parser
+    if (section.processor == &p.weather && section.result) {
+      checkWeatherCityId();
+    }
 
-  processor.set_gmt_offset(clockMainOffset);
+    results[feed] &= section.result;
 
-  // Populate this into the global httpResponse variable
-  if ( !get_json_and_parse_v3(processor, "weather_forecast", String("city_id=" + String(tickerConfig.weather_city_id) + "&city_name=" + String(tickerConfig.weather_city_name))) )  {
-         Sprintln(F("Failed to request and parse weather forecast."));
-        return false;
+    latencies[feed] = max(latencies[feed], part.latency_ms);
+    if (errors[feed] == FEED_ERROR_NONE) errors[feed] = part.error;
   }
 
-  return true;
-} // end weather forecast.
-
-// Get the Crypto Data
-bool getCryptoData() {
-   // Sprintln(F("Using the new Crypto Ticker data gathering function..."));
-
-  // 1. Do we have at least one ticker value and a currency?
-  if (  !(is_valid_symbol(tickerConfig.crypto_1) || 
-        is_valid_symbol(tickerConfig.crypto_2) ||
-        is_valid_symbol(tickerConfig.crypto_3) ||
-        is_valid_symbol(tickerConfig.crypto_4) ||
-        is_valid_symbol(tickerConfig.crypto_5) ||
-        is_valid_symbol(tickerConfig.crypto_6))
-    )  {
-     Sprintln(F("getCryptoData: No ticker symbols provided."));
-    return true;
+  /* If this completes we assume the internet is up when in reality the user could
+   * have chosen to show no content other than the TIME!
+   */
+  internet_up = true;
+
+  for (int i = 0; i < FEED_COUNT; i++) {
+    if (!fetched[i]) continue;
+    feedScheduler.completed(i, results[i], millis(), latencies[i], errors[i]);
+    internet_up &= results[i];
   }
 
-  // 2. Setup JSON Parser
-  
-  TickerProcessor processor;
-  processor.set_crypto_mode(true); // poplate to crypto
-
-  // 3. Parse
-  String http_params; http_params.reserve(128);
-  http_params = "currency=USD"; //" + String(tickerConfig.ticker_currency); // by default the iot proxy script will return the top 20 or so.
-  http_params += "&symbol=" + 
-                    String(tickerConfig.crypto_1) + "," +
-                    String(tickerConfig.crypto_2) + "," +
-                    String(tickerConfig.crypto_3) + "," +
-                    String(tickerConfig.crypto_4) + "," +
-                    String(tickerConfig.crypto_5) + "," +                    
-                    String(tickerConfig.crypto_6);
-  
-  // 4. Obtain data.
-  if ( !get_json_and_parse_v3(processor, "ticker", http_params) ) {
-       Sprintln(F("Failed to get Crpyto Information"));
-      return false;
-   }
+  feedFetch.clear();
 
-   return true;
-} // getCryptoData
+  delete feedProcessors;
+  feedProcessors = nullptr;
 
-// Get the Stocks Data
-bool getStonksData() {
-  // 1. Do we have at least one ticker value and a currency?
-  if (  !(strlen(tickerConfig.stock_1) > 3) )  {
-     Sprintln(F("getStocksData: No valid stock symbols provided"));
-    return true;
+} // finishFeedUpdate
+
+// Is there anything to fetch for this feed with the user's configuration?
+bool isFeedEnabled(int feed)
+{
+  switch (feed)
+  {
+    case FEED_WEATHER:
+    case FEED_WEATHER_FORECAST: return (tickerConfig.ticker_content_freq_weather != TICKER_CONTENT_FREQ_NEVER);
+    case FEED_TICKER:           return (tickerConfig.ticker_content_freq_crypto  != TICKER_CONTENT_FREQ_NEVER) && hasCryptoSymbols();
+    case FEED_STOCK:            return (tickerConfig.ticker_content_freq_stock   != TICKER_CONTENT_FREQ_NEVER) && hasStockSymbols();
+    case FEED_NEWS:             return (tickerConfig.ticker_content_freq_news    != TICKER_CONTENT_FREQ_NEVER) && hasNewsFeeds();
   }
 
-  // 2. Setup JSON Parser
-  TickerProcessor processor;
-  processor.set_crypto_mode(false); // populate stock std::list
-
-  // 3. Parse
-  String http_params; http_params.reserve(128);
-  http_params = "symbol=" + 
-                    String(tickerConfig.stock_1) + "," +
-                    String(tickerConfig.stock_2) + "," +
-                    String(tickerConfig.stock_3) + "," +
-                    String(tickerConfig.stock_4) + "," +
-                    String(tickerConfig.stock_5) + "," +                    
-                    String(tickerConfig.stock_6);
-  
-  // 4. Obtain data.
-  if ( !get_json_and_parse_v3(processor, "stock", http_params) ) {
-       Sprintln(F("Failed to get Stock Information"));
-      return false;
-   }
+  return true; // time, always
+}
 
-   return true;
 
-} // getStocks
+// Apply a 'time' response to the main clock
+void setMainClock(TimeProcessor &processor)
+{
+    time_t unix_timestamp = 0;
 
-// Get the data from our IoT RSS Proxy
-bool getNewsFeedData() {
-  
-  // We actually have any news to share?
-  if ( strlen(tickerConfig.news_codes) < 2) {
-     Sprintln(F("No news feeds have been selected"));
-    return true;
-  }
+    processor.update(unix_timestamp, clockMainOffset);
 
-  NewsProcessor processor;
+    // Set the global time via TimeLib2.h, set to GMT
+    clockMain.setTime(unix_timestamp);
 
-  if (   !get_json_and_parse_v3(processor, "news", String("feed=" + String(tickerConfig.news_codes)))   )  {
-       Sprintln(F("Failed to get news!"));
-      return false;
-  }
+    // Set the offset for this TZ
+    clockMain.setOffset(clockMainOffset);
 
-  return true;
+    clock_set = true;
+}
 
-} // end news parser
 
-// Bootstrap the device and get the time from remote API server
-bool getTimeFromServer() 
+// Apply a 'time' response to one of the additional clocks
+void setExtraClock(TimeProcessor &processor, const String &tz, TimeLib2 &clock, String &timezone_name, bool &active)
 {
-    TimeProcessor processor;
+    time_t tmp_unix_timestamp = 0;     
+    time_t tmp_offset         = 0;           
 
-    time_t unix_timestamp = 0;
-    strncpy(global_endpoint_path,   IOT_ENDPOINT_PATH,          sizeof(global_endpoint_path) );
+    processor.update(tmp_unix_timestamp, tmp_offset);
 
-    strncpy(global_endpoint_host,   PRI_IOT_ENDPOINT_HOSTNAME,  sizeof(global_endpoint_host) );
+    // Set the global time via TimeLib.h, set to GMT
+    clock.setTime(tmp_unix_timestamp);
 
-    if (   get_json_and_parse_v3(processor, "time", "timezone=" + String(tickerConfig.clock_timezone)) )  
+    // Set the offset for this TZ
+    clock.setOffset(tmp_offset);
+
+    if (tz.indexOf("/") == -1) { // isn't in the format of 'Australia/Sydney' or anything, so just use the full name
+      timezone_name = tz;
+    }
+    else
     {
-        Sprintln(F("Got time from primary endpoint."));
-        processor.update(unix_timestamp, clockMainOffset);
+      timezone_name = tz.substring(tz.lastIndexOf("/")+1);            
+    }
 
-        // Set the global time via TimeLib.h, set to GMT
-        clockMain.setTime(unix_timestamp);
+    active = true;
+}
 
-        // Set the offset for this TZ
-        clockMain.setOffset(clockMainOffset);
 
-        return true;
-    
-    }
+/******************************* DATA GATHERING FUNCTIONS  *********************************/
+// Query string parts, shared by the individual requests and the bundle request.
+String getWeatherParams()
+{
+  return String("city_id=" + String(tickerConfig.weather_city_id) + "&city_name=" + String(tickerConfig.weather_city_name));
+}
 
-      strncpy(global_endpoint_host,   SEC_IOT_ENDPOINT_HOSTNAME,  sizeof(global_endpoint_host) );
+bool hasCryptoSymbols()
+{
+  return (is_valid_symbol(tickerConfig.crypto_1) || 
+          is_valid_symbol(tickerConfig.crypto_2) ||
+          is_valid_symbol(tickerConfig.crypto_3) ||
+          is_valid_symbol(tickerConfig.crypto_4) ||
+          is_valid_symbol(tickerConfig.crypto_5) ||
+          is_valid_symbol(tickerConfig.crypto_6));
+}
 
-      if (   get_json_and_parse_v3(processor, "time", "timezone=" + String(tickerConfig.clock_timezone)))  
-      {
-          Sprintln(F("Got time from secondary endpoint."));
-          processor.update(unix_timestamp, clockMainOffset);
+String getCryptoSymbols()
+{
+  return String(tickerConfig.crypto_1) + "," +
+         String(tickerConfig.crypto_2) + "," +
+         String(tickerConfig.crypto_3) + "," +
+         String(tickerConfig.crypto_4) + "," +
+         String(tickerConfig.crypto_5) + "," +                    
+         String(tickerConfig.crypto_6);
+}
 
-          // Set the global time via TimeLib2.h, set to GMT
-          clockMain.setTime(unix_timestamp);
+// Configs saved before the currency could be chosen have none
+String getCryptoCurrency()
+{
+  return (findCurrencyGlyph(tickerConfig.crypto_ccy) < 0) ? String(DEFAULT_CRYPTO_CCY) : String(tickerConfig.crypto_ccy);
+}
 
-          // Set the offset for this TZ
-          clockMain.setOffset(clockMainOffset);
+bool hasStockSymbols()
+{
+  return (strlen(tickerConfig.stock_1) > 3);
+}
 
-          return true;
-      }
+String getStockSymbols()
+{
+  return String(tickerConfig.stock_1) + "," +
+         String(tickerConfig.stock_2) + "," +
+         String(tickerConfig.stock_3) + "," +
+         String(tickerConfig.stock_4) + "," +
+         String(tickerConfig.stock_5) + "," +                    
+         String(tickerConfig.stock_6);
+}
+
+bool hasNewsFeeds()
+{
+  return (strlen(tickerConfig.news_codes) >= 2);
+}
+
+// We only do this ONCE when we've got the city id from Open Weather Maps
+void checkWeatherCityId()
+{
+   const WeatherInstance &weather = CurrentWeatherFeed.current()->weather;
+
+   if( strcmp(weather.city_id, tickerConfig.weather_city_id) != 0)
+   {
+      Sprintln(F("Open Weather Maps City ID's don't match. Updating EEPROM"));
+     EEPROM_cache_weather_city_id((char *) weather.city_id, sizeof(weather.city_id));
+   }
+}
+
+// Bootstrap the device and get the time from remote API server
+bool getTimeFromServer() 
+{
+    TimeProcessor processor;
+
+    setIoTEndpoints();
 
- 
+    // A host that fails is backed off, so the next attempt goes to the other one
+    for (int attempt = 0; attempt < endpointPool.size(); attempt++)
+    {
+        if (   get_json_and_parse_v3(processor, "time", "timezone=" + String(tickerConfig.clock_timezone)) )  
+        {
+            Sprintln(F("Got time from the IoT endpoint."));
+            setMainClock(processor);
+
+            return true;
+        }
+    }
 
     return false;
 
 } // end getTimeFrom Server
 
-// Stream based parser of v3 API feed
-bool get_json_and_parse_v3(JsonProcessor &parser, const String& action_str, const String& params_str)
+// Where the requests go, refer to EndpointPool.hpp
+void setIoTEndpoints()
 {
-    client.flush();
+    strncpy(global_endpoint_path,   IOT_ENDPOINT_PATH,          sizeof(global_endpoint_path) );
+
+    endpointPool.add(PRI_IOT_ENDPOINT_HOSTNAME);
+    endpointPool.add(SEC_IOT_ENDPOINT_HOSTNAME);
+}
 
-    String url = "http://" + String(global_endpoint_host) +  String(global_endpoint_path) + "?action=" + action_str + "&did=" + String(systemConfig.device_id) + "&" + params_str;
-    Sprint(F("> Getting JSON data from URL: ")); Sprintln(url);
+// Path and query of a v3 API request for an action, on whichever endpoint host
+String getIoTRequestPath(const String& action_str, const String& params_str)
+{
+    String path = String(global_endpoint_path) + "?action=" + action_str + "&did=" + String(systemConfig.device_id) + "&" + params_str;
+    if (iotConnection.msgpack) path += F("&format=msgpack");
+    if (iotConnection.compress) path += "&deflate_window_bits=" + String(INFLATE_WINDOW_BITS);
+
+    return path;
+}
+
+// Send a v3 API request and wait for the response headers. Returns the HTTP status code.
+// With a validator the request is conditional, and may return HTTP_CODE_NOT_MODIFIED.
+int http_get_v3(const String& action_str, const String& params_str, ConditionalGetEntry *validator)
+{
+    // start connection (or reuse the open one) and send HTTP header
+    return feedTransport->get(endpointPool.select(millis()), getIoTRequestPath(action_str, params_str), validator);
+}
+
+// Stream based parser of v3 API feed. Where the time went is in parse_us, for the telemetry.
+bool get_json_and_parse_v3_response(JsonProcessor &parser, const String& action_str, const String& params_str, unsigned long &parse_us)
+{
+    // Send the ETag / Last-Modified of what we already have, see ConditionalGet.hpp
+    ConditionalGetEntry *validator = parser.conditional_get() ? conditionalGets.find(action_str, params_str) : nullptr;
+
+    int httpCode = http_get_v3(action_str, params_str, validator);
+
+    if (httpCode == HTTP_CODE_NOT_MODIFIED && validator)
+    {
+      Sprintln(F("Not modified. Keeping what we have."));
+      validator->hits++;
+      feedTransport->end();
+      return true;
+    }
 
-    http.setUserAgent("RetroTicker/2.0 (ESP)"); 
-    http.setTimeout(8000);
-    http.begin(client, url);
-    http.useHTTP10(true);        
-        // start connection and send HTTP header
-    int httpCode = http.GET();
     if (httpCode == HTTP_CODE_OK) 
     {    
-      // Get a reference to the stream in HTTPClient
-      Stream& response = http.getStream();
+      if (validator) validator->misses++;
+
+      // Get a reference to the response body (chunked or not)
+      Stream& response = feedTransport->stream();
+
+      // News and forecast go item by item, and never hold the full document in memory.
+      if (parser.supports_streaming())
+      {
+        bool parser_res = streamJsonItems(response, parser, action_str.c_str(), 8000, feedTransport->msgpack_response, &parse_us);
+
+        if (parser_res) {
+            Sprintln("Streamed JSON OK.");
+        } else {
+            Sprintln("Failed to stream JSON!");
+        }
+
+        // Only remember validators for what we actually managed to parse
+        if (validator) conditionalGets.store(validator, parser_res ? feedTransport->etag : "", parser_res ? feedTransport->last_modified : "");
+
+        if (parser_res) feedTransport->body_parsed();
+        feedTransport->end();
+        return parser_res;
+      }
+
+      // Only keep the fields the processor reads, and size the document from that.
+      StaticJsonDocument<256> filter;
+      parser.build_filter(filter);
 
       // Allocate the JsonDocument in the heap
-      DynamicJsonDocument doc(8000);
+      DynamicJsonDocument doc(parser.document_capacity(filter));
 
-      // Deserialize the JSON document in the response
-      deserializeJson(doc, response);
-      
+      if (doc.capacity() == 0) {
+        Sprintln(F("Failed to allocate JSON document!"));
+        feedTransport->end();
+        return false;
+      }
+
+      // Deserialize the JSON (or MessagePack) document in the response
+      DeserializationError error = feedTransport->msgpack_response ? deserializeMsgPack(doc, response, DeserializationOption::Filter(filter))
+                                                                  : deserializeJson(doc, response, DeserializationOption::Filter(filter));
+      if (error) {
+        Sprint(F("deserializeJson() failed: ")); Sprintln(error.c_str());
+      }
+
+      recordFeedDocumentUsage(action_str.c_str(), doc.capacity(), doc.memoryUsage());
+
+      // Deserializing waits on the network as it reads, so only the processor counts as parsing
+      unsigned long parse_start = micros();
       bool parser_res = parser.process_json_document(doc);
+      parse_us = micros() - parse_start;
 
       if (parser_res) {
           Sprintln("Parsed JSON OK.");
@@ -1390,14 +1604,40 @@ bool get_json_and_parse_v3(JsonProcessor &parser, const String& action_str, cons
         Sprintln("Failed to parse JSON!");
       }
 
-      // Disconnect
-      http.end();      
+      if (validator) conditionalGets.store(validator, parser_res ? feedTransport->etag : "", parser_res ? feedTransport->last_modified : "");
+
+      // A document cut short can still process, so only a clean deserialize is worth recording
+      if (parser_res && !error) feedTransport->body_parsed();
+
+      // Done with the response, the socket is kept for the next request
+      feedTransport->end();      
       return parser_res;  
 
     } else {
-      Serial.printf("[HTTP] GET... failed, error: %s \r\n", http.errorToString(httpCode).c_str());
-      http.end();  
+      Serial.printf("[HTTP] GET... failed, error: %s \r\n", HTTPClient::errorToString(httpCode).c_str());
+      feedTransport->end();  
      return false;
     }
 }
 
+// As above, then record how the request went (once the document has been freed), see FeedStats.hpp
+bool get_json_and_parse_v3(JsonProcessor &parser, const String& action_str, const String& params_str)
+{
+    unsigned long parse_us = 0;
+
+    bool result = get_json_and_parse_v3_response(parser, action_str, params_str, parse_us);
+    feedTransport->record_telemetry(action_str.c_str(), parse_us);
+
+    // It didn't inflate, and compression is off now (refer to IoTConnection::end()). Once more without.
+    if (!result && feedTransport->body_failed())
+    {
+      Sprintln(F("Requesting it again, uncompressed."));
+      parse_us = 0;
+      result   = get_json_and_parse_v3_response(parser, action_str, params_str, parse_us);
+      feedTransport->record_telemetry(action_str.c_str(), parse_us);
+    }
+
+    return result;
+}
+
+
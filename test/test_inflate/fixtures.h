@@ -0,0 +1,395 @@
+#ifndef INFLATE_FIXTURES_H
+#define INFLATE_FIXTURES_H
+
+/*--------------------------- INFLATE TEST FIXTURES -----------------------------*/
+/*
+ * Made with Python's zlib.compressobj(level, DEFLATED, wbits, 9, strategy) from fixtureText() in
+ * test_inflate.cpp (100 news items, 9790 bytes), or a prefix of it:
+ *
+ *    ZLIB12_DYNAMIC    level 9, wbits 12, all of it
+ *    GZIP12_DYNAMIC    level 9, wbits 16 + 12, all of it
+ *    ZLIB12_FIXED      level 9, wbits 12, Z_FIXED, first 1500 bytes
+ *    ZLIB12_STORED     level 0, wbits 12, first 600 bytes with a Z_SYNC_FLUSH after 300, so
+ *                      several stored blocks, one of them empty
+ *    ZLIB15_HEADER     level 9, wbits 15, first 200 bytes (the header asks for a 32KB window)
+ *    GZIP15_NEAR       level 9, wbits 16 + 15, first 3000 bytes (never refers back past 4KB)
+ *    GZIP15_FAR        level 9, wbits 16 + 15, of fixtureNoise(5000) twice, so the second half
+ *                      refers back 5000 bytes
+ */
+#include <stdint.h>
+
+const uint8_t ZLIB12_DYNAMIC[] = {
+    0x48, 0xc7, 0xad, 0xd6, 0x3d, 0x6a, 0x5b, 0x41, 0x18, 0x46, 0xe1, 0xad, 0x5c, 0x54, 0xbb, 0x98,
+    0xff, 0x6f, 0xc6, 0x2b, 0x70, 0x91, 0x4d, 0x28, 0xe8, 0x9a, 0x08, 0x64, 0x09, 0xec, 0x1b, 0x5c,
+    0x98, 0xec, 0x3d, 0x49, 0x9d, 0x53, 0x85, 0xd3, 0x7e, 0xcd, 0x5b, 0x3c, 0x1c, 0x66, 0xbe, 0x4e,
+    0x97, 0xf3, 0xb1, 0x1f, 0xd7, 0xb7, 0xfd, 0xf4, 0x9c, 0x47, 0xe4, 0x5a, 0xf2, 0x48, 0xe9, 0xe9,
+    0x74, 0x5c, 0x8f, 0xdb, 0x9f, 0xd3, 0xe9, 0x65, 0x3f, 0x5f, 0x6e, 0xd7, 0xfb, 0xbe, 0xa5, 0xe7,
+    0xed, 0xe5, 0xf1, 0xb6, 0x7f, 0x6c, 0xaf, 0xb7, 0xc7, 0xe3, 0xb2, 0x5f, 0xb6, 0xf3, 0xeb, 0xb1,
+    0xbf, 0x6f, 0xf7, 0xc7, 0xfb, 0xf1, 0x63, 0xfb, 0xf6, 0xb8, 0x5f, 0x1e, 0xf7, 0xed, 0xf3, 0xfc,
+    0xf7, 0xf4, 0x76, 0xbe, 0xde, 0x3f, 0xb6, 0xef, 0x3f, 0xdf, 0x3f, 0x8e, 0xd3, 0xaf, 0xa7, 0xaf,
+    0x7f, 0x07, 0x7a, 0xa3, 0x81, 0xec, 0x0d, 0xb4, 0x49, 0x03, 0x45, 0x1c, 0x28, 0x34, 0x50, 0xbd,
+    0x81, 0x3a, 0x68, 0xa0, 0x89, 0x03, 0x88, 0xdc, 0xbd, 0x81, 0x82, 0xc8, 0xc3, 0x1b, 0xc8, 0x88,
+    0x1c, 0xe2, 0x00, 0x22, 0x4f, 0x6f, 0x20, 0x21, 0xf2, 0x12, 0x07, 0x10, 0x39, 0x7b, 0x29, 0xa7,
+    0xc5, 0x29, 0x7b, 0x2d, 0xa7, 0x89, 0xcc, 0xb9, 0x88, 0x0b, 0xe8, 0x9c, 0xbd, 0x9a, 0x53, 0x20,
+    0x74, 0x6e, 0xe2, 0x02, 0x4b, 0x7b, 0x3d, 0xa7, 0xc1, 0xd2, 0x5e, 0xd0, 0xa9, 0xb3, 0x74, 0x88,
+    0x0b, 0x2c, 0xed, 0x25, 0x9d, 0x1a, 0x4b, 0x2f, 0x71, 0x01, 0xa5, 0x8b, 0xd8, 0x74, 0x45, 0xe9,
+    0x22, 0x36, 0x5d, 0xf8, 0x7d, 0x16, 0x9b, 0x2e, 0x28, 0x5d, 0xc4, 0xa6, 0x33, 0x4a, 0x17, 0xb1,
+    0xe9, 0xcc, 0xd2, 0x62, 0xd3, 0x89, 0xa5, 0xb5, 0xa6, 0xf3, 0x5a, 0x2c, 0x1d, 0xe2, 0x02, 0x4b,
+    0x4f, 0x6f, 0x61, 0xb2, 0xf4, 0x12, 0x17, 0x50, 0xba, 0x26, 0x6f, 0x21, 0x50, 0xba, 0x66, 0x6f,
+    0x61, 0xa0, 0x74, 0x2d, 0xe2, 0x02, 0x7f, 0xba, 0xab, 0xb7, 0xd0, 0x51, 0xba, 0x36, 0x71, 0x81,
+    0xa5, 0xbb, 0xb7, 0xd0, 0x58, 0x5a, 0x6c, 0xba, 0xb2, 0xb4, 0xd8, 0x74, 0x65, 0x69, 0xb1, 0xe9,
+    0xc2, 0xd2, 0x62, 0xd3, 0x05, 0xa5, 0x9b, 0xd8, 0x74, 0x46, 0xe9, 0x26, 0x36, 0x9d, 0x50, 0xba,
+    0x89, 0x4d, 0x27, 0x94, 0x6e, 0x5e, 0xd3, 0x73, 0xa1, 0x74, 0x6b, 0xe2, 0x02, 0x4b, 0x7b, 0x4d,
+    0xcf, 0xc9, 0xd2, 0x5e, 0xd3, 0x33, 0x58, 0x3a, 0xc4, 0x05, 0x96, 0xf6, 0x9a, 0x9e, 0x83, 0xa5,
+    0x97, 0xb8, 0x80, 0xd2, 0xdd, 0x6b, 0x7a, 0x76, 0x94, 0xee, 0x5e, 0xd3, 0xb3, 0xa1, 0x74, 0x2f,
+    0xe2, 0x02, 0x4a, 0x77, 0xb1, 0xe9, 0x8a, 0xd2, 0x5d, 0x6c, 0xba, 0xb2, 0xb4, 0xd8, 0x74, 0x61,
+    0x69, 0xb1, 0xe9, 0xcc, 0xd2, 0x62, 0xd3, 0x99, 0xa5, 0xc5, 0xa6, 0x13, 0x4b, 0x8b, 0x4d, 0x27,
+    0x94, 0x1e, 0x5e, 0xd3, 0xb1, 0x50, 0x7a, 0x78, 0x4d, 0xc7, 0x44, 0xe9, 0x51, 0xc4, 0x05, 0x94,
+    0x1e, 0x5e, 0xd3, 0x11, 0x28, 0x3d, 0x9a, 0xb8, 0xc0, 0xd2, 0x5e, 0xd3, 0x31, 0x58, 0xda, 0x6b,
+    0x3a, 0x3a, 0x4b, 0x87, 0xb8, 0xc0, 0xd2, 0x5e, 0xd3, 0xd1, 0x58, 0x7a, 0x89, 0x0b, 0x28, 0x1d,
+    0x62, 0xd3, 0x15, 0xa5, 0x43, 0x6c, 0xba, 0xa0, 0x74, 0x88, 0x4d, 0x17, 0x94, 0x0e, 0xb1, 0xe9,
+    0x8c, 0xd2, 0x21, 0x36, 0x9d, 0x59, 0x5a, 0x6c, 0x3a, 0xb1, 0xb4, 0xd7, 0xf4, 0x58, 0x2c, 0x1d,
+    0xe2, 0x02, 0x4b, 0x7b, 0x4d, 0x8f, 0xc9, 0xd2, 0x4b, 0x5c, 0x40, 0xe9, 0xe9, 0x35, 0x3d, 0x02,
+    0xa5, 0xa7, 0xd7, 0xf4, 0x18, 0x28, 0x3d, 0x8b, 0xb8, 0x80, 0xd2, 0xd3, 0x6b, 0x7a, 0x74, 0x94,
+    0x9e, 0x4d, 0x5c, 0x60, 0x69, 0xaf, 0xe9, 0xd1, 0x58, 0x5a, 0x6c, 0xba, 0xb2, 0xb4, 0xd8, 0x74,
+    0x65, 0x69, 0xb1, 0xe9, 0xc2, 0xd2, 0x62, 0xd3, 0x05, 0xa5, 0x97, 0xd8, 0x74, 0x46, 0xe9, 0x25,
+    0x36, 0x9d, 0x50, 0x7a, 0x89, 0x4d, 0x27, 0x94, 0x5e, 0x5e, 0xd3, 0x7d, 0xa1, 0xf4, 0x6a, 0xe2,
+    0x02, 0x4b, 0x7b, 0x4d, 0xf7, 0xc9, 0xd2, 0x5e, 0xd3, 0x3d, 0x58, 0x3a, 0xc4, 0x05, 0x96, 0xf6,
+    0x9a, 0xee, 0x83, 0xa5, 0xff, 0xb7, 0xe9, 0xdf, 0x8d, 0xeb, 0xcd, 0x0a,
+};
+
+const uint8_t GZIP12_DYNAMIC[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0xd6, 0x3d, 0x6a, 0x5b, 0x41,
+    0x18, 0x46, 0xe1, 0xad, 0x5c, 0x54, 0xbb, 0x98, 0xff, 0x6f, 0xc6, 0x2b, 0x70, 0x91, 0x4d, 0x28,
+    0xe8, 0x9a, 0x08, 0x64, 0x09, 0xec, 0x1b, 0x5c, 0x98, 0xec, 0x3d, 0x49, 0x9d, 0x53, 0x85, 0xd3,
+    0x7e, 0xcd, 0x5b, 0x3c, 0x1c, 0x66, 0xbe, 0x4e, 0x97, 0xf3, 0xb1, 0x1f, 0xd7, 0xb7, 0xfd, 0xf4,
+    0x9c, 0x47, 0xe4, 0x5a, 0xf2, 0x48, 0xe9, 0xe9, 0x74, 0x5c, 0x8f, 0xdb, 0x9f, 0xd3, 0xe9, 0x65,
+    0x3f, 0x5f, 0x6e, 0xd7, 0xfb, 0xbe, 0xa5, 0xe7, 0xed, 0xe5, 0xf1, 0xb6, 0x7f, 0x6c, 0xaf, 0xb7,
+    0xc7, 0xe3, 0xb2, 0x5f, 0xb6, 0xf3, 0xeb, 0xb1, 0xbf, 0x6f, 0xf7, 0xc7, 0xfb, 0xf1, 0x63, 0xfb,
+    0xf6, 0xb8, 0x5f, 0x1e, 0xf7, 0xed, 0xf3, 0xfc, 0xf7, 0xf4, 0x76, 0xbe, 0xde, 0x3f, 0xb6, 0xef,
+    0x3f, 0xdf, 0x3f, 0x8e, 0xd3, 0xaf, 0xa7, 0xaf, 0x7f, 0x07, 0x7a, 0xa3, 0x81, 0xec, 0x0d, 0xb4,
+    0x49, 0x03, 0x45, 0x1c, 0x28, 0x34, 0x50, 0xbd, 0x81, 0x3a, 0x68, 0xa0, 0x89, 0x03, 0x88, 0xdc,
+    0xbd, 0x81, 0x82, 0xc8, 0xc3, 0x1b, 0xc8, 0x88, 0x1c, 0xe2, 0x00, 0x22, 0x4f, 0x6f, 0x20, 0x21,
+    0xf2, 0x12, 0x07, 0x10, 0x39, 0x7b, 0x29, 0xa7, 0xc5, 0x29, 0x7b, 0x2d, 0xa7, 0x89, 0xcc, 0xb9,
+    0x88, 0x0b, 0xe8, 0x9c, 0xbd, 0x9a, 0x53, 0x20, 0x74, 0x6e, 0xe2, 0x02, 0x4b, 0x7b, 0x3d, 0xa7,
+    0xc1, 0xd2, 0x5e, 0xd0, 0xa9, 0xb3, 0x74, 0x88, 0x0b, 0x2c, 0xed, 0x25, 0x9d, 0x1a, 0x4b, 0x2f,
+    0x71, 0x01, 0xa5, 0x8b, 0xd8, 0x74, 0x45, 0xe9, 0x22, 0x36, 0x5d, 0xf8, 0x7d, 0x16, 0x9b, 0x2e,
+    0x28, 0x5d, 0xc4, 0xa6, 0x33, 0x4a, 0x17, 0xb1, 0xe9, 0xcc, 0xd2, 0x62, 0xd3, 0x89, 0xa5, 0xb5,
+    0xa6, 0xf3, 0x5a, 0x2c, 0x1d, 0xe2, 0x02, 0x4b, 0x4f, 0x6f, 0x61, 0xb2, 0xf4, 0x12, 0x17, 0x50,
+    0xba, 0x26, 0x6f, 0x21, 0x50, 0xba, 0x66, 0x6f, 0x61, 0xa0, 0x74, 0x2d, 0xe2, 0x02, 0x7f, 0xba,
+    0xab, 0xb7, 0xd0, 0x51, 0xba, 0x36, 0x71, 0x81, 0xa5, 0xbb, 0xb7, 0xd0, 0x58, 0x5a, 0x6c, 0xba,
+    0xb2, 0xb4, 0xd8, 0x74, 0x65, 0x69, 0xb1, 0xe9, 0xc2, 0xd2, 0x62, 0xd3, 0x05, 0xa5, 0x9b, 0xd8,
+    0x74, 0x46, 0xe9, 0x26, 0x36, 0x9d, 0x50, 0xba, 0x89, 0x4d, 0x27, 0x94, 0x6e, 0x5e, 0xd3, 0x73,
+    0xa1, 0x74, 0x6b, 0xe2, 0x02, 0x4b, 0x7b, 0x4d, 0xcf, 0xc9, 0xd2, 0x5e, 0xd3, 0x33, 0x58, 0x3a,
+    0xc4, 0x05, 0x96, 0xf6, 0x9a, 0x9e, 0x83, 0xa5, 0x97, 0xb8, 0x80, 0xd2, 0xdd, 0x6b, 0x7a, 0x76,
+    0x94, 0xee, 0x5e, 0xd3, 0xb3, 0xa1, 0x74, 0x2f, 0xe2, 0x02, 0x4a, 0x77, 0xb1, 0xe9, 0x8a, 0xd2,
+    0x5d, 0x6c, 0xba, 0xb2, 0xb4, 0xd8, 0x74, 0x61, 0x69, 0xb1, 0xe9, 0xcc, 0xd2, 0x62, 0xd3, 0x99,
+    0xa5, 0xc5, 0xa6, 0x13, 0x4b, 0x8b, 0x4d, 0x27, 0x94, 0x1e, 0x5e, 0xd3, 0xb1, 0x50, 0x7a, 0x78,
+    0x4d, 0xc7, 0x44, 0xe9, 0x51, 0xc4, 0x05, 0x94, 0x1e, 0x5e, 0xd3, 0x11, 0x28, 0x3d, 0x9a, 0xb8,
+    0xc0, 0xd2, 0x5e, 0xd3, 0x31, 0x58, 0xda, 0x6b, 0x3a, 0x3a, 0x4b, 0x87, 0xb8, 0xc0, 0xd2, 0x5e,
+    0xd3, 0xd1, 0x58, 0x7a, 0x89, 0x0b, 0x28, 0x1d, 0x62, 0xd3, 0x15, 0xa5, 0x43, 0x6c, 0xba, 0xa0,
+    0x74, 0x88, 0x4d, 0x17, 0x94, 0x0e, 0xb1, 0xe9, 0x8c, 0xd2, 0x21, 0x36, 0x9d, 0x59, 0x5a, 0x6c,
+    0x3a, 0xb1, 0xb4, 0xd7, 0xf4, 0x58, 0x2c, 0x1d, 0xe2, 0x02, 0x4b, 0x7b, 0x4d, 0x8f, 0xc9, 0xd2,
+    0x4b, 0x5c, 0x40, 0xe9, 0xe9, 0x35, 0x3d, 0x02, 0xa5, 0xa7, 0xd7, 0xf4, 0x18, 0x28, 0x3d, 0x8b,
+    0xb8, 0x80, 0xd2, 0xd3, 0x6b, 0x7a, 0x74, 0x94, 0x9e, 0x4d, 0x5c, 0x60, 0x69, 0xaf, 0xe9, 0xd1,
+    0x58, 0x5a, 0x6c, 0xba, 0xb2, 0xb4, 0xd8, 0x74, 0x65, 0x69, 0xb1, 0xe9, 0xc2, 0xd2, 0x62, 0xd3,
+    0x05, 0xa5, 0x97, 0xd8, 0x74, 0x46, 0xe9, 0x25, 0x36, 0x9d, 0x50, 0x7a, 0x89, 0x4d, 0x27, 0x94,
+    0x5e, 0x5e, 0xd3, 0x7d, 0xa1, 0xf4, 0x6a, 0xe2, 0x02, 0x4b, 0x7b, 0x4d, 0xf7, 0xc9, 0xd2, 0x5e,
+    0xd3, 0x3d, 0x58, 0x3a, 0xc4, 0x05, 0x96, 0xf6, 0x9a, 0xee, 0x83, 0xa5, 0xff, 0xb7, 0xe9, 0xdf,
+    0x40, 0x79, 0x70, 0x1c, 0x3e, 0x26, 0x00, 0x00,
+};
+
+const uint8_t ZLIB12_FIXED[] = {
+    0x48, 0x0d, 0xab, 0x56, 0x4a, 0x49, 0x2c, 0x49, 0x2d, 0xc9, 0xcc, 0x4d, 0x55, 0xb2, 0x32, 0x34,
+    0x33, 0x37, 0x34, 0x36, 0x32, 0x34, 0x33, 0x30, 0xd0, 0x51, 0x2a, 0xc9, 0x2c, 0xc9, 0x01, 0x0a,
+    0x29, 0x79, 0xa4, 0x26, 0xa6, 0xe4, 0x64, 0xe6, 0xa5, 0x2a, 0x18, 0x58, 0x29, 0x78, 0xe4, 0xe7,
+    0xa6, 0x16, 0x2b, 0xa4, 0xe5, 0xe4, 0xe7, 0xa7, 0xa4, 0xa6, 0x28, 0x24, 0xa6, 0x95, 0xa4, 0x16,
+    0x29, 0xe4, 0xe5, 0x17, 0x95, 0x64, 0x28, 0xf8, 0xe4, 0xe7, 0xa5, 0xe4, 0xe7, 0x29, 0x94, 0x27,
+    0x82, 0x84, 0x72, 0x13, 0x33, 0xf3, 0x8a, 0x15, 0x92, 0x4a, 0x8b, 0x8a, 0x4b, 0x94, 0x6a, 0x75,
+    0xaa, 0x31, 0x2d, 0x30, 0x35, 0xc1, 0x66, 0x81, 0x21, 0xf5, 0x2c, 0x30, 0xb1, 0xc0, 0x66, 0x81,
+    0x11, 0x15, 0x2d, 0x30, 0xc2, 0x66, 0x81, 0x31, 0xf5, 0x2c, 0x30, 0x36, 0xc3, 0x66, 0x81, 0x09,
+    0x15, 0x2d, 0xc0, 0x1a, 0xc9, 0xa6, 0xd4, 0xb3, 0xc0, 0x08, 0x6b, 0x24, 0x9b, 0x51, 0xcf, 0x02,
+    0x43, 0xac, 0x91, 0x6c, 0x4e, 0x45, 0x0b, 0xb0, 0x46, 0xb2, 0x05, 0xf5, 0x2c, 0x30, 0xc0, 0x1a,
+    0xc9, 0x96, 0x54, 0xb4, 0x00, 0x6b, 0x24, 0x1b, 0x52, 0x2f, 0x2b, 0x1b, 0x58, 0x62, 0xcf, 0xca,
+    0xd4, 0xcb, 0xcb, 0x06, 0x16, 0x58, 0xa3, 0xd9, 0xd0, 0x88, 0x8a, 0x36, 0x60, 0x8d, 0x67, 0x43,
+    0xea, 0xe5, 0x66, 0x03, 0x73, 0xac, 0x11, 0x6d, 0x68, 0x42, 0x45, 0x1b, 0xb0, 0xc5, 0x34, 0x00,
+    0xc5, 0x59, 0xf5, 0xa7,
+};
+
+const uint8_t ZLIB12_STORED[] = {
+    0x48, 0x0d, 0x00, 0x2c, 0x01, 0xd3, 0xfe, 0x7b, 0x22, 0x64, 0x61, 0x74, 0x65, 0x74, 0x69, 0x6d,
+    0x65, 0x22, 0x3a, 0x31, 0x36, 0x37, 0x31, 0x33, 0x32, 0x31, 0x36, 0x30, 0x30, 0x2c, 0x22, 0x74,
+    0x69, 0x74, 0x6c, 0x65, 0x22, 0x3a, 0x22, 0x48, 0x65, 0x61, 0x64, 0x6c, 0x69, 0x6e, 0x65, 0x20,
+    0x30, 0x3a, 0x20, 0x48, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 0x6c, 0x6f, 0x6f, 0x64, 0x65, 0x64,
+    0x20, 0x61, 0x66, 0x74, 0x65, 0x72, 0x20, 0x6e, 0x6f, 0x72, 0x74, 0x68, 0x20, 0x4c, 0x6f, 0x6e,
+    0x64, 0x6f, 0x6e, 0x20, 0x77, 0x61, 0x74, 0x65, 0x72, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x73, 0x20,
+    0x62, 0x75, 0x72, 0x73, 0x74, 0x22, 0x7d, 0x2c, 0x7b, 0x22, 0x64, 0x61, 0x74, 0x65, 0x74, 0x69,
+    0x6d, 0x65, 0x22, 0x3a, 0x31, 0x36, 0x37, 0x31, 0x33, 0x32, 0x31, 0x35, 0x34, 0x30, 0x2c, 0x22,
+    0x74, 0x69, 0x74, 0x6c, 0x65, 0x22, 0x3a, 0x22, 0x48, 0x65, 0x61, 0x64, 0x6c, 0x69, 0x6e, 0x65,
+    0x20, 0x31, 0x3a, 0x20, 0x48, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 0x6c, 0x6f, 0x6f, 0x64, 0x65,
+    0x64, 0x20, 0x61, 0x66, 0x74, 0x65, 0x72, 0x20, 0x6e, 0x6f, 0x72, 0x74, 0x68, 0x20, 0x4c, 0x6f,
+    0x6e, 0x64, 0x6f, 0x6e, 0x20, 0x77, 0x61, 0x74, 0x65, 0x72, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x73,
+    0x20, 0x62, 0x75, 0x72, 0x73, 0x74, 0x22, 0x7d, 0x2c, 0x7b, 0x22, 0x64, 0x61, 0x74, 0x65, 0x74,
+    0x69, 0x6d, 0x65, 0x22, 0x3a, 0x31, 0x36, 0x37, 0x31, 0x33, 0x32, 0x31, 0x34, 0x38, 0x30, 0x2c,
+    0x22, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x22, 0x3a, 0x22, 0x48, 0x65, 0x61, 0x64, 0x6c, 0x69, 0x6e,
+    0x65, 0x20, 0x32, 0x3a, 0x20, 0x48, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 0x6c, 0x6f, 0x6f, 0x64,
+    0x65, 0x64, 0x20, 0x61, 0x66, 0x74, 0x65, 0x72, 0x20, 0x6e, 0x6f, 0x72, 0x74, 0x68, 0x20, 0x4c,
+    0x6f, 0x6e, 0x64, 0x6f, 0x6e, 0x20, 0x77, 0x61, 0x74, 0x65, 0x72, 0x20, 0x6d, 0x61, 0x69, 0x6e,
+    0x73, 0x20, 0x62, 0x75, 0x72, 0x73, 0x74, 0x22, 0x7d, 0x2c, 0x7b, 0x22, 0x64, 0x61, 0x74, 0x65,
+    0x74, 0x69, 0x6d, 0x00, 0x00, 0x00, 0xff, 0xff, 0x01, 0x2c, 0x01, 0xd3, 0xfe, 0x65, 0x22, 0x3a,
+    0x31, 0x36, 0x37, 0x31, 0x33, 0x32, 0x31, 0x34, 0x32, 0x30, 0x2c, 0x22, 0x74, 0x69, 0x74, 0x6c,
+    0x65, 0x22, 0x3a, 0x22, 0x48, 0x65, 0x61, 0x64, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x33, 0x3a, 0x20,
+    0x48, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 0x6c, 0x6f, 0x6f, 0x64, 0x65, 0x64, 0x20, 0x61, 0x66,
+    0x74, 0x65, 0x72, 0x20, 0x6e, 0x6f, 0x72, 0x74, 0x68, 0x20, 0x4c, 0x6f, 0x6e, 0x64, 0x6f, 0x6e,
+    0x20, 0x77, 0x61, 0x74, 0x65, 0x72, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x73, 0x20, 0x62, 0x75, 0x72,
+    0x73, 0x74, 0x22, 0x7d, 0x2c, 0x7b, 0x22, 0x64, 0x61, 0x74, 0x65, 0x74, 0x69, 0x6d, 0x65, 0x22,
+    0x3a, 0x31, 0x36, 0x37, 0x31, 0x33, 0x32, 0x31, 0x33, 0x36, 0x30, 0x2c, 0x22, 0x74, 0x69, 0x74,
+    0x6c, 0x65, 0x22, 0x3a, 0x22, 0x48, 0x65, 0x61, 0x64, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x34, 0x3a,
+    0x20, 0x48, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 0x6c, 0x6f, 0x6f, 0x64, 0x65, 0x64, 0x20, 0x61,
+    0x66, 0x74, 0x65, 0x72, 0x20, 0x6e, 0x6f, 0x72, 0x74, 0x68, 0x20, 0x4c, 0x6f, 0x6e, 0x64, 0x6f,
+    0x6e, 0x20, 0x77, 0x61, 0x74, 0x65, 0x72, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x73, 0x20, 0x62, 0x75,
+    0x72, 0x73, 0x74, 0x22, 0x7d, 0x2c, 0x7b, 0x22, 0x64, 0x61, 0x74, 0x65, 0x74, 0x69, 0x6d, 0x65,
+    0x22, 0x3a, 0x31, 0x36, 0x37, 0x31, 0x33, 0x32, 0x31, 0x33, 0x30, 0x30, 0x2c, 0x22, 0x74, 0x69,
+    0x74, 0x6c, 0x65, 0x22, 0x3a, 0x22, 0x48, 0x65, 0x61, 0x64, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x35,
+    0x3a, 0x20, 0x48, 0x6f, 0x6d, 0x65, 0x73, 0x20, 0x66, 0x6c, 0x6f, 0x6f, 0x64, 0x65, 0x64, 0x20,
+    0x61, 0x66, 0x74, 0x65, 0x72, 0x20, 0x6e, 0x6f, 0x72, 0x74, 0x68, 0x20, 0x4c, 0x6f, 0x6e, 0x64,
+    0x6f, 0x6e, 0x20, 0x77, 0x61, 0x74, 0x65, 0x72, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x73, 0x20, 0x62,
+    0x75, 0x72, 0x73, 0x74, 0x22, 0x7d, 0x2c, 0x7b, 0x22, 0x64, 0x61, 0x74, 0x65, 0x74, 0x69, 0x6d,
+    0x65, 0x22, 0x3a, 0x31, 0x36, 0x37, 0x31, 0x33, 0x32, 0x9f, 0xc7, 0xc8, 0xc9,
+};
+
+const uint8_t ZLIB15_HEADER[] = {
+    0x78, 0xda, 0xa5, 0xcd, 0x31, 0x0e, 0x83, 0x30, 0x0c, 0x00, 0xc0, 0xaf, 0x58, 0x9e, 0x19, 0x12,
+    0xda, 0x52, 0x89, 0x17, 0x30, 0xf4, 0x13, 0x46, 0x36, 0x6a, 0xa4, 0xc4, 0x96, 0x12, 0x57, 0x1d,
+    0x10, 0x7f, 0xa7, 0xcc, 0x74, 0x63, 0xbd, 0xe5, 0x56, 0x64, 0x72, 0xf1, 0x54, 0x04, 0xc7, 0x38,
+    0x3c, 0xe3, 0xad, 0x8f, 0x43, 0x08, 0x1d, 0x7a, 0xf2, 0xfc, 0x23, 0x9c, 0x84, 0x38, 0x27, 0x15,
+    0x08, 0x23, 0x4c, 0x56, 0xa4, 0xc1, 0x92, 0xcd, 0x58, 0x18, 0x68, 0x71, 0xa9, 0xa0, 0x56, 0xfd,
+    0x0d, 0x2f, 0x53, 0x36, 0x85, 0x2f, 0x1d, 0x54, 0x28, 0x69, 0x83, 0xf9, 0x53, 0x9b, 0xe3, 0xd6,
+    0xad, 0xe7, 0xe0, 0x71, 0xff, 0x17, 0xc4, 0x4b, 0xc1, 0x0e, 0xc1, 0x8a, 0x43, 0x52,
+};
+
+const uint8_t GZIP15_NEAR[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0xd5, 0x31, 0x6e, 0xc3, 0x30,
+    0x10, 0x44, 0xd1, 0xab, 0x10, 0xaa, 0x5d, 0xec, 0x2e, 0x25, 0x4a, 0xf4, 0x09, 0x5c, 0xe4, 0x12,
+    0x34, 0x48, 0x23, 0x02, 0x24, 0x12, 0x90, 0x18, 0xb8, 0x30, 0x72, 0xf7, 0xc4, 0x75, 0x06, 0xa9,
+    0xa6, 0xdd, 0xe6, 0x17, 0x0f, 0x83, 0x7d, 0x0d, 0x39, 0xf5, 0xd2, 0xd7, 0xbd, 0x0c, 0x57, 0x0d,
+    0xb3, 0x7a, 0xd3, 0x20, 0x72, 0x19, 0xfa, 0xda, 0xb7, 0xdf, 0xd3, 0x70, 0x2b, 0x29, 0x6f, 0x6b,
+    0x2d, 0x4e, 0xae, 0xee, 0xd6, 0xf6, 0x72, 0xba, 0xc7, 0xd6, 0x5a, 0x2e, 0xd9, 0xa5, 0x47, 0x2f,
+    0x87, 0xab, 0xed, 0xe8, 0x9f, 0xee, 0xa3, 0xd5, 0xdc, 0xaa, 0x7b, 0xa6, 0xf7, 0x69, 0x4f, 0x6b,
+    0x3d, 0xdd, 0xfd, 0xeb, 0x38, 0xfb, 0xf0, 0x7d, 0x79, 0xfd, 0x0d, 0x4c, 0x23, 0x0a, 0x28, 0x2f,
+    0x30, 0x2e, 0x28, 0x60, 0xc4, 0x80, 0xa1, 0x80, 0xe7, 0x05, 0x7c, 0x40, 0x81, 0x91, 0x18, 0x80,
+    0xc8, 0x13, 0x2f, 0x60, 0x10, 0x39, 0xf0, 0x02, 0x0a, 0x91, 0x67, 0x62, 0x00, 0x22, 0x2f, 0xbc,
+    0x80, 0x40, 0xe4, 0x48, 0x0c, 0x40, 0x64, 0xe5, 0x4d, 0x59, 0x22, 0x9e, 0x32, 0x6f, 0xcb, 0xb2,
+    0x40, 0x66, 0x35, 0x62, 0x01, 0x3a, 0x2b, 0x6f, 0xcd, 0x32, 0x43, 0x68, 0x1d, 0x89, 0x05, 0x2c,
+    0xcd, 0xdb, 0xb3, 0x04, 0x2c, 0xcd, 0x1b, 0xb4, 0x4c, 0x58, 0x7a, 0x26, 0x16, 0xb0, 0x34, 0x6f,
+    0xd2, 0x32, 0x62, 0xe9, 0x48, 0x2c, 0x40, 0x69, 0x23, 0x6e, 0xda, 0x43, 0x69, 0x23, 0x6e, 0xda,
+    0xf0, 0x7f, 0x26, 0x6e, 0xda, 0xa0, 0xb4, 0x11, 0x37, 0xad, 0x50, 0xda, 0x88, 0x9b, 0x56, 0x2c,
+    0x4d, 0xdc, 0xb4, 0x60, 0x69, 0xda, 0xa6, 0x35, 0x46, 0x2c, 0x3d, 0x13, 0x0b, 0x58, 0x7a, 0xe1,
+    0x15, 0x16, 0x2c, 0x1d, 0x89, 0x05, 0x28, 0xed, 0xff, 0xdb, 0xf4, 0x0f, 0xff, 0xba, 0x5f, 0x45,
+    0xb8, 0x0b, 0x00, 0x00,
+};
+
+const uint8_t GZIP15_FAR[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x98, 0xc7, 0x95, 0xc4, 0x30,
+    0x0c, 0x43, 0x6b, 0x55, 0xa4, 0x72, 0xce, 0xd5, 0x2f, 0x5c, 0xc4, 0xde, 0xe6, 0x3a, 0x6f, 0x6c,
+    0x4b, 0x14, 0x01, 0x7c, 0xaa, 0xab, 0x96, 0xb9, 0x34, 0x14, 0x4b, 0x6c, 0x96, 0xeb, 0xfb, 0x84,
+    0xb1, 0x5c, 0x8e, 0xd8, 0xfc, 0x8c, 0x63, 0x9a, 0x7b, 0x9b, 0xb5, 0x47, 0x0a, 0x6e, 0xdd, 0xa8,
+    0x4e, 0x3d, 0xc6, 0x8d, 0x7a, 0xc1, 0x15, 0x21, 0xf2, 0x3e, 0x97, 0x6b, 0x2d, 0x95, 0xba, 0x61,
+    0x52, 0x89, 0xc2, 0x96, 0x42, 0x72, 0xe7, 0xd2, 0xba, 0x5b, 0xe4, 0xa5, 0x9f, 0xde, 0x54, 0x36,
+    0xc4, 0xe4, 0x57, 0xb5, 0x1b, 0xfb, 0x39, 0xdd, 0x4e, 0xa5, 0x8d, 0x6c, 0x41, 0xab, 0x3e, 0xab,
+    0xb8, 0x46, 0x79, 0xdf, 0x9f, 0x28, 0x2c, 0xee, 0x63, 0xdd, 0x1c, 0x0a, 0xef, 0xe8, 0xbe, 0x34,
+    0x32, 0xb1, 0x8a, 0x7d, 0x16, 0x2f, 0x56, 0xc8, 0x9a, 0x87, 0xd5, 0x22, 0xf1, 0xd1, 0x79, 0x70,
+    0xe2, 0x94, 0x79, 0xb9, 0xed, 0x7b, 0x95, 0x5b, 0x0b, 0x7b, 0xef, 0xa9, 0xac, 0xad, 0xe8, 0xea,
+    0x08, 0xcb, 0x5f, 0xc9, 0x9d, 0x5c, 0x38, 0xde, 0x31, 0x8f, 0xbf, 0xbe, 0xae, 0xb6, 0xcf, 0x71,
+    0x97, 0xc1, 0xa4, 0xac, 0xcd, 0x8d, 0x69, 0x0d, 0x9f, 0xf9, 0x85, 0x23, 0xde, 0x71, 0x65, 0x26,
+    0xef, 0xba, 0x3e, 0xc4, 0x9c, 0x3d, 0x91, 0x98, 0xdc, 0x7c, 0x50, 0x94, 0xc3, 0x04, 0xde, 0xdd,
+    0xd6, 0x56, 0xef, 0x9e, 0x93, 0xb7, 0x75, 0x8b, 0x65, 0x5c, 0xbe, 0x6c, 0x28, 0xd5, 0x4b, 0xaf,
+    0x2c, 0x9a, 0x29, 0x42, 0xd3, 0x8c, 0xe6, 0x38, 0xad, 0x51, 0xe9, 0x79, 0x3a, 0xdf, 0x54, 0x30,
+    0x47, 0xb0, 0x12, 0x3b, 0xe5, 0xba, 0x6c, 0xae, 0x93, 0xec, 0x50, 0x5a, 0x58, 0x63, 0xad, 0xd2,
+    0x8f, 0xaa, 0x90, 0x9a, 0x6b, 0xfb, 0x58, 0xd2, 0x5d, 0x11, 0xcd, 0x58, 0xb4, 0xd9, 0xd5, 0x92,
+    0x8c, 0x43, 0x70, 0xc3, 0x42, 0x97, 0x4c, 0x9e, 0xb9, 0x8d, 0x52, 0x96, 0xb8, 0x5f, 0xda, 0xa5,
+    0x73, 0x35, 0xeb, 0xb5, 0x8a, 0xe4, 0x89, 0x3b, 0x7e, 0x93, 0x1b, 0xae, 0x36, 0x99, 0xce, 0x7e,
+    0xcc, 0xcf, 0xc3, 0x8c, 0x4d, 0x39, 0xcc, 0x3e, 0x2e, 0x57, 0x2b, 0x78, 0xb2, 0xb7, 0xe4, 0xc1,
+    0xd5, 0x09, 0x65, 0x34, 0x5e, 0xde, 0xd0, 0x94, 0x9e, 0x10, 0xa4, 0x44, 0xdb, 0x6e, 0x52, 0x32,
+    0x45, 0x2e, 0xb2, 0xec, 0x48, 0xd2, 0x58, 0xf2, 0x8e, 0xc3, 0x0a, 0xfe, 0xc2, 0xbe, 0x8c, 0x82,
+    0x5a, 0x27, 0x2e, 0xea, 0xf2, 0xca, 0xa7, 0x7d, 0xb8, 0x95, 0x07, 0x5b, 0x2b, 0x8f, 0x35, 0x94,
+    0xc0, 0x4e, 0x74, 0x83, 0xbc, 0xce, 0x9a, 0x99, 0x4e, 0xab, 0x28, 0x56, 0x94, 0xf1, 0xaa, 0xaa,
+    0x7e, 0x9f, 0x19, 0x15, 0x67, 0xbe, 0xc3, 0xc8, 0xdb, 0x11, 0x97, 0x57, 0x0c, 0x25, 0x87, 0x18,
+    0x25, 0x98, 0x20, 0x69, 0xd5, 0x47, 0xa6, 0xa4, 0xa3, 0x35, 0x55, 0x7e, 0x78, 0xd8, 0xdd, 0xb3,
+    0x68, 0x3d, 0xb6, 0xd8, 0xb5, 0x93, 0xb7, 0x08, 0x16, 0x6c, 0x7a, 0xbc, 0xd6, 0x10, 0xb0, 0xc1,
+    0x42, 0xa8, 0x83, 0xa8, 0xc1, 0x74, 0x37, 0x6d, 0xc5, 0x1a, 0xf8, 0x2a, 0x13, 0xb5, 0x14, 0x13,
+    0xf5, 0xef, 0xcb, 0x3e, 0x63, 0x83, 0x96, 0x4b, 0xa3, 0x4e, 0x76, 0xab, 0xd8, 0x94, 0xcb, 0x58,
+    0xed, 0x70, 0xaf, 0x1a, 0x15, 0x82, 0xd9, 0x34, 0x9c, 0x95, 0xaa, 0xd6, 0x85, 0x67, 0x7b, 0x9d,
+    0xd9, 0x84, 0x1e, 0x9e, 0x33, 0xb6, 0x8f, 0xc1, 0x4c, 0xa2, 0x7a, 0x59, 0x09, 0xe4, 0xa3, 0x09,
+    0x77, 0xbc, 0x4a, 0x6f, 0x66, 0x74, 0xca, 0x92, 0xb2, 0x1b, 0xd5, 0x8d, 0xee, 0x21, 0x86, 0xa2,
+    0x85, 0x21, 0xa9, 0x46, 0xe2, 0x82, 0x4d, 0x5e, 0xca, 0xc3, 0x77, 0xd6, 0xc0, 0x5b, 0x4e, 0xd2,
+    0x45, 0xfa, 0x4a, 0x8a, 0xd9, 0x37, 0xdd, 0x09, 0x36, 0x36, 0xc3, 0x77, 0xbf, 0x45, 0xf1, 0xde,
+    0x8c, 0x09, 0x49, 0xa1, 0x21, 0xa6, 0xb2, 0x7a, 0xe1, 0x78, 0x84, 0xdf, 0x4a, 0x67, 0x52, 0x1d,
+    0x7d, 0x3f, 0x78, 0x36, 0x9d, 0x0b, 0x65, 0xd8, 0x3c, 0x54, 0xee, 0x1c, 0x7e, 0x95, 0xe7, 0xd8,
+    0xdb, 0xa3, 0xb1, 0xbb, 0xcc, 0x4b, 0x5d, 0x1e, 0x5f, 0x76, 0xb6, 0x8c, 0x05, 0xaf, 0xa5, 0xab,
+    0x72, 0x2d, 0xb5, 0x98, 0x0c, 0x74, 0xe3, 0xab, 0xcc, 0x90, 0x80, 0x12, 0x57, 0x36, 0xb9, 0x68,
+    0xef, 0xb5, 0x28, 0xb6, 0xc5, 0xa3, 0xc7, 0xac, 0x7e, 0xb0, 0x36, 0x72, 0x29, 0xd7, 0x25, 0x57,
+    0x78, 0xab, 0x87, 0x55, 0xe7, 0xd2, 0x1d, 0xb1, 0xd7, 0xce, 0xbd, 0xbe, 0xcd, 0x3c, 0x87, 0x03,
+    0x3b, 0x67, 0x9b, 0x7e, 0xb2, 0x0b, 0x7b, 0xcd, 0x87, 0x5e, 0x85, 0x2e, 0xb6, 0x26, 0xe3, 0x36,
+    0xad, 0xeb, 0x5b, 0x48, 0xe9, 0x5b, 0x96, 0xde, 0xd4, 0xdd, 0xed, 0xac, 0x25, 0x65, 0x53, 0xe1,
+    0xf1, 0xad, 0xfe, 0x0c, 0x63, 0x3c, 0xaf, 0xbd, 0x0f, 0x4f, 0xea, 0x9a, 0xd4, 0x9d, 0x35, 0x19,
+    0xdd, 0x39, 0x8a, 0x97, 0x85, 0xf8, 0x32, 0xf6, 0xf8, 0xd7, 0x62, 0x09, 0x15, 0xff, 0x09, 0x3d,
+    0x5a, 0x31, 0x4e, 0xc4, 0x29, 0x28, 0xf3, 0x24, 0x8b, 0x3c, 0xc9, 0x51, 0xf5, 0x89, 0xa9, 0x6b,
+    0xee, 0xf3, 0x51, 0x4f, 0x54, 0xac, 0x35, 0x64, 0xb5, 0x6b, 0xba, 0x4e, 0x5c, 0x1c, 0x26, 0x6b,
+    0x1e, 0x1a, 0x11, 0x22, 0x96, 0xf3, 0x9e, 0x93, 0xd5, 0x4b, 0xd1, 0x77, 0xea, 0xfb, 0x5d, 0x25,
+    0xfb, 0x8e, 0xb9, 0xef, 0x9d, 0x7d, 0xf2, 0xbb, 0xd4, 0xe7, 0xf4, 0xa7, 0x88, 0xb8, 0x92, 0x8f,
+    0x67, 0xa2, 0x55, 0xf5, 0xe9, 0x15, 0x8e, 0xb0, 0xa4, 0x93, 0xe7, 0xd8, 0x76, 0xb6, 0x8b, 0x5c,
+    0x17, 0x56, 0x72, 0xca, 0x82, 0xa2, 0x8d, 0x83, 0x27, 0x12, 0x3c, 0x74, 0x1f, 0x84, 0x55, 0xe5,
+    0xc8, 0x7e, 0x2e, 0xda, 0xcc, 0x94, 0x70, 0xd6, 0x28, 0x9f, 0x47, 0xd4, 0xed, 0x34, 0xd4, 0xa6,
+    0xc4, 0xb5, 0x5a, 0x2d, 0xef, 0x29, 0xdf, 0x4c, 0xbc, 0xa2, 0x13, 0x1c, 0x16, 0xc8, 0xae, 0x91,
+    0x5d, 0x45, 0x08, 0x46, 0xf4, 0x3e, 0x09, 0x2e, 0x38, 0xd5, 0xc3, 0x2e, 0x68, 0xae, 0x22, 0x73,
+    0x70, 0xfd, 0xc4, 0xd6, 0xe5, 0x43, 0x95, 0x43, 0xd6, 0x0a, 0xea, 0x4c, 0xa9, 0x08, 0x23, 0x13,
+    0xbc, 0xc0, 0xe6, 0xd8, 0xd8, 0xaa, 0x9c, 0xe5, 0xb1, 0x56, 0xf4, 0x29, 0x5b, 0xd7, 0xdc, 0x8b,
+    0xad, 0x2c, 0xc3, 0x97, 0x32, 0x89, 0x15, 0xb6, 0x2c, 0x7b, 0x9d, 0x9e, 0x0b, 0x0a, 0x5b, 0x49,
+    0xcb, 0xb3, 0x66, 0x9d, 0x62, 0x3a, 0xbb, 0x59, 0xef, 0x58, 0x12, 0x56, 0xaa, 0x49, 0xd3, 0xd5,
+    0x4e, 0xed, 0x2c, 0xa2, 0x8b, 0x93, 0xd3, 0x54, 0x86, 0xd7, 0xe0, 0x1e, 0x8f, 0x61, 0xa5, 0xb3,
+    0x9c, 0xe3, 0x16, 0x9e, 0xc4, 0x62, 0x7f, 0x6b, 0x8e, 0x19, 0x62, 0xf2, 0x2a, 0xd2, 0x98, 0x4a,
+    0x84, 0x6a, 0xfd, 0x6a, 0x91, 0x5b, 0xa9, 0xa3, 0xcb, 0x26, 0xb9, 0x6a, 0xf7, 0xe3, 0x8f, 0x98,
+    0x1a, 0xb0, 0xc7, 0x96, 0xe6, 0xe4, 0x83, 0x65, 0x18, 0xd4, 0xc2, 0x9b, 0xbd, 0xae, 0xc7, 0x94,
+    0x58, 0x52, 0x52, 0xa6, 0xd8, 0xbc, 0x14, 0x1d, 0x7f, 0xee, 0x28, 0xbd, 0x2c, 0xdb, 0xa9, 0x2c,
+    0x15, 0xb5, 0x5b, 0xbc, 0x4b, 0xbe, 0xb4, 0x2a, 0xa4, 0x13, 0x96, 0xbe, 0x38, 0x69, 0xb1, 0x3d,
+    0x27, 0x67, 0xd3, 0xda, 0xf2, 0x15, 0x3a, 0x33, 0xa1, 0xef, 0x8d, 0x6e, 0xe3, 0xd1, 0xf2, 0x01,
+    0xd5, 0x0b, 0xa7, 0xc8, 0x81, 0xec, 0x38, 0x22, 0xbd, 0x57, 0xad, 0x72, 0xa7, 0x6d, 0xbf, 0x58,
+    0x6b, 0x32, 0x7b, 0x3b, 0x1b, 0x75, 0x68, 0xa4, 0x49, 0x99, 0x9d, 0xb2, 0xe1, 0xd0, 0x2b, 0xba,
+    0x6a, 0x1b, 0xb6, 0xbe, 0xde, 0x8a, 0x87, 0xbd, 0xbc, 0x70, 0x45, 0x88, 0xd8, 0x1b, 0x09, 0x37,
+    0xcb, 0x44, 0x02, 0x9c, 0x73, 0xd9, 0x75, 0x0a, 0xbe, 0xe0, 0xe5, 0xe8, 0x02, 0xa7, 0xf0, 0x20,
+    0xd0, 0xb6, 0xab, 0x57, 0xdc, 0x54, 0xaf, 0x91, 0x4a, 0xb4, 0x96, 0x4f, 0x35, 0x58, 0x35, 0x22,
+    0x9d, 0x37, 0x8b, 0x88, 0xbb, 0x0d, 0x9d, 0x7b, 0x2f, 0x77, 0xa5, 0x5c, 0xa1, 0xcb, 0x91, 0xf4,
+    0xdc, 0x5a, 0x4f, 0xd5, 0x53, 0xa4, 0x42, 0xdd, 0xde, 0x60, 0xdb, 0xd8, 0x53, 0x17, 0x71, 0x6b,
+    0x9e, 0xa6, 0xd4, 0x5d, 0x99, 0x28, 0x83, 0xdf, 0xfd, 0x95, 0x12, 0x02, 0xc6, 0xef, 0x66, 0x48,
+    0x5b, 0xfb, 0xb6, 0xfe, 0x6c, 0x85, 0x6e, 0x32, 0x75, 0xdc, 0xc8, 0xde, 0x09, 0xcf, 0xfa, 0x36,
+    0x7c, 0x62, 0xc3, 0xec, 0xbd, 0xa3, 0x6a, 0x4b, 0x53, 0x27, 0x14, 0x77, 0xf0, 0x17, 0x97, 0xd3,
+    0x3a, 0xe5, 0x15, 0x53, 0x70, 0xf3, 0x52, 0xcd, 0xc6, 0xd4, 0xe0, 0x77, 0x13, 0x9b, 0x85, 0x27,
+    0x06, 0xbc, 0xc9, 0xcb, 0x86, 0xe8, 0x13, 0x77, 0x3e, 0x3c, 0x81, 0xb5, 0x17, 0xde, 0x73, 0x96,
+    0xa5, 0xb3, 0xd3, 0xd4, 0xa2, 0x92, 0xe2, 0x33, 0x25, 0x07, 0x62, 0x01, 0x36, 0x6e, 0x56, 0xaa,
+    0x31, 0x31, 0x47, 0x05, 0x6e, 0xb1, 0x99, 0xe4, 0xf6, 0x4a, 0x1d, 0x14, 0x2f, 0xf9, 0xca, 0x6d,
+    0xd0, 0x5a, 0x81, 0xf2, 0xd1, 0x93, 0xd7, 0x17, 0x4d, 0x4f, 0x79, 0xd7, 0x6c, 0xd1, 0xfa, 0xf8,
+    0x86, 0x76, 0x8e, 0xb1, 0x72, 0x18, 0xc2, 0xaf, 0x71, 0x4a, 0x87, 0xa8, 0x9d, 0xf8, 0x7a, 0x5d,
+    0x50, 0xbb, 0x45, 0x44, 0xeb, 0x9d, 0x66, 0x31, 0x63, 0x04, 0x15, 0xf6, 0xb3, 0x73, 0x13, 0xd6,
+    0x68, 0x7c, 0x08, 0x6d, 0x4e, 0x78, 0x34, 0x3b, 0xd4, 0xf3, 0x98, 0x4c, 0xc7, 0x6b, 0x34, 0x44,
+    0x7b, 0xdc, 0xcb, 0xfd, 0x94, 0x02, 0x73, 0x72, 0x25, 0xf5, 0xd4, 0xf6, 0xac, 0x53, 0x8c, 0xb4,
+    0x8b, 0x8b, 0x4e, 0xd5, 0x2f, 0x2b, 0x9e, 0x84, 0x0d, 0x34, 0xb6, 0xef, 0x38, 0x56, 0x32, 0xa8,
+    0x38, 0x9f, 0xca, 0x35, 0x2d, 0xce, 0xf4, 0x76, 0x7e, 0xf0, 0xd2, 0x2f, 0x5b, 0x0c, 0x95, 0x17,
+    0x66, 0x94, 0x81, 0xef, 0xf3, 0xab, 0x87, 0x75, 0x2f, 0xd9, 0x7d, 0x6b, 0xad, 0x3a, 0xa9, 0x43,
+    0x50, 0x73, 0xa5, 0xdb, 0x1c, 0xcd, 0x86, 0x08, 0x04, 0x41, 0x4c, 0xa6, 0x2e, 0xdc, 0xc9, 0x7b,
+    0x97, 0x41, 0x11, 0x43, 0x26, 0x6c, 0x9d, 0x0e, 0x9b, 0xeb, 0xf8, 0xea, 0x96, 0xd1, 0xc5, 0x99,
+    0x38, 0xa7, 0x44, 0x78, 0x5b, 0x18, 0x38, 0xd0, 0x24, 0x23, 0x1e, 0xd2, 0xf0, 0x91, 0x57, 0xe4,
+    0x98, 0x59, 0xbe, 0xad, 0x5a, 0x00, 0x26, 0x92, 0x58, 0x83, 0x7c, 0xf9, 0xbc, 0xab, 0xa0, 0xdb,
+    0x56, 0xda, 0x27, 0x6d, 0x72, 0xc4, 0x98, 0x7e, 0xfd, 0xd0, 0xc9, 0x90, 0x4c, 0xd6, 0x38, 0x4b,
+    0x55, 0xcc, 0x9a, 0xf2, 0x66, 0xa7, 0x33, 0x47, 0x4e, 0x67, 0x3a, 0xc2, 0x88, 0x79, 0x1a, 0xdf,
+    0xd2, 0x9e, 0xe9, 0x4a, 0x6e, 0x36, 0xd3, 0x53, 0x78, 0xbd, 0xcd, 0xc1, 0x07, 0xdf, 0x90, 0x6d,
+    0x48, 0x43, 0xea, 0xed, 0x32, 0xc1, 0xc6, 0xda, 0x49, 0x50, 0x9e, 0x8b, 0x5d, 0x61, 0x3d, 0xb0,
+    0x49, 0x18, 0xac, 0xb0, 0xac, 0x0c, 0xf7, 0xbe, 0x67, 0xef, 0xea, 0x6c, 0xee, 0x55, 0xf3, 0x09,
+    0x53, 0x6a, 0x94, 0xd4, 0x1a, 0x7e, 0x1f, 0xa9, 0xb5, 0xdb, 0xa9, 0xce, 0x9a, 0x0b, 0x57, 0xa4,
+    0x74, 0xd1, 0x8c, 0x6f, 0xed, 0xc8, 0xbe, 0x9c, 0x62, 0x16, 0x3e, 0x56, 0x3a, 0x1d, 0xaa, 0x45,
+    0x5f, 0x3e, 0x72, 0x29, 0x70, 0x18, 0xce, 0xcb, 0xef, 0x3c, 0x91, 0x41, 0x13, 0x61, 0x38, 0x72,
+    0xab, 0x5e, 0xd9, 0x1d, 0x0b, 0x10, 0x2b, 0xdd, 0xfe, 0x3e, 0xf1, 0xf9, 0xe6, 0x32, 0x6a, 0x90,
+    0xe8, 0xd6, 0x7b, 0xa3, 0xbc, 0x71, 0x0f, 0x08, 0xcc, 0x86, 0x20, 0xf1, 0x8d, 0x01, 0x3e, 0x73,
+    0x27, 0xfb, 0x0b, 0xcd, 0x24, 0x17, 0x06, 0x71, 0x4b, 0xc9, 0xf6, 0x92, 0xdf, 0x5a, 0xcc, 0x8b,
+    0xa6, 0x79, 0x4f, 0x93, 0x78, 0x34, 0xac, 0x40, 0xf9, 0x52, 0x7f, 0x6f, 0x18, 0xa4, 0xa8, 0x7b,
+    0xeb, 0x41, 0x62, 0x37, 0x06, 0x21, 0x56, 0x5f, 0x39, 0x6b, 0xc3, 0xef, 0x31, 0xf6, 0xc1, 0xda,
+    0x45, 0x62, 0x0f, 0xce, 0xb9, 0x05, 0xf9, 0x32, 0x84, 0x1b, 0xef, 0xf2, 0x0c, 0x69, 0xa6, 0x02,
+    0xed, 0x6c, 0xc0, 0x64, 0x76, 0x94, 0xa5, 0x06, 0x22, 0x21, 0x1f, 0x22, 0x37, 0x5d, 0xef, 0x31,
+    0xaf, 0x71, 0x25, 0x9e, 0xa0, 0x44, 0xae, 0x62, 0x42, 0x1e, 0xe8, 0xfe, 0x5d, 0x91, 0xb1, 0x60,
+    0x8c, 0x0d, 0xeb, 0x3c, 0x2b, 0xdb, 0xc2, 0xd9, 0x22, 0xa8, 0x5b, 0x61, 0x21, 0xf7, 0x95, 0x0e,
+    0xf8, 0x81, 0x57, 0x4c, 0x6a, 0xc4, 0xa2, 0xd0, 0xbc, 0xed, 0xf4, 0x90, 0x09, 0x6e, 0xbe, 0xad,
+    0x64, 0xd8, 0x45, 0x8f, 0x3b, 0x1d, 0xf0, 0xec, 0x72, 0xe8, 0xb7, 0x99, 0x68, 0x99, 0x5b, 0x16,
+    0x74, 0xc5, 0xf7, 0xc6, 0xd9, 0xc4, 0xc2, 0x2c, 0xeb, 0x4a, 0x54, 0x74, 0xcc, 0x6d, 0x69, 0x6b,
+    0x08, 0x5a, 0xbc, 0xed, 0xa5, 0x03, 0x86, 0x32, 0x64, 0xdd, 0xca, 0x0d, 0xe8, 0x92, 0xbb, 0x40,
+    0x0e, 0xca, 0x7b, 0xf1, 0x25, 0x82, 0x8e, 0xf8, 0xe0, 0x4c, 0xa4, 0xa1, 0xe1, 0x4e, 0x6a, 0x96,
+    0x54, 0x4a, 0x01, 0x64, 0x35, 0x25, 0x20, 0xbf, 0x82, 0xc3, 0x2c, 0x33, 0x2a, 0x1f, 0xd3, 0x15,
+    0x06, 0x26, 0x7d, 0xfc, 0xc8, 0xe8, 0xba, 0x85, 0x5f, 0x9c, 0x94, 0xfb, 0x2a, 0xdd, 0x4e, 0xed,
+    0x2d, 0xad, 0x22, 0xb4, 0x08, 0x41, 0xd5, 0x00, 0x9b, 0xe4, 0xf9, 0x8e, 0x36, 0x2a, 0x07, 0xeb,
+    0x4e, 0xc7, 0x6e, 0x28, 0x88, 0xfc, 0x6e, 0x39, 0x60, 0xc0, 0x01, 0xb8, 0x17, 0xf6, 0x85, 0xef,
+    0x74, 0xdb, 0x4c, 0x85, 0x2b, 0xb2, 0xab, 0x8d, 0xdf, 0x41, 0x16, 0xb1, 0xb2, 0x8a, 0xb6, 0xda,
+    0xc0, 0xb3, 0x52, 0x2e, 0xe2, 0x19, 0x68, 0x51, 0x69, 0xd8, 0x81, 0x06, 0x3c, 0xae, 0x34, 0xca,
+    0x29, 0x07, 0xed, 0x82, 0x3e, 0xf3, 0x13, 0x0d, 0xc1, 0x3a, 0x03, 0xd2, 0x70, 0xd8, 0x53, 0x51,
+    0x5e, 0x1d, 0x35, 0x1b, 0x88, 0x8c, 0x89, 0x2d, 0x24, 0x13, 0xa7, 0xde, 0x6e, 0x56, 0x80, 0x75,
+    0xe0, 0xd0, 0x13, 0xe7, 0x76, 0x19, 0x0a, 0x02, 0xc2, 0x1b, 0xb5, 0x21, 0x90, 0x01, 0x71, 0xaa,
+    0x88, 0xda, 0x3a, 0x83, 0x97, 0x2a, 0xc6, 0x21, 0x8f, 0x2d, 0x3d, 0xf9, 0x47, 0x43, 0x0a, 0x30,
+    0xbd, 0xab, 0x7a, 0x37, 0x00, 0x7e, 0xe7, 0xe0, 0x0e, 0x55, 0x01, 0xac, 0xca, 0x9e, 0x55, 0xa2,
+    0x0f, 0x34, 0x9f, 0xf2, 0xe3, 0xb0, 0xc2, 0xcb, 0xd8, 0xac, 0xe1, 0x88, 0x7b, 0x68, 0xe4, 0x81,
+    0xcf, 0xac, 0x38, 0xcf, 0x20, 0xf9, 0x51, 0x0f, 0x74, 0xde, 0x37, 0xcd, 0xa3, 0x7b, 0x0a, 0x61,
+    0xdc, 0xd2, 0x9c, 0x48, 0x55, 0x4d, 0xb9, 0xee, 0x04, 0x17, 0x66, 0x27, 0x3c, 0x4c, 0x30, 0xba,
+    0xc4, 0xc1, 0xd8, 0x30, 0x76, 0x87, 0x3d, 0x44, 0xe8, 0x02, 0x29, 0x9d, 0x9d, 0x73, 0x82, 0xb1,
+    0x29, 0x70, 0xf2, 0x6b, 0xc4, 0x5a, 0x6a, 0xaf, 0x68, 0xd6, 0x80, 0x94, 0xf4, 0xbc, 0x7a, 0x77,
+    0x16, 0x8c, 0x00, 0x05, 0x8f, 0xdd, 0x2a, 0x0f, 0x27, 0x6c, 0x07, 0xdd, 0x43, 0xd2, 0x47, 0xdb,
+    0x6d, 0xe4, 0xca, 0x28, 0x1d, 0x29, 0xac, 0x17, 0x80, 0x60, 0xed, 0x2e, 0x79, 0x3f, 0xcd, 0xbc,
+    0xe6, 0x79, 0xd9, 0x8a, 0xed, 0xc0, 0x8b, 0x6b, 0x60, 0x56, 0x77, 0x0b, 0x63, 0xc4, 0x8e, 0x1a,
+    0x80, 0xdc, 0xa4, 0x65, 0x9d, 0x38, 0x9b, 0x6b, 0xb3, 0x2b, 0xde, 0x99, 0x5a, 0x10, 0x4e, 0xeb,
+    0x36, 0x86, 0x85, 0x78, 0xb0, 0x68, 0xf1, 0x62, 0x6c, 0x18, 0x46, 0x63, 0x65, 0xf1, 0x69, 0xd6,
+    0x30, 0xbd, 0x0d, 0xda, 0xc3, 0xb7, 0xe6, 0x80, 0xed, 0xbd, 0xaa, 0x8c, 0xa4, 0x66, 0x77, 0x06,
+    0x19, 0xfc, 0xb5, 0x01, 0xff, 0x0e, 0xd3, 0x57, 0xe4, 0x53, 0x02, 0x47, 0xda, 0xe8, 0x1f, 0xce,
+    0x44, 0x02, 0x85, 0x54, 0x50, 0x6f, 0x1d, 0x75, 0x0a, 0x97, 0x60, 0x13, 0x6a, 0x7a, 0x22, 0x36,
+    0x3f, 0x5f, 0x77, 0x40, 0xfc, 0x6a, 0x32, 0x40, 0x30, 0x06, 0x26, 0xe9, 0x4a, 0x21, 0x29, 0xb6,
+    0xc7, 0xba, 0x18, 0x04, 0x5b, 0xc6, 0x46, 0x6d, 0xe7, 0x4e, 0x06, 0x28, 0x32, 0x5d, 0x5b, 0x0b,
+    0xac, 0xf9, 0x03, 0xf6, 0x0d, 0x44, 0x7a, 0xf3, 0x8d, 0x66, 0x8f, 0x3b, 0xce, 0xf6, 0xe6, 0x5c,
+    0xa6, 0x8e, 0x2f, 0xf0, 0xe5, 0x26, 0x7f, 0x67, 0xdb, 0x3c, 0x81, 0x80, 0x30, 0x54, 0x7a, 0x1c,
+    0x11, 0x47, 0x5f, 0x7b, 0x7b, 0x66, 0xa9, 0xea, 0xf2, 0xaa, 0x50, 0x2d, 0x66, 0xb0, 0x0e, 0xe2,
+    0xd2, 0x92, 0x69, 0xe8, 0x39, 0xb6, 0xbe, 0xfe, 0xaa, 0x18, 0xb8, 0x0e, 0x85, 0x99, 0x42, 0x41,
+    0x06, 0xb9, 0xc4, 0xea, 0x53, 0xa9, 0x4f, 0x58, 0x85, 0x29, 0x1d, 0x33, 0x8b, 0x6d, 0x1f, 0xc4,
+    0x6c, 0x3e, 0x41, 0x16, 0xa4, 0xcc, 0x08, 0xa2, 0x4c, 0x0a, 0xd1, 0x4d, 0x0d, 0xd0, 0x6d, 0xf1,
+    0x7e, 0x85, 0x97, 0xbb, 0x1d, 0x09, 0xe4, 0xcf, 0xe7, 0x68, 0x1a, 0xa2, 0xbe, 0xb7, 0x4c, 0xec,
+    0xf7, 0xf0, 0x91, 0x33, 0x8d, 0x1e, 0x2f, 0xa0, 0x07, 0x0f, 0x8e, 0x45, 0xd5, 0x43, 0xee, 0x75,
+    0x6b, 0xa8, 0x98, 0x11, 0x0d, 0xd4, 0x4b, 0x31, 0x67, 0x92, 0xd9, 0x31, 0x2a, 0xb7, 0xf3, 0x33,
+    0x8b, 0xd8, 0x9e, 0x8a, 0x75, 0x2d, 0x7d, 0x26, 0xf4, 0x3d, 0xa5, 0x78, 0x94, 0xcd, 0xe3, 0x64,
+    0x6a, 0x82, 0x6b, 0x34, 0x52, 0x9b, 0xf4, 0x99, 0x8d, 0x08, 0xbc, 0xcd, 0x11, 0x03, 0x60, 0xcd,
+    0x8d, 0x1c, 0x58, 0x1c, 0x77, 0xe5, 0x99, 0xa3, 0x45, 0x41, 0xd7, 0xa5, 0x3c, 0x62, 0x06, 0xd4,
+    0x21, 0x1a, 0xc5, 0x92, 0xa6, 0x0a, 0x9c, 0x89, 0x6a, 0xec, 0x21, 0x8a, 0xa7, 0x4c, 0xc9, 0x0f,
+    0xf4, 0xda, 0x60, 0xe4, 0x61, 0x96, 0x0b, 0xeb, 0x91, 0xa9, 0x05, 0xd8, 0xf3, 0x31, 0x59, 0x22,
+    0x26, 0x01, 0xe3, 0x21, 0x59, 0x79, 0x91, 0x82, 0x75, 0x1b, 0x58, 0x4f, 0x1d, 0x2f, 0xc0, 0x83,
+    0xcd, 0x72, 0x55, 0x00, 0xef, 0xa8, 0x0d, 0xfc, 0x6d, 0x53, 0x31, 0x30, 0xb2, 0xdc, 0x0a, 0xac,
+    0x3b, 0xe7, 0x9c, 0xc4, 0x7c, 0x11, 0xe7, 0x8a, 0x4e, 0xf2, 0x13, 0xc3, 0xdb, 0xc2, 0x7c, 0x4d,
+    0x11, 0x93, 0x62, 0x3c, 0x11, 0x49, 0x85, 0x19, 0xa7, 0x6b, 0xa0, 0x42, 0x7e, 0x1a, 0x01, 0x84,
+    0x83, 0xb7, 0x1f, 0xa5, 0xcd, 0x96, 0xe1, 0x33, 0x64, 0x81, 0xd1, 0x22, 0x49, 0x47, 0xe1, 0xd8,
+    0x25, 0x01, 0x55, 0x12, 0x9c, 0x34, 0x18, 0x03, 0x8d, 0x20, 0x79, 0xe7, 0xf3, 0x3c, 0x97, 0xd3,
+    0xe0, 0x75, 0xea, 0xc8, 0xba, 0xa6, 0xed, 0x6f, 0x82, 0x03, 0x83, 0x57, 0x57, 0x61, 0x4a, 0x8b,
+    0xc5, 0x33, 0x70, 0x5e, 0x00, 0x40, 0x49, 0x2e, 0x91, 0x42, 0x6c, 0xa2, 0x7e, 0x8a, 0xbc, 0xc3,
+    0xd6, 0x7d, 0x18, 0x43, 0x25, 0xd0, 0xce, 0xf4, 0x68, 0x6a, 0x82, 0x45, 0x8a, 0xfd, 0x76, 0x87,
+    0x38, 0x30, 0xa4, 0x56, 0xa5, 0xc7, 0xe8, 0xc7, 0xf0, 0x56, 0x1a, 0xda, 0xda, 0x13, 0x9a, 0x27,
+    0xc2, 0x32, 0x79, 0xd4, 0x3c, 0x3d, 0x76, 0x95, 0xdd, 0x7e, 0xe8, 0x61, 0xde, 0x93, 0x0f, 0xd1,
+    0xd7, 0xc1, 0x2e, 0xa1, 0xbb, 0x9e, 0xb5, 0xc6, 0x86, 0x73, 0xbf, 0x40, 0xa4, 0x02, 0x73, 0xe4,
+    0xef, 0x61, 0xba, 0x7b, 0x39, 0x88, 0x0d, 0xb4, 0x05, 0xed, 0xe0, 0x95, 0x5f, 0x68, 0xa1, 0xe1,
+    0x16, 0x4e, 0x5d, 0x33, 0xef, 0x81, 0x90, 0x98, 0x1d, 0xa3, 0x5d, 0x5a, 0x1c, 0x15, 0x6a, 0x6a,
+    0xcb, 0x26, 0xb0, 0xdd, 0x57, 0xe9, 0x03, 0xd1, 0x5b, 0xdf, 0xe5, 0x28, 0xba, 0x5b, 0x87, 0xf4,
+    0xd4, 0xa1, 0xe7, 0x47, 0x01, 0x0c, 0x51, 0xee, 0x5d, 0xbe, 0x0b, 0x94, 0xf2, 0x02, 0x30, 0x89,
+    0x43, 0x92, 0x73, 0xcf, 0x0e, 0xcf, 0x83, 0xfb, 0x59, 0x44, 0x33, 0x71, 0xb2, 0x9c, 0xcc, 0x5b,
+    0x88, 0x8b, 0x9e, 0xc3, 0x3a, 0x8c, 0x79, 0xcd, 0x82, 0xb6, 0xe4, 0x6f, 0x2d, 0x6a, 0x78, 0x51,
+    0x69, 0xe7, 0x8c, 0x09, 0xb0, 0x74, 0x78, 0x8a, 0x9c, 0x1f, 0x1b, 0xca, 0x76, 0x60, 0x62, 0xd8,
+    0x86, 0xad, 0xeb, 0xf4, 0xe9, 0xcc, 0xcc, 0x28, 0x17, 0x57, 0x88, 0x71, 0xcc, 0x38, 0x25, 0xda,
+    0x30, 0xd6, 0xfb, 0x58, 0x82, 0x00, 0x58, 0x26, 0xb4, 0x64, 0xa0, 0xa7, 0x1a, 0x40, 0xdf, 0xaa,
+    0x94, 0x13, 0xbf, 0x00, 0x6e, 0x4f, 0x04, 0xd4, 0x40, 0x3f, 0xe3, 0x94, 0xb4, 0xe0, 0xd1, 0x81,
+    0x21, 0x3d, 0xda, 0x5d, 0xab, 0x74, 0xbd, 0x6d, 0x89, 0xb6, 0x68, 0x5b, 0x20, 0x28, 0xc5, 0xdc,
+    0xcc, 0xcb, 0x2f, 0x71, 0xcd, 0x16, 0x98, 0x85, 0x41, 0xa4, 0x8b, 0xf3, 0x33, 0x29, 0xf3, 0x88,
+    0xe9, 0x10, 0x99, 0xaa, 0x68, 0xa8, 0x81, 0x16, 0xc0, 0x9c, 0x50, 0xd1, 0x1d, 0xa9, 0xdc, 0x83,
+    0xf1, 0x09, 0x75, 0x5a, 0xc5, 0x5c, 0x3a, 0xca, 0xaf, 0x8d, 0xb1, 0x73, 0xf6, 0x68, 0x32, 0x22,
+    0x7f, 0x4f, 0x61, 0x62, 0xb1, 0xd3, 0x7a, 0x27, 0x11, 0xee, 0x6d, 0x9f, 0xe7, 0xbc, 0x5c, 0x13,
+    0x7e, 0xe5, 0x58, 0x02, 0xf3, 0x18, 0x73, 0xbd, 0xc0, 0x9c, 0x94, 0x1f, 0xd6, 0x92, 0x3e, 0xa2,
+    0xdb, 0xae, 0x63, 0x72, 0x0b, 0x48, 0x72, 0x06, 0x00, 0x02, 0x69, 0xc6, 0x9d, 0xd1, 0x0d, 0x46,
+    0xcd, 0x8a, 0xdc, 0xf5, 0x0e, 0xe4, 0x85, 0x7c, 0xac, 0x41, 0x21, 0x7a, 0x70, 0xcc, 0xc0, 0xe7,
+    0x63, 0xe6, 0xb3, 0xd8, 0x88, 0x75, 0x21, 0x2f, 0xac, 0x05, 0xc4, 0x87, 0x25, 0xe6, 0x90, 0x43,
+    0x44, 0x03, 0xb4, 0xd8, 0x30, 0x65, 0x7b, 0x3c, 0xd0, 0x31, 0xb2, 0x81, 0xa7, 0x2c, 0x26, 0xc5,
+    0xdd, 0x2d, 0x46, 0x45, 0x57, 0x82, 0x8a, 0x61, 0x4b, 0xa5, 0x86, 0x6d, 0xac, 0x57, 0x32, 0xf6,
+    0x8e, 0xe9, 0x34, 0x38, 0x5d, 0x34, 0x18, 0x9a, 0xe7, 0x53, 0xd5, 0xd3, 0x1b, 0x8c, 0x1f, 0xa8,
+    0x74, 0x6a, 0xcc, 0x63, 0x93, 0xd9, 0x18, 0xbb, 0x15, 0x53, 0x88, 0x81, 0x3a, 0xd4, 0x42, 0x6f,
+    0xbe, 0x67, 0xaf, 0x5e, 0xb7, 0x94, 0xe5, 0x31, 0x63, 0xbb, 0xb2, 0x98, 0x01, 0xb1, 0x89, 0xe9,
+    0x30, 0x6a, 0x8a, 0x08, 0x5d, 0x6a, 0x00, 0x36, 0x12, 0xbf, 0xbc, 0xf4, 0xd9, 0x00, 0x1f, 0xf6,
+    0x1c, 0x94, 0x35, 0x88, 0x55, 0xd9, 0x7e, 0xf5, 0x9d, 0x41, 0x75, 0x3d, 0xa8, 0xea, 0x79, 0x63,
+    0x2b, 0x06, 0x69, 0x0c, 0x90, 0x98, 0x16, 0x8f, 0xc2, 0xe8, 0xa5, 0x6b, 0x7f, 0x0a, 0xed, 0xca,
+    0x6d, 0x92, 0x07, 0xf6, 0x8a, 0x49, 0x94, 0xdf, 0x46, 0x50, 0x76, 0xc4, 0xe4, 0xc5, 0x30, 0x7c,
+    0x36, 0x2b, 0x17, 0x48, 0xa3, 0x5e, 0x92, 0x1d, 0xe9, 0x08, 0x7c, 0xb4, 0xc1, 0xcb, 0x9a, 0x08,
+    0x94, 0x70, 0x7a, 0x06, 0x7a, 0x0a, 0xe5, 0x67, 0x2c, 0x15, 0xde, 0xaa, 0x84, 0x2a, 0x03, 0x78,
+    0xd2, 0x52, 0x32, 0x46, 0xf3, 0x62, 0x2a, 0xb7, 0xc1, 0x35, 0x78, 0xa6, 0x2d, 0xfe, 0x31, 0x24,
+    0xad, 0xdc, 0x4f, 0x4d, 0x3e, 0x31, 0x7e, 0xfe, 0xee, 0xe1, 0x7e, 0xf7, 0x70, 0xbf, 0x7b, 0xb8,
+    0xdf, 0x3d, 0xdc, 0xef, 0x1e, 0xee, 0x77, 0x0f, 0xf7, 0xbb, 0x87, 0xfb, 0xdd, 0xc3, 0xfd, 0xee,
+    0xe1, 0x7e, 0xf7, 0x70, 0xbf, 0x7b, 0xb8, 0xdf, 0x3d, 0xdc, 0xef, 0x1e, 0xee, 0x77, 0x0f, 0xf7,
+    0xbb, 0x87, 0xfb, 0xdd, 0xc3, 0xfd, 0xee, 0xe1, 0x7e, 0xf7, 0x70, 0xbf, 0x7b, 0xb8, 0xff, 0xbe,
+    0x87, 0xfb, 0x03, 0xf1, 0xb8, 0x35, 0xb2, 0x10, 0x27, 0x00, 0x00,
+};
+
+#endif
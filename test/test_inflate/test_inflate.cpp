@@ -0,0 +1,192 @@
+/*--------------------------- INFLATE STREAM TESTS (NATIVE BUILD) -----------------------------*/
+/*
+ * InflateStream (src/InflateStream.hpp) against bodies compressed by zlib (refer to fixtures.h),
+ * zlib and gzip, with stored, fixed and dynamic Huffman blocks, fed whole and then a byte at a
+ * time as a slow socket would. A body compressed with a bigger window than ours has to fail,
+ * and say so with available() -1 rather than leave the parser waiting on the response timeout.
+ *
+ *    pio test -e native
+ */
+#include <Arduino.h>
+#include <BenchHeap.h>
+#include <unity.h>
+
+SerialShim Serial;
+
+#include "InflateStream.hpp"
+#include "fixtures.h"
+
+#define TEST_WHOLE      4096    // Bytes available() gives at a time
+#define TEST_TRICKLE    1
+
+// The text all the wbits 12 fixtures are made from
+std::string fixtureText(size_t length = std::string::npos)
+{
+    std::string text;
+    char        item[128];
+
+    for (int i = 0; i < 100; i++) {
+        snprintf(item, sizeof(item), "{\"datetime\":%ld,\"title\":\"Headline %d: Homes flooded after north London water mains burst\"},", 1671321600L - i * 60L, i);
+        text += item;
+    }
+    return text.substr(0, length);
+}
+
+/*---- SOURCE ----*/
+// A response body that has only so much of itself available() at a time
+class FixtureStream : public Stream {
+
+    private:
+        const uint8_t   *data;
+        size_t          size;
+        size_t          chunk;
+        size_t          position    = 0;
+        size_t          allowed     = 0;
+
+    public:
+        FixtureStream(const uint8_t *_data, size_t _size, size_t _chunk) : data(_data), size(_size), chunk(_chunk) { }
+
+        bool drained()  { return position == size; }
+
+        int available()
+        {
+            allowed = min(chunk, size - position);
+            return allowed;
+        }
+
+        int read()
+        {
+            if (!allowed) return -1;
+            allowed--;
+            return data[position++];
+        }
+
+        int peek()
+        {
+            return allowed ? data[position] : -1;
+        }
+
+}; // end FixtureStream
+
+/*---- HELPERS ----*/
+struct InflateResult
+{
+    std::string     text;
+    bool            failed;
+    bool            drained;
+    unsigned long   wire_bytes;
+};
+
+// Reads all it can, as pumpJsonStream() does: until available() says it has failed, or
+// has nothing more with the whole body in
+InflateResult inflateAll(const uint8_t *data, size_t size, bool gzip, size_t chunk)
+{
+    FixtureStream   source(data, size, chunk);
+    InflateStream   inflater;
+    InflateResult   result;
+
+    inflater.begin(source, gzip);
+
+    // Giving up after a few passes with nothing, so a stall fails the test rather than hangs it
+    for (int idle = 0; idle < 16; ) {
+        int available = inflater.available();
+        if (available < 0) break;
+
+        if (available == 0) {
+            if (source.drained()) break;
+            idle++;
+            continue;
+        }
+
+        idle = 0;
+        while (available-- > 0) result.text += (char) inflater.read();
+    }
+
+    result.failed       = inflater.failed();
+    result.drained      = source.drained();
+    result.wire_bytes   = inflater.wire_bytes;
+
+    if (result.failed) {
+        TEST_ASSERT_EQUAL(-1, inflater.available());
+        TEST_ASSERT_EQUAL(-1, inflater.read());
+    }
+    inflater.end();
+    return result;
+}
+
+void assertInflates(const uint8_t *data, size_t size, bool gzip, const std::string &expected)
+{
+    for (size_t chunk : { TEST_WHOLE, TEST_TRICKLE }) {
+        InflateResult result = inflateAll(data, size, gzip, chunk);
+
+        TEST_ASSERT_FALSE(result.failed);
+        TEST_ASSERT_TRUE(result.drained);
+        TEST_ASSERT_EQUAL(size, result.wire_bytes);
+        TEST_ASSERT_EQUAL(expected.size(), result.text.size());
+        TEST_ASSERT_TRUE(result.text == expected);
+    }
+}
+
+/*---- TESTS ----*/
+void test_zlib12_dynamic()
+{
+    assertInflates(ZLIB12_DYNAMIC, sizeof(ZLIB12_DYNAMIC), false, fixtureText());
+}
+
+void test_gzip12_dynamic()
+{
+    assertInflates(GZIP12_DYNAMIC, sizeof(GZIP12_DYNAMIC), true, fixtureText());
+}
+
+void test_zlib12_fixed()
+{
+    assertInflates(ZLIB12_FIXED, sizeof(ZLIB12_FIXED), false, fixtureText(1500));
+}
+
+void test_zlib12_stored()
+{
+    assertInflates(ZLIB12_STORED, sizeof(ZLIB12_STORED), false, fixtureText(600));
+}
+
+// A gzip body compressed with a 32KB window is fine as long as it never refers back that far
+void test_gzip15_near()
+{
+    assertInflates(GZIP15_NEAR, sizeof(GZIP15_NEAR), true, fixtureText(3000));
+}
+
+// The zlib header says the window is too big, so it fails before any output
+void test_zlib15_header()
+{
+    for (size_t chunk : { TEST_WHOLE, TEST_TRICKLE }) {
+        InflateResult result = inflateAll(ZLIB15_HEADER, sizeof(ZLIB15_HEADER), false, chunk);
+
+        TEST_ASSERT_TRUE(result.failed);
+        TEST_ASSERT_EQUAL(0, result.text.size());
+        if (chunk == TEST_TRICKLE) TEST_ASSERT_EQUAL(2, result.wire_bytes);
+    }
+}
+
+// Gzip doesn't say, so it fails at the first reference past the window, without reading on
+void test_gzip15_far()
+{
+    for (size_t chunk : { TEST_WHOLE, TEST_TRICKLE }) {
+        InflateResult result = inflateAll(GZIP15_FAR, sizeof(GZIP15_FAR), true, chunk);
+
+        TEST_ASSERT_TRUE(result.failed);
+        TEST_ASSERT_TRUE(result.text.size() >= 5000 && result.text.size() < 10000);
+        if (chunk == TEST_TRICKLE) TEST_ASSERT_FALSE(result.drained);   // Whole, the rest is already in the input buffer
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_zlib12_dynamic);
+    RUN_TEST(test_gzip12_dynamic);
+    RUN_TEST(test_zlib12_fixed);
+    RUN_TEST(test_zlib12_stored);
+    RUN_TEST(test_gzip15_near);
+    RUN_TEST(test_zlib15_header);
+    RUN_TEST(test_gzip15_far);
+    return UNITY_END();
+}
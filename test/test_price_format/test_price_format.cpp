@@ -0,0 +1,127 @@
+/*--------------------------- PRICE FORMAT TESTS (NATIVE BUILD) -----------------------------*/
+/*
+ * formatPrice() (src/PriceFormat.hpp) against what it replaced: PRICE_FORMAT_FIXED2 has to
+ * print what snprintf("%0.2lf") did, bar ties (which printf rounds as the binary double) and
+ * "-0.00". Then rounding that carries into another digit, negatives, and compact k/M/B.
+ *
+ *    pio test -e native
+ */
+#include <Arduino.h>
+#include <BenchHeap.h>
+#include <unity.h>
+
+#include "PriceFormat.hpp"
+
+#define TEST_VALUE_DECIMALS     8               // As the ticker prices (TICKER_PRICE_DECIMALS)
+#define TEST_RANDOM_VALUES      200000
+#define TEST_RANDOM_MAX         100000000000000LL  // 1,000,000.00000000, so a double still has digits to spare
+
+std::string format(int64_t value, const PriceFormat &format)
+{
+    char buffer[32];
+    formatPrice(buffer, sizeof(buffer), value, TEST_VALUE_DECIMALS, format);
+    return buffer;
+}
+
+void assertFormat(const char *expected, int64_t value, const PriceFormat &price_format)
+{
+    TEST_ASSERT_EQUAL_STRING(expected, format(value, price_format).c_str());
+}
+
+/*---- TESTS ----*/
+void test_fixed2_matches_printf()
+{
+    uint64_t x = 12345;
+
+    for (int i = 0; i < TEST_RANDOM_VALUES; i++)
+    {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        // Spread over magnitudes, so small coins get as many samples as BTC
+        int64_t value = (int64_t) ((x >> 11) % (TEST_RANDOM_MAX >> ((x >> 3) % 40)));
+        if (x & 1) value = -value;
+
+        int64_t remainder = (value < 0 ? -value : value) % 1000000;
+        if (remainder == 500000) continue;                      // A tie
+        if (value < 0 && -value < 500000) continue;             // printf says "-0.00"
+
+        char expected[32];
+        snprintf(expected, sizeof(expected), "%0.2lf", value / 100000000.0);
+
+        std::string actual = format(value, PRICE_FORMAT_FIXED2);
+        if (actual != expected) {
+            printf("%lld: printf \"%s\", formatPrice \"%s\"\n", (long long) value, expected, actual.c_str());
+            TEST_ASSERT_EQUAL_STRING(expected, actual.c_str());
+            return;
+        }
+    }
+}
+
+void test_fixed2_rounding()
+{
+    assertFormat("1000.00",     99999600000LL,      PRICE_FORMAT_FIXED2);   // 999.996
+    assertFormat("9999.96",     999996000000LL,     PRICE_FORMAT_FIXED2);
+    assertFormat("0.01",        500000LL,           PRICE_FORMAT_FIXED2);   // Half away from zero
+    assertFormat("-0.01",       -500000LL,          PRICE_FORMAT_FIXED2);
+    assertFormat("0.00",        -100000LL,          PRICE_FORMAT_FIXED2);   // Not "-0.00"
+}
+
+// Rounding up to another whole digit leaves one decimal fewer, or none
+void test_ticker_carry()
+{
+    assertFormat("1,000",       99999600000LL,      PRICE_FORMAT_TICKER);   // 999.996
+    assertFormat("10,000",      999996000000LL,     PRICE_FORMAT_TICKER);   // 9999.96
+    assertFormat("1.00",        99999999LL,         PRICE_FORMAT_TICKER);   // 0.99999999
+    assertFormat("16,725",      1672474000000LL,    PRICE_FORMAT_TICKER);
+    assertFormat("1,234.5",     123450000000LL,     PRICE_FORMAT_TICKER);
+    assertFormat("1.50",        150000000LL,        PRICE_FORMAT_TICKER);   // Trimmed down to min_decimals
+    assertFormat("0.00001234",  1234LL,             PRICE_FORMAT_TICKER);
+}
+
+void test_negative()
+{
+    assertFormat("-1234.50",    -123450000000LL,    PRICE_FORMAT_FIXED2);
+    assertFormat("-1,234.5",    -123450000000LL,    PRICE_FORMAT_TICKER);
+    assertFormat("-0.00001234", -1234LL,            PRICE_FORMAT_TICKER);
+    assertFormat("-1,000",      -99999600000LL,     PRICE_FORMAT_TICKER);
+    assertFormat("-12.3k",      -1234500000000LL,   PRICE_FORMAT_COMPACT);
+}
+
+void test_compact()
+{
+    assertFormat("999",         99900000000LL,      PRICE_FORMAT_COMPACT);
+    assertFormat("12.3k",       1234500000000LL,    PRICE_FORMAT_COMPACT);
+    assertFormat("4.51M",       451234567000000LL,  PRICE_FORMAT_COMPACT);
+    assertFormat("1.2B",        120000000000000000LL, PRICE_FORMAT_COMPACT);
+    assertFormat("50B",         5000000000000000000LL, PRICE_FORMAT_COMPACT);   // No bigger suffix
+}
+
+// Rounding up into the next suffix
+void test_compact_carry()
+{
+    assertFormat("1k",          99950000000LL,      PRICE_FORMAT_COMPACT);  // 999.5
+    assertFormat("1M",          99996000000000LL,   PRICE_FORMAT_COMPACT);  // 999.96k
+    assertFormat("1B",          99999900000000000LL, PRICE_FORMAT_COMPACT); // 999.999M
+}
+
+// Cut short as snprintf() would, but still the whole length returned
+void test_truncation()
+{
+    char buffer[5];
+
+    TEST_ASSERT_EQUAL(7, formatPrice(buffer, sizeof(buffer), 123450000000LL, TEST_VALUE_DECIMALS, PRICE_FORMAT_TICKER));
+    TEST_ASSERT_EQUAL_STRING("1,23", buffer);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fixed2_matches_printf);
+    RUN_TEST(test_fixed2_rounding);
+    RUN_TEST(test_ticker_carry);
+    RUN_TEST(test_negative);
+    RUN_TEST(test_compact);
+    RUN_TEST(test_compact_carry);
+    RUN_TEST(test_truncation);
+    return UNITY_END();
+}